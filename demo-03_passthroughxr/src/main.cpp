@@ -138,19 +138,14 @@ int main( int argc, char *argv[] )
 	// (13) Render loop
 	while ( pApp->GetSession()->GetState() != XR_SESSION_STATE_EXITING )
 	{
-		// (13.1) Poll for xr events
-		XrEventDataBaseHeader xrEventDataBaseheader { XR_TYPE_EVENT_DATA_EVENTS_LOST };
-		if ( !XR_SUCCEEDED( pApp->GetSession()->Poll( &xrEventDataBaseheader ) ) )
+		// (13.1) Poll and process all pending xr events
+		if ( !pApp->PollXrEvents() )
 			continue;
 
-		// (13.2) Process xr events
-		pApp->ProcessEvents_SessionState( xrEventDataBaseheader );
-		pApp->ProcessEvents_Vismasks( xrEventDataBaseheader );
-
-		// (13.3) Render frame
+		// (13.2) Render frame
 		if ( pApp->GetSession()->GetState() >= XR_SESSION_STATE_READY )
 		{
-			// (13.3.1) Add passthrough layers
+			// (13.2.1) Add passthrough layers
 			if ( pPassthrough->IsActive() )
 			{
 				pApp->pRenderInfo->state.compositionLayerFlags = XR_COMPOSITION_LAYER_BLEND_TEXTURE_SOURCE_ALPHA_BIT | XR_COMPOSITION_LAYER_CORRECT_CHROMATIC_ABERRATION_BIT | XR_COMPOSITION_LAYER_UNPREMULTIPLIED_ALPHA_BIT;
@@ -166,7 +161,7 @@ int main( int argc, char *argv[] )
 			}
 			
 
-			// (13.3.2) Render frame
+			// (13.2.2) Render frame
 			pApp->GetRender()->RenderFrame( pApp->mainRenderPass, pApp->pRenderInfo.get(), pApp->vecMasks );
 		}
 	}
@@ -133,12 +133,6 @@ namespace app
 		//vecPrimitives.back()->InitBuffers();
 	}
 
-	void App::ProcessXrEvents( XrEventDataBaseHeader &xrEventDataBaseheader ) 
-	{
-		ProcessEvents_SessionState( xrEventDataBaseheader );
-		ProcessEvents_Vismasks( xrEventDataBaseheader );
-	}
-
 	bool App::StartRenderFrame() 
 	{
 		if ( GetSession()->GetState() >= XR_SESSION_STATE_READY )
@@ -158,18 +152,13 @@ namespace app
 				pRenderInfo->state.clearValues[ 0 ].color = { { 0.0f, 0.0f, 0.0f, 1.0f } };
 			}
 
-			// Submit actual render work to render thread
-			return GetRender()->StartRenderFrame( pRenderInfo.get() );
+			// Submit actual render work to render thread, xrapp late latches registered poses
+			return XrApp::StartRenderFrame();
 		}
 
 		return false;
 	}
 
-	void App::EndRenderFrame() 
-	{ 
-		GetRender()->EndRenderFrame( mainRenderPass, pRenderInfo.get(), vecMasks ); 
-	}
-
 	void App::CreateGraphicsPipelines() 
 	{ 
 		// Vismask
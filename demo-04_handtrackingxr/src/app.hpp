@@ -15,6 +15,7 @@
 #include <memory>
 
 #include <xrapp.hpp>
+#include <frame_scheduler.hpp>
 
 using namespace xrlib;
 using namespace xrapp;
@@ -45,13 +46,10 @@ namespace app
 			int Init();
 		#endif
 
-			~App();
+			~App() override;
 
 			void SetupScene();
-			void ProcessXrEvents( XrEventDataBaseHeader &xrEventDataBaseheader );
-
-			bool StartRenderFrame();
-			void EndRenderFrame();
+			bool StartRenderFrame() override;
 
 			struct SPipelines
 			{
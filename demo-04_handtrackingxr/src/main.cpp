@@ -79,74 +79,40 @@ int main( int argc, char *argv[] )
 		pApp->pRenderInfo->AddNewRenderable( dynamic_cast< CRenderable * >( debugIndicator ) );
 	}
 
-	// (5) Render loop
-	while ( pApp->GetSession()->GetState() != XR_SESSION_STATE_EXITING )
-	{
-		// (5.1) Poll for xr events
-		XrEventDataBaseHeader xrEventDataBaseheader { XR_TYPE_EVENT_DATA_EVENTS_LOST };
-		if ( !XR_SUCCEEDED( pApp->GetSession()->Poll( &xrEventDataBaseheader ) ) )
-			continue;
-
-		// (5.2) Process xr events
-		pApp->ProcessXrEvents( xrEventDataBaseheader );
-
-		// (5.3) Render frame
-		CThreadPool *pThreadPool = pApp->pThreadPool.get();
-		bool bFrameStarted = pThreadPool->SubmitRenderTask( [ pApp = pApp.get() ]() { return pApp->StartRenderFrame(); } ).get();
-
-		if ( bFrameStarted )
+	// (5) Late latched hand joints - located on the render thread at the predicted display time of the frame being submitted,
+	//     just before it's recorded, and written straight to the debug indicators. Left hand joints first, followed by the right.
+	SJointBuffer jointBuffer;
+	pApp->AddLateLatch(
+		[ pApp = pApp.get(), pHandtracking = pHandtracking.get(), &jointLocations, &jointBuffer, debugIndicator ]( XrTime predictedDisplayTime )
 		{
-			// Check conditions before submitting to thread pool
-			if ( pHandtracking && 
-					pApp->pRenderInfo->state.frameState.shouldRender && 
-					( pApp->pRenderInfo->state.sharedEyeState.viewStateFlags & XR_VIEW_STATE_ORIENTATION_VALID_BIT ) 
-			   )
-			{
-				// Locate hand joints (can be done before waiting for the updates)
-				pHandtracking->LocateHandJoints( &jointLocations, pApp->GetSession()->GetAppSpace(), pApp->pRenderInfo->state.frameState.predictedDisplayTime );
-
-				// Submit task for left hand joints
-				auto leftHandUpdateFuture = pThreadPool->SubmitTask(
-					[ pApp = pApp.get(), pHandtracking = pHandtracking.get(), &debugIndicator, &jointLocations ]()
-					{
-						// Process left hand joints
-						for ( size_t i = 0; i < XR_HAND_JOINT_COUNT_EXT; i++ )
-						{
-							if ( jointLocations.leftJointLocations[ i ].locationFlags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT )
-							{
-								debugIndicator->instances[ i ].pose = jointLocations.leftJointLocations[ i ].pose;
-								debugIndicator->ResetScale( jointLocations.leftJointLocations[ i ].radius, i );
-							}
-						}
-					} );
-
-				// Submit task for right hand joints
-				auto rightHandUpdateFuture = pThreadPool->SubmitTask(
-					[ pApp = pApp.get(), pHandtracking = pHandtracking.get(), &debugIndicator, &jointLocations ]()
-					{
-						// Process right hand joints
-						for ( size_t i = 0; i < XR_HAND_JOINT_COUNT_EXT; i++ )
-						{
-							if ( jointLocations.rightJointLocations[ i ].locationFlags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT )
-							{
-								// Offset by XR_HAND_JOINT_COUNT_EXT to store right hand instances after left hand
-								size_t rightHandIndex = i + XR_HAND_JOINT_COUNT_EXT;
-								debugIndicator->instances[ rightHandIndex ].pose = jointLocations.rightJointLocations[ i ].pose;
-								debugIndicator->ResetScale( jointLocations.rightJointLocations[ i ].radius, rightHandIndex );
-							}
-						}
-					} );
-
-				// Wait for both hand updates to complete
-				leftHandUpdateFuture.wait();
-				rightHandUpdateFuture.wait();
-			}
-
-			// Submit EndRenderFrame to render thread and wait for it
-			pThreadPool->SubmitRenderTask( [ pApp = pApp.get() ]() { pApp->EndRenderFrame(); } ).get();
-		}
-
-	}
+			if ( !( pApp->pRenderInfo->state.sharedEyeState.viewStateFlags & XR_VIEW_STATE_ORIENTATION_VALID_BIT ) )
+				return;
+
+			pHandtracking->LocateHandJoints( &jointLocations, pApp->GetSession()->GetAppSpace(), predictedDisplayTime );
+
+			// Record or replay the joints (see --record-input/--replay-input)
+			pApp->inputCapture.Capture( ECaptureStream::HandJoints, &jointLocations.leftJointLocations[ 0 ], XR_HAND_JOINT_COUNT_EXT );
+			pApp->inputCapture.Capture( ECaptureStream::HandJoints, &jointLocations.rightJointLocations[ 0 ], XR_HAND_JOINT_COUNT_EXT );
+
+			// Copy both hands to the joint buffer and validate them in a single pass
+			jointBuffer.Clear();
+			jointBuffer.Append( &jointLocations.leftJointLocations[ 0 ], XR_HAND_JOINT_COUNT_EXT );
+			jointBuffer.Append( &jointLocations.rightJointLocations[ 0 ], XR_HAND_JOINT_COUNT_EXT );
+			UpdateJoints( jointBuffer );
+
+			ForEachValidJoint( jointBuffer,
+				[ debugIndicator ]( uint32_t i, const XrPosef &pose, float radius )
+				{
+					debugIndicator->instances[ i ].pose = pose;
+					debugIndicator->ResetScale( radius, i );
+				} );
+		} );
+
+	// (6) Render loop - all per frame work is the render thread's late latch, the main thread only polls events and paces frames
+	CFrameScheduler frameScheduler( pApp.get(), SFrameTasks() );
+	while ( frameScheduler.Tick() ) {}
+
+	frameScheduler.Flush();
 
 	// (14) Exit app - xrlib objects (instance, session, renderer, etc) handles proper cleanup once unique pointers goes out of scope.
 	//				  Note that as they are in the same scope in this demo, order of destruction here is automatically enforced only when using C++20 and above
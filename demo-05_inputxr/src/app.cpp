@@ -233,97 +233,72 @@ namespace app
 	
 		// RENDER MODELS (organized by depth, parallel processing using worker threads from thread pool manager)
 		
-		// (2) Define models to be used in this app
+		// (2) Define models to be used in this app - both hands share one hilt, blade and button model each (see AddSharedMesh)
 		assets.pSky = new CRenderModel( m_pXrSession.get(), pRenderInfo.get(), pipelines.pbrLayout, pipelines.sky );
 		assets.pFloor = new CRenderModel( m_pXrSession.get(), pRenderInfo.get(), pipelines.pbrLayout, pipelines.floor );
-		assets.pHiltLeft = new CRenderModel( m_pXrSession.get(), pRenderInfo.get(), pipelines.pbrLayout, pipelines.pbr );
-		assets.pHiltRight = new CRenderModel( m_pXrSession.get(), pRenderInfo.get(), pipelines.pbrLayout, pipelines.pbr );
-		assets.pBladeLeft = new CRenderModel( m_pXrSession.get(), pRenderInfo.get(), pipelines.pbrLayout, pipelines.bladePipeline );
-		assets.pBladeRight = new CRenderModel( m_pXrSession.get(), pRenderInfo.get(), pipelines.pbrLayout, pipelines.bladePipeline );
-		assets.pButtonBottomLeft = new CRenderModel( m_pXrSession.get(), pRenderInfo.get(), pipelines.pbrLayout, pipelines.buttonPipeline );
-		assets.pButtonTopLeft = new CRenderModel( m_pXrSession.get(), pRenderInfo.get(), pipelines.pbrLayout, pipelines.buttonPipeline );
-		assets.pButtonBottomRight = new CRenderModel( m_pXrSession.get(), pRenderInfo.get(), pipelines.pbrLayout, pipelines.buttonPipeline );
-		assets.pButtonTopRight = new CRenderModel( m_pXrSession.get(), pRenderInfo.get(), pipelines.pbrLayout, pipelines.buttonPipeline );
-
-		// Set visibility for buttons
-		assets.pButtonBottomLeft->isVisible = false;
-		assets.pButtonTopLeft->isVisible = false;
-		assets.pButtonBottomRight->isVisible = false;
-		assets.pButtonTopRight->isVisible = false;
+
+		for ( uint32_t unHand = 0; unHand < 2; unHand++ )
+		{
+			assets.hilt[ unHand ] = AddSharedMesh( "Saber/hilt/hilt.gltf", SAssets::MODEL_SCALE, pipelines.pbrLayout, pipelines.pbr );
+			assets.blade[ unHand ] = AddSharedMesh( "Saber/blade.glb", SAssets::MODEL_SCALE, pipelines.pbrLayout, pipelines.bladePipeline );
+			assets.buttonBottom[ unHand ] = AddSharedMesh( "Saber/btnbottom.glb", SAssets::MODEL_SCALE, pipelines.pbrLayout, pipelines.buttonPipeline );
+			assets.buttonTop[ unHand ] = AddSharedMesh( "Saber/btntop.glb", SAssets::MODEL_SCALE, pipelines.pbrLayout, pipelines.buttonPipeline );
+		}
 
 		// Lift and flip plane for sky 
 		assets.pSky->instances[ 0 ].pose.position.y = 100.f;
 		assets.pSky->instances[ 0 ].pose.orientation = { 1.0f, 0.0f, 0.0f, 0.0f };
 
-		// (3) Parallel load meshes using built-in thread pool manager
-		ParallelLoadMeshes( { 
-			{ .pRenderModel = assets.pSky, .sFilename = "plane.glb", .scale = { 5000.0f, 1.f, 5000.0f } },
-			{ .pRenderModel = assets.pFloor, .sFilename = "plane.glb", .scale = { 5.0f, 1.f, 5.0f } },
-			{ .pRenderModel = assets.pHiltLeft, .sFilename = "Saber/hilt/hilt.gltf", .scale = { 0.04f, 0.04f, 0.04f } },
-			{ .pRenderModel = assets.pHiltRight, .sFilename = "Saber/hilt/hilt.gltf", .scale = { 0.04f, 0.04f, 0.04f } },
-			{ .pRenderModel = assets.pBladeLeft, .sFilename = "Saber/blade.glb", .scale = { 0.04f, 0.04f, 0.04f } },
-			{ .pRenderModel = assets.pBladeRight, .sFilename = "Saber/blade.glb", .scale = { 0.04f, 0.04f, 0.04f } },
-			{ .pRenderModel = assets.pButtonBottomLeft, .sFilename = "Saber/btnbottom.glb", .scale = { 0.04f, 0.04f, 0.04f } },
-			{ .pRenderModel = assets.pButtonTopLeft, .sFilename = "Saber/btntop.glb", .scale = { 0.04f, 0.04f, 0.04f } },
-			{ .pRenderModel = assets.pButtonBottomRight, .sFilename = "Saber/btnbottom.glb", .scale = { 0.04f, 0.04f, 0.04f } },
-			{ .pRenderModel = assets.pButtonTopRight, .sFilename = "Saber/btntop.glb", .scale = { 0.04f, 0.04f, 0.04f } },
-		} );
+		// (3) Parallel load meshes, materials and mesh buffers using built-in thread pool manager.
+		//     Each asset is loaded -> parsed -> material loaded -> buffers initialized without waiting on the others.
 
-		// (4) Define and load materials for each mesh
+		// load materials for meshes where we want dynamic updates to material variables (callbacks run one at a time),
+		// these are tracked by the material store so only values that actually changed are written each frame
+		auto dynamicMaterial = [ this ]( uint32_t &outMaterialDataId )
+		{
+			return [ this, &outMaterialDataId ]( CRenderModel *pRenderModel )
+			{
+				pRenderModel->LoadMaterial( gamestate.vecMaterialData, pRenderInfo.get(), pipelines.pbrFragmentDescriptorLayout, pipelines.pbrFragmentDescriptorPool, pTextureManager.get() );
+				outMaterialDataId = materialStore.Add( gamestate.vecMaterialData.back() );
+			};
+		};
 
 		// load materials for meshes where we don't need to update any material variables (scene lighting is always dynamic)
-		ParallelLoadMaterials( {
-			{ .pRenderModel = assets.pHiltLeft, .descriptorLayout = pipelines.pbrFragmentDescriptorLayout, .descriptorPool = pipelines.pbrFragmentDescriptorPool },
-			{ .pRenderModel = assets.pHiltRight, .descriptorLayout = pipelines.pbrFragmentDescriptorLayout, .descriptorPool = pipelines.pbrFragmentDescriptorPool },
-			{ .pRenderModel = assets.pButtonBottomLeft, .descriptorLayout = pipelines.pbrFragmentDescriptorLayout, .descriptorPool = pipelines.pbrFragmentDescriptorPool },
-			{ .pRenderModel = assets.pButtonTopLeft, .descriptorLayout = pipelines.pbrFragmentDescriptorLayout, .descriptorPool = pipelines.pbrFragmentDescriptorPool },
-			{ .pRenderModel = assets.pButtonBottomRight, .descriptorLayout = pipelines.pbrFragmentDescriptorLayout, .descriptorPool = pipelines.pbrFragmentDescriptorPool },
-			{ .pRenderModel = assets.pButtonTopRight, .descriptorLayout = pipelines.pbrFragmentDescriptorLayout, .descriptorPool = pipelines.pbrFragmentDescriptorPool },
-		});
-
-		// load materials for meshes where we want dynamic updates to material variables
-		assets.pSky->LoadMaterial( gamestate.vecMaterialData, pRenderInfo.get(), pipelines.pbrFragmentDescriptorLayout, pipelines.pbrFragmentDescriptorPool, pTextureManager.get() );
-		gamestate.skyMateriaDataId = gamestate.vecMaterialData.size() - 1;
-		gamestate.vecMaterialData[ gamestate.skyMateriaDataId ]->emissiveFactor[ 1 ] = 1.0f; // reset opacity value input for shader
-
-		assets.pFloor->LoadMaterial( gamestate.vecMaterialData, pRenderInfo.get(), pipelines.pbrFragmentDescriptorLayout, pipelines.pbrFragmentDescriptorPool, pTextureManager.get() );
-		gamestate.floorMateriaDataId = gamestate.vecMaterialData.size() - 1;
-
-		assets.pBladeLeft->LoadMaterial( gamestate.vecMaterialData, pRenderInfo.get(), pipelines.pbrFragmentDescriptorLayout, pipelines.pbrFragmentDescriptorPool, pTextureManager.get() );
-		gamestate.leftBladeMateriaDataId = gamestate.vecMaterialData.size() - 1;
-
-		assets.pBladeRight->LoadMaterial( gamestate.vecMaterialData, pRenderInfo.get(), pipelines.pbrFragmentDescriptorLayout, pipelines.pbrFragmentDescriptorPool, pTextureManager.get() );
-		gamestate.rightBladeMateriaDataId = gamestate.vecMaterialData.size() - 1;
-
-		// (5) Init mesh buffers
-		assets.pSky->InitBuffers();
-		assets.pFloor->InitBuffers();
-		assets.pHiltLeft->InitBuffers();
-		assets.pHiltRight->InitBuffers();
-		assets.pBladeLeft->InitBuffers();
-		assets.pBladeRight->InitBuffers();
-		assets.pButtonBottomLeft->InitBuffers();
-		assets.pButtonTopLeft->InitBuffers();
-		assets.pButtonBottomRight->InitBuffers();
-		assets.pButtonTopRight->InitBuffers();
-
-		// (6) Add all meshes to render info for rendering (arranged sequentially as per desired depth draw)
+		auto staticMaterial = [ this ]( CRenderModel *pRenderModel, const std::string &sFilename )
+		{
+			return SAssetInfo {
+				.mesh = { .pRenderModel = pRenderModel, .sFilename = sFilename, .scale = SAssets::MODEL_SCALE },
+				.bLoadMaterial = true,
+				.descriptorLayout = pipelines.pbrFragmentDescriptorLayout,
+				.descriptorPool = pipelines.pbrFragmentDescriptorPool };
+		};
+
+		// Shared models are loaded once, through the hand that created them
+		ParallelLoadAssets( {
+			{ .mesh = { .pRenderModel = assets.pSky, .sFilename = "plane.glb", .scale = { 5000.0f, 1.f, 5000.0f } }, .fnLoadMaterial = dynamicMaterial( gamestate.skyMateriaDataId ) },
+			{ .mesh = { .pRenderModel = assets.pFloor, .sFilename = "plane.glb", .scale = { 5.0f, 1.f, 5.0f } }, .fnLoadMaterial = dynamicMaterial( gamestate.floorMateriaDataId ) },
+			staticMaterial( assets.hilt[ 0 ].pRenderModel, "Saber/hilt/hilt.gltf" ),
+			{ .mesh = { .pRenderModel = assets.blade[ 0 ].pRenderModel, .sFilename = "Saber/blade.glb", .scale = SAssets::MODEL_SCALE }, .fnLoadMaterial = dynamicMaterial( gamestate.bladeMateriaDataId ) },
+			staticMaterial( assets.buttonBottom[ 0 ].pRenderModel, "Saber/btnbottom.glb" ),
+			staticMaterial( assets.buttonTop[ 0 ].pRenderModel, "Saber/btntop.glb" ),
+		} );
+
+		// (4) Reset opacity value input for the sky shader
+		materialStore.Set( gamestate.skyMateriaDataId, materialStore.Get( gamestate.skyMateriaDataId ).emissiveFactor[ 1 ], 1.0f );
+
+		// (5) Add all meshes to render info for rendering (arranged sequentially as per desired depth draw)
 		pRenderInfo->vecRenderables.push_back( dynamic_cast< CRenderable * >( assets.pSky ) );
 		pRenderInfo->vecRenderables.push_back( dynamic_cast< CRenderable * >( assets.pFloor ) );
-		pRenderInfo->vecRenderables.push_back( dynamic_cast< CRenderable * >( assets.pHiltLeft ) );
-		pRenderInfo->vecRenderables.push_back( dynamic_cast< CRenderable * >( assets.pHiltRight ) );
-		pRenderInfo->vecRenderables.push_back( dynamic_cast< CRenderable * >( assets.pBladeLeft ) );
-		pRenderInfo->vecRenderables.push_back( dynamic_cast< CRenderable * >( assets.pBladeRight ) );
-		pRenderInfo->vecRenderables.push_back( dynamic_cast< CRenderable * >( assets.pButtonBottomLeft ) );
-		pRenderInfo->vecRenderables.push_back( dynamic_cast< CRenderable * >( assets.pButtonTopLeft ) );
-		pRenderInfo->vecRenderables.push_back( dynamic_cast< CRenderable * >( assets.pButtonBottomRight ) );
-		pRenderInfo->vecRenderables.push_back( dynamic_cast< CRenderable * >( assets.pButtonTopRight ) );
-	}
-
-	void App::ProcessXrEvents( XrEventDataBaseHeader &xrEventDataBaseheader ) 
-	{
-		ProcessEvents_SessionState( xrEventDataBaseheader );
-		ProcessEvents_Vismasks( xrEventDataBaseheader );
+		pRenderInfo->vecRenderables.push_back( dynamic_cast< CRenderable * >( assets.hilt[ 0 ].pRenderModel ) );
+		pRenderInfo->vecRenderables.push_back( dynamic_cast< CRenderable * >( assets.blade[ 0 ].pRenderModel ) );
+		pRenderInfo->vecRenderables.push_back( dynamic_cast< CRenderable * >( assets.buttonBottom[ 0 ].pRenderModel ) );
+		pRenderInfo->vecRenderables.push_back( dynamic_cast< CRenderable * >( assets.buttonTop[ 0 ].pRenderModel ) );
+
+		// (6) Seed the render state back buffer from the scene
+		renderstate.bladeScale[ 0 ] = assets.blade[ 0 ].GetInstance().scale;
+		renderstate.bladeScale[ 1 ] = assets.blade[ 1 ].GetInstance().scale;
+		renderstate.skyY = assets.pSky->instances[ 0 ].pose.position.y;
+		renderstate.skyOpacity = materialStore.Get( gamestate.skyMateriaDataId ).emissiveFactor[ 1 ];
 	}
 
 	bool App::StartRenderFrame()
@@ -345,21 +320,67 @@ namespace app
 				pRenderInfo->state.clearValues[ 0 ].color = { { 0.0f, 0.0f, 0.0f, 1.0f } };
 			}
 
-			// Submit actual render work to render thread
-			return GetRender()->StartRenderFrame( pRenderInfo.get() );
+			// Submit actual render work to render thread, xrapp late latches registered poses
+			return XrApp::StartRenderFrame();
 		}
 
 		return false;
 	}
 
-	void App::EndRenderFrame() 
-	{ 
-		GetRender()->EndRenderFrame( mainRenderPass, pRenderInfo.get(), vecMasks ); 
+	void App::Simulate( const SFrameContext &context )
+	{
+		// Sky fade (skyY, skyOpacity) is tweened, tweens are already updated to this frame's simulation time
+
+		// Update sky shader time
+		renderstate.skyTime = static_cast< float >( GetFrameClock().dSeconds );
+
+		// Update player position for floor marker
+		renderstate.floorMarker = { context.hmdPose.position.x, context.hmdPose.position.z };
+
+		// Update plasma blade effect
+		renderstate.plasmaTime = static_cast< float >( GetFrameClock().dSeconds );
 	}
 
-	bool App::ScaleBlade( XrVector3f &outScale, float inputValue, float refreshRate, float scaleSpeed ) 
+	void App::PublishRenderState()
 	{
-		if ( refreshRate <= 0.0f )
+		// Visibility and transforms - the hands share each model, so hidden instances are scaled to zero rather than the model hidden
+		const XrVector3f zeroScale = { 0.f, 0.f, 0.f };
+		for ( uint32_t unHand = 0; unHand < 2; unHand++ )
+		{
+			const bool bControllerActive = renderstate.bControllerActive[ unHand ];
+			assets.hilt[ unHand ].GetInstance().scale = bControllerActive ? SAssets::MODEL_SCALE : zeroScale;
+			assets.blade[ unHand ].GetInstance().scale = bControllerActive ? renderstate.bladeScale[ unHand ] : zeroScale;
+			assets.buttonBottom[ unHand ].GetInstance().scale = renderstate.bRenderModeButton[ unHand ] ? SAssets::MODEL_SCALE : zeroScale;
+			assets.buttonTop[ unHand ].GetInstance().scale = renderstate.bPassthroughButton[ unHand ] ? SAssets::MODEL_SCALE : zeroScale;
+		}
+
+		assets.pSky->instances[ 0 ].pose.position.y = renderstate.skyY;
+
+		// Material values - only changed ones are written, once the frame scheduler flushes the store
+		auto SetEmissive = [ this ]( uint32_t unMaterialId, uint32_t unComponent, float fValue )
+		{
+			materialStore.Set( unMaterialId, materialStore.Get( unMaterialId ).emissiveFactor[ unComponent ], fValue );
+		};
+
+		SetEmissive( gamestate.skyMateriaDataId, 0, renderstate.skyTime );
+		SetEmissive( gamestate.skyMateriaDataId, 1, renderstate.skyOpacity );
+		SetEmissive( gamestate.floorMateriaDataId, 0, renderstate.floorMarker.x );
+		SetEmissive( gamestate.floorMateriaDataId, 1, renderstate.floorMarker.y );
+		SetEmissive( gamestate.bladeMateriaDataId, 3, renderstate.plasmaTime );
+
+		// Scene lighting
+		if ( renderstate.bTonemappingChanged && pRenderInfo->pSceneLighting )
+		{
+			pRenderInfo->pSceneLighting->tonemapping.setRenderMode( gamestate.currentRenderMode );
+			pRenderInfo->pSceneLighting->tonemapping.setTonemapOperator( gamestate.currentToneMapper );
+		}
+
+		renderstate.bTonemappingChanged = false;
+	}
+
+	bool App::ScaleBlade( XrVector3f &outScale, float inputValue, float deltaSeconds, float scaleSpeed ) 
+	{
+		if ( deltaSeconds <= 0.0f )
 			return false;
 
 		// Set scale parameters
@@ -396,8 +417,8 @@ namespace app
 		}
 
 		// Calculate scale change based on input value
-		float fps = 1000.0f / refreshRate;
-		float scaleChange = scaleSpeed * fps * scaleFactor;
+		float frameMs = deltaSeconds * 1000.0f;
+		float scaleChange = scaleSpeed * frameMs * scaleFactor;
 
 		// Set scale
 		float newScale = outScale.z + scaleChange;
@@ -414,31 +435,12 @@ namespace app
 		return true;
 	}
 
-	void App::ActionCallback_SetControllerActive( SAction *pAction, uint32_t unActionStateIndex ) const
+	void App::ActionCallback_SetControllerActive( SAction *pAction, uint32_t unActionStateIndex )
 	{
-		bool bState = pAction->vecActionStates[ unActionStateIndex ].statePose.isActive;
-
-		if ( unActionStateIndex == 0 )
-		{
-			if ( assets.pHiltLeft )
-				assets.pHiltLeft->isVisible = bState;
-
-			if ( assets.pBladeLeft )
-				assets.pBladeLeft->isVisible = bState;
-
+		if ( unActionStateIndex > 1 )
 			return;
-		}
-		
-		if ( unActionStateIndex == 1 )
-		{
-			if ( assets.pHiltRight )
-				assets.pHiltRight->isVisible = bState;
 
-			if ( assets.pBladeRight )
-				assets.pBladeRight->isVisible = bState;
-
-			return;
-		}
+		renderstate.bControllerActive[ unActionStateIndex ] = pAction->vecActionStates[ unActionStateIndex ].statePose.isActive;
 	}
 
 	void App::ActionCallback_ScaleBlade( SAction *pAction, uint32_t unActionStateIndex ) 
@@ -447,11 +449,9 @@ namespace app
 		
 		if ( state.isActive )
 		{
-			XrVector3f &scale = unActionStateIndex == 0 ? assets.pBladeLeft->instances[ 0 ].scale : assets.pBladeRight->instances[ 0 ].scale;
+			XrVector3f &scale = renderstate.bladeScale[ unActionStateIndex == 0 ? 0 : 1 ];
 
-			float displayRate =
-				GetDisplayRate() ? GetDisplayRate()->GetCurrentRefreshRate( GetSession()->GetXrSession() ) : 72.0f;
-			bool isScaling = ScaleBlade( scale, state.currentState, displayRate );
+			bool isScaling = ScaleBlade( scale, state.currentState, GetFrameClock().fDeltaSeconds );
 
 			if ( isScaling && pHapticAction )
 				ActionHaptic( pHapticAction, unActionStateIndex );
@@ -461,7 +461,7 @@ namespace app
 	void App::ActionCallback_CycleRenderMode( SAction *pAction, uint32_t unActionStateIndex ) 
 	{
 		// Update button visibility
-		bool &bState = unActionStateIndex == 0 ? assets.pButtonBottomLeft->isVisible : assets.pButtonBottomRight->isVisible;
+		bool &bState = renderstate.bRenderModeButton[ unActionStateIndex == 0 ? 0 : 1 ];
 		bState = pAction->vecActionStates[ unActionStateIndex ].stateBoolean.currentState;
 		
 		// Cycle through render mode and tone mapping functions
@@ -478,8 +478,7 @@ namespace app
 						gamestate.currentRenderMode = ERenderMode::PBR;
 						gamestate.currentToneMapper = ETonemapOperator::None;
 
-						pRenderInfo->pSceneLighting->tonemapping.setRenderMode( gamestate.currentRenderMode );
-						pRenderInfo->pSceneLighting->tonemapping.setTonemapOperator( gamestate.currentToneMapper );
+						renderstate.bTonemappingChanged = true;
 
 						return;
 						break;
@@ -510,8 +509,7 @@ namespace app
 						gamestate.currentToneMapper = ETonemapOperator::None;
 						gamestate.currentRenderMode = ERenderMode::Unlit;
 
-						pRenderInfo->pSceneLighting->tonemapping.setRenderMode( gamestate.currentRenderMode );
-						pRenderInfo->pSceneLighting->tonemapping.setTonemapOperator( gamestate.currentToneMapper );
+						renderstate.bTonemappingChanged = true;
 
 						return;
 						break;
@@ -520,30 +518,31 @@ namespace app
 				}
 			}
 
-			pRenderInfo->pSceneLighting->tonemapping.setRenderMode( gamestate.currentRenderMode );
-			pRenderInfo->pSceneLighting->tonemapping.setTonemapOperator( gamestate.currentToneMapper );
+			renderstate.bTonemappingChanged = true;
 		}
 	}
 
 	void App::ActionCallback_TogglePassthrough( SAction *pAction, uint32_t unActionStateIndex ) 
 	{ 
 		// Update button visibility
-		bool &bState = unActionStateIndex == 0 ? assets.pButtonTopLeft->isVisible : assets.pButtonTopRight->isVisible;
+		bool &bState = renderstate.bPassthroughButton[ unActionStateIndex == 0 ? 0 : 1 ];
 		bState = pAction->vecActionStates[ unActionStateIndex ].stateBoolean.currentState;
 
 		// Start/Stop passthrough if available
 		if ( bState )
 		{	
 			// If sky is above, then fade out
-			if ( assets.pSky->instances[ 0 ].pose.position.y > ( SkyAnimation::START_Y / 2 ) )
+			if ( renderstate.skyY > ( SkyAnimation::START_Y / 2 ) )
 			{
-				skyanim.StartAnimation( false, 0.02f );
+				tweens.Animate( renderstate.skyY, SkyAnimation::END_Y, SkyAnimation::FADE_OUT_SECONDS, EEase::OutCubic );
+				tweens.Animate( renderstate.skyOpacity, SkyAnimation::END_OPACITY, SkyAnimation::FADE_OUT_SECONDS * 0.5f, EEase::OutCubic );
 				if ( GetPassthrough() )
 					GetPassthrough()->Start();
 			}
 			else
 			{
-				skyanim.StartAnimation( true, 0.03f );
+				tweens.Animate( renderstate.skyY, SkyAnimation::START_Y, SkyAnimation::FADE_IN_SECONDS, EEase::OutCubic );
+				tweens.Animate( renderstate.skyOpacity, SkyAnimation::START_OPACITY, SkyAnimation::FADE_IN_SECONDS * 0.5f, EEase::OutCubic );
 				if ( GetPassthrough() )
 					GetPassthrough()->Stop();
 			}
@@ -551,26 +550,26 @@ namespace app
 		}
 	}
 
-	void App::ActionHaptic( SAction *pAction, uint32_t unActionStateIndex ) const
+	void App::ActionHaptic( SAction *pAction, uint32_t unActionStateIndex )
 	{
-		if ( !pInput )
-			return;
+		// Queued and merged with other requests for the same hand, applied once per frame by the app's haptic scheduler
+		SHapticPulse pulse;
+		pulse.fAmplitude = 0.5f;
+		pulse.duration = XR_MIN_HAPTIC_DURATION;
+		pulse.fFrequency = XR_FREQUENCY_UNSPECIFIED;
 
-		// Haptic params (these are also params of the GenerateHaptic() function
-		// adding here for visibility
-		uint64_t unDuration = XR_MIN_HAPTIC_DURATION;
-		float fAmplitude = 0.5f;
-		float fFrequency = XR_FREQUENCY_UNSPECIFIED;
+		haptics.Request( pAction->xrActionHandle, pAction->vecSubactionpaths.empty() ? XR_NULL_PATH : pAction->vecSubactionpaths[ unActionStateIndex ], pulse );
+	}
 
-		// Check if the action has subpaths
-		if ( !pAction->vecSubactionpaths.empty() )
-		{
-			pInput->GenerateHaptic( pAction->xrActionHandle, pAction->vecSubactionpaths[ unActionStateIndex ], unDuration, fAmplitude, fFrequency );
-		}
+	void App::ActionHapticSustain( SAction *pAction, uint32_t unActionStateIndex, bool bSustain )
+	{
+		// One long vibration renewed only when it's about to run out, rather than a pulse each frame
+		XrPath subactionPath = pAction->vecSubactionpaths.empty() ? XR_NULL_PATH : pAction->vecSubactionpaths[ unActionStateIndex ];
+
+		if ( bSustain )
+			haptics.Sustain( pAction->xrActionHandle, subactionPath, 0.5f );
 		else
-		{
-			pInput->GenerateHaptic( pAction->xrActionHandle, XR_NULL_PATH, unDuration, fAmplitude, fFrequency );
-		}
+			haptics.Release( pAction->xrActionHandle, subactionPath );
 	}
 
 
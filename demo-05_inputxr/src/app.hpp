@@ -7,9 +7,9 @@
 
 #include <iostream>
 #include <memory>
-#include <chrono>
 
 #include <xrapp.hpp>
+#include <frame_scheduler.hpp>
 
 using namespace xrlib;
 using namespace xrapp;
@@ -40,22 +40,23 @@ namespace app
 			int Init();
 		#endif
 
-			~App();
+			~App() override;
 
 			void SetupScene();
-			void ProcessXrEvents( XrEventDataBaseHeader &xrEventDataBaseheader );
+			bool StartRenderFrame() override;
 
-			bool StartRenderFrame();
-			void EndRenderFrame();
+			void Simulate( const SFrameContext &context );
+			void PublishRenderState();
 
-			static bool ScaleBlade( XrVector3f &outScale, float inputValue, float refreshRate, float scaleSpeed = 0.001f );
+			static bool ScaleBlade( XrVector3f &outScale, float inputValue, float deltaSeconds, float scaleSpeed = 0.001f );
 
-			void ActionCallback_SetControllerActive( SAction *pAction, uint32_t unActionStateIndex ) const;
+			void ActionCallback_SetControllerActive( SAction *pAction, uint32_t unActionStateIndex );
 			void ActionCallback_ScaleBlade( SAction *pAction, uint32_t unActionStateIndex );
 			void ActionCallback_CycleRenderMode( SAction *pAction, uint32_t unActionStateIndex );
 			void ActionCallback_TogglePassthrough( SAction *pAction, uint32_t unActionStateIndex );
 
-			void ActionHaptic( SAction *pAction, uint32_t unActionStateIndex ) const;
+			void ActionHaptic( SAction *pAction, uint32_t unActionStateIndex );
+			void ActionHapticSustain( SAction *pAction, uint32_t unActionStateIndex, bool bSustain );
 
 			struct SAppPipelines : public SPipelines
 			{
@@ -67,122 +68,62 @@ namespace app
 			{
 				CRenderModel *pSky = nullptr;
 				CRenderModel *pFloor = nullptr;
-				
-				CRenderModel *pHiltLeft = nullptr; 
-				CRenderModel *pHiltRight = nullptr; 
 
-				CRenderModel *pBladeLeft = nullptr; 
-				CRenderModel *pBladeRight = nullptr; 
-
-				CRenderModel *pButtonBottomLeft = nullptr;
-				CRenderModel *pButtonTopLeft = nullptr; 
-
-				CRenderModel *pButtonBottomRight = nullptr;
-				CRenderModel *pButtonTopRight = nullptr; 
+				// Per hand (0: left, 1: right) instances of shared models - both hands draw from one set of buffers
+				SSharedMesh hilt[ 2 ];
+				SSharedMesh blade[ 2 ];
+				SSharedMesh buttonBottom[ 2 ];
+				SSharedMesh buttonTop[ 2 ];
 
+				// Saber model scale, hidden instances are scaled to zero instead
+				static constexpr XrVector3f MODEL_SCALE = { 0.04f, 0.04f, 0.04f };
 			}assets;
 
+			// Sky fade out/in, tweened by the app's tween system
 			struct SkyAnimation
 			{
-				bool isAnimating = false;
-				bool isReversing = false;
-				float animationSpeed = 1.0f;
-
 				// Target values
 				static constexpr float START_Y = 100.0f;
 				static constexpr float END_Y = 10.0f;
 				static constexpr float START_OPACITY = 1.0f;
 				static constexpr float END_OPACITY = 0.0f;
-				static constexpr float EPSILON = 0.001f;
-
-				bool StartAnimation( bool reverse = false, float speed = 1.0f )
-				{
-					isAnimating = true;
-					isReversing = reverse;
-					animationSpeed = speed;
-					return true;
-				}
-
-				void UpdateAnimation( SAssets &assets, XrTime predictedDisplayPeriod, float displayRate, uint32_t skyMaterialDataId, std::vector< SMaterialUBO * > &vecMaterialData )
-				{
-					if ( !isAnimating )
-						return;
-
-					// Convert XrTime (nanoseconds) to seconds
-					float deltaTimeSeconds = static_cast< float >( predictedDisplayPeriod ) * 1e-9f;
-					float normalizedDelta = deltaTimeSeconds * displayRate * animationSpeed;
-
-					// Get target values based on animation direction
-					float targetY = isReversing ? START_Y : END_Y;
-					float targetOpacity = isReversing ? START_OPACITY : END_OPACITY;
-
-					// Update position
-					float currentY = assets.pSky->instances[ 0 ].pose.position.y;
-					float newY = std::lerp( currentY, targetY, normalizedDelta );
-					assets.pSky->instances[ 0 ].pose.position.y = newY;
-
-					// Update opacity
-					float currentOpacity = vecMaterialData[ skyMaterialDataId ]->emissiveFactor[ 1 ];
-					float newOpacity = std::lerp( currentOpacity, targetOpacity, normalizedDelta * 2.0f );
-					vecMaterialData[ skyMaterialDataId ]->emissiveFactor[ 1 ] = newOpacity;
-
-					// Check if animation is complete
-					if ( std::abs( newY - targetY ) < EPSILON && std::abs( newOpacity - targetOpacity ) < EPSILON )
-					{
-						isAnimating = false;
-					}
-				}
-
-			} skyanim;
-
-			struct SPlasmaEffect
-			{
-				std::chrono::steady_clock::time_point lastFrameTime = std::chrono::steady_clock::now(); 
-				float accumulatedTime = 0.0f;
-				bool firstFrame = true; 
-
-				void UpdateEffect( SMaterialUBO *left, SMaterialUBO *right )
-				{
-					auto currentTime = std::chrono::steady_clock::now();
-
-					// Handle first frame
-					if ( firstFrame )
-					{
-						lastFrameTime = currentTime;
-						firstFrame = false;
-					}
-
-					float deltaTime = std::chrono::duration< float >( currentTime - lastFrameTime ).count();
 
-					// Clamp delta time to prevent huge jumps
-					const float maxDeltaTime = 1.0f / 30.0f;
-					deltaTime = std::min( deltaTime, maxDeltaTime );
-
-					accumulatedTime += deltaTime;
-					lastFrameTime = currentTime;
-
-					// Update material
-					if ( left )
-						left->emissiveFactor[ 3 ] = accumulatedTime;
-
-					if ( right )
-						right->emissiveFactor[ 3 ] = accumulatedTime;
-
-				}
-			} plasma;
+				// Durations in seconds, opacity changes twice as fast as the sky moves
+				static constexpr float FADE_OUT_SECONDS = 2.5f;
+				static constexpr float FADE_IN_SECONDS = 1.5f;
+			};
 
 			struct SGameState
 			{
 				ERenderMode currentRenderMode = ERenderMode::Unlit;
 				ETonemapOperator currentToneMapper = ETonemapOperator::None;
 
+				// Material store ids
 				uint32_t skyMateriaDataId = 0;
 				uint32_t floorMateriaDataId = 0;
-				uint32_t leftBladeMateriaDataId = 0;
-				uint32_t rightBladeMateriaDataId = 0;
+				uint32_t bladeMateriaDataId = 0;
 				std::vector< SMaterialUBO * > vecMaterialData;
 			}gamestate;
 
+			// Back buffer for everything input and simulation change on renderables and materials.
+			// Written by action callbacks (input thread) and Simulate (main thread) while the render thread
+			// submits the previous frame, then copied over in PublishRenderState once the render thread is idle.
+			struct SRenderState
+			{
+				bool bControllerActive[ 2 ] = { false, false };
+				bool bRenderModeButton[ 2 ] = { false, false };
+				bool bPassthroughButton[ 2 ] = { false, false };
+				XrVector3f bladeScale[ 2 ] = { { 1.f, 1.f, 1.f }, { 1.f, 1.f, 1.f } };
+
+				float skyY = SkyAnimation::START_Y;
+				float skyOpacity = SkyAnimation::START_OPACITY;
+				float skyTime = 0.0f;
+				float plasmaTime = 0.0f;
+				XrVector2f floorMarker = { 0.0f, 0.0f };
+
+				bool bTonemappingChanged = false;
+			}renderstate;
+
 			std::unique_ptr< CInput > pInput = nullptr;
 			SAction* pHapticAction = nullptr;
 
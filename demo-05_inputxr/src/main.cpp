@@ -75,23 +75,24 @@ int main( int argc, char *argv[] )
 	pInput->CreateActionSet( &actionsetMain, "main", "main actions" );
 
 	// (4.3) Create action(s) - these represent actions that will be triggered based on hardware state from the openxr runtime
+	//		  callbacks are added to the app's action dispatcher once the action sets are attached (4.7)
 
-	SAction actionHiltPose( XR_ACTION_TYPE_POSE_INPUT, std::bind( &App::ActionCallback_SetControllerActive, pApp.get(), fnArg::_1, fnArg::_2 ) );
+	SAction actionHiltPose( XR_ACTION_TYPE_POSE_INPUT, nullptr );
 	pInput->CreateAction( &actionHiltPose, &actionsetMain, "hilt_pose", "hilt pose", { "/user/hand/left", "/user/hand/right" } );
 	
-	SAction actionBladePose( XR_ACTION_TYPE_POSE_INPUT, std::bind( &App::ActionCallback_SetControllerActive, pApp.get(), fnArg::_1, fnArg::_2 ) );
+	SAction actionBladePose( XR_ACTION_TYPE_POSE_INPUT, nullptr );
 	pInput->CreateAction( &actionBladePose, &actionsetMain, "blade_pose", "blade pose", { "/user/hand/left", "/user/hand/right" } );
 
-	SAction actionScaleBlade( XR_ACTION_TYPE_FLOAT_INPUT, std::bind( &App::ActionCallback_ScaleBlade, pApp.get(), fnArg::_1, fnArg::_2 ) );
+	SAction actionScaleBlade( XR_ACTION_TYPE_FLOAT_INPUT, nullptr );
 	pInput->CreateAction( &actionScaleBlade, &actionsetMain, "scale_blade", "scale blade", { "/user/hand/left", "/user/hand/right" } );
 
-	SAction actionCycleRenderMode( XR_ACTION_TYPE_BOOLEAN_INPUT, std::bind( &App::ActionCallback_CycleRenderMode, pApp.get(), fnArg::_1, fnArg::_2 ) );
+	SAction actionCycleRenderMode( XR_ACTION_TYPE_BOOLEAN_INPUT, nullptr );
 	pInput->CreateAction( &actionCycleRenderMode, &actionsetMain, "cycle_render_mode", "Cycle render mode and tonemapping", { "/user/hand/left", "/user/hand/right" } );
 
-	SAction actionTogglePassthrough( XR_ACTION_TYPE_BOOLEAN_INPUT, std::bind( &App::ActionCallback_TogglePassthrough, pApp.get(), fnArg::_1, fnArg::_2 ) );
+	SAction actionTogglePassthrough( XR_ACTION_TYPE_BOOLEAN_INPUT, nullptr );
 	pInput->CreateAction( &actionTogglePassthrough, &actionsetMain, "toggle_passthrough", "Toggle passthrough", { "/user/hand/left", "/user/hand/right" } );
 
-	SAction actionHaptic( XR_ACTION_TYPE_VIBRATION_OUTPUT, std::bind( &App::ActionCallback_TogglePassthrough, pApp.get(), fnArg::_1, fnArg::_2 ) );
+	SAction actionHaptic( XR_ACTION_TYPE_VIBRATION_OUTPUT, nullptr );
 	pApp->pHapticAction = &actionHaptic;
 	pInput->CreateAction( pApp->pHapticAction, &actionsetMain, "haptic", "play haptics", { "/user/hand/left", "/user/hand/right" } );
 
@@ -153,7 +154,15 @@ int main( int argc, char *argv[] )
 	// (4.7) Add actionset(s) that will be active during input sync with the openxr runtime
 	//		  these are the action sets (and their actions) whose state will be checked in the successive frames.
 	//		  you can change this anytime (e.g. changing game mode to locomotion vs ui)
-	pInput->AddActionsetForSync( &actionsetMain ); //  optional sub path is a filter if made available with the action - e.g /user/hand/left
+	pApp->actionDispatcher.AddActionSet( &actionsetMain ); //  optional sub path is a filter if made available with the action - e.g /user/hand/left
+
+	// (4.7.1) Add action callbacks - these only fire when an action's state changes (poses: when they become active/inactive),
+	//		    blade scaling fires every sync while the trigger is active so the blade keeps growing while it's held
+	pApp->actionDispatcher.Add< &App::ActionCallback_SetControllerActive >( &actionHiltPose, pApp.get() );
+	pApp->actionDispatcher.Add< &App::ActionCallback_SetControllerActive >( &actionBladePose, pApp.get() );
+	pApp->actionDispatcher.Add< &App::ActionCallback_ScaleBlade >( &actionScaleBlade, pApp.get(), EActionDispatch::WhileActive );
+	pApp->actionDispatcher.Add< &App::ActionCallback_CycleRenderMode >( &actionCycleRenderMode, pApp.get() );
+	pApp->actionDispatcher.Add< &App::ActionCallback_TogglePassthrough >( &actionTogglePassthrough, pApp.get() );
 
 	// (4.8) Create action spaces for pose actions - this is the opportunity to tweak the base pose of the mesh for intended use
 	XrPosef poseSpace;
@@ -162,78 +171,39 @@ int main( int argc, char *argv[] )
 	pInput->CreateActionSpaces( &actionHiltPose, &poseSpace );
 	pInput->CreateActionSpaces( &actionBladePose, &poseSpace );
 
-	// assign the action space to models
-	pApp->assets.pHiltLeft->instances[ 0 ].space = actionHiltPose.vecActionSpaces[ 0 ];
-	pApp->assets.pButtonBottomLeft->instances[ 0 ].space = actionHiltPose.vecActionSpaces[ 0 ];
-	pApp->assets.pButtonTopLeft->instances[ 0 ].space = actionHiltPose.vecActionSpaces[ 0 ];
-	
-	pApp->assets.pHiltRight->instances[ 0 ].space = actionHiltPose.vecActionSpaces[ 1 ];
-	pApp->assets.pButtonBottomRight->instances[ 0 ].space = actionHiltPose.vecActionSpaces[ 1 ];
-	pApp->assets.pButtonTopRight->instances[ 0 ].space = actionHiltPose.vecActionSpaces[ 1 ];
-	
-	pApp->assets.pBladeLeft->instances[ 0 ].space = actionBladePose.vecActionSpaces[ 0 ];
-	pApp->assets.pBladeRight->instances[ 0 ].space = actionBladePose.vecActionSpaces[ 1 ];
-
-
-	// (5) Render loop
-	while ( pApp->GetSession()->GetState() != XR_SESSION_STATE_EXITING )
+	// assign the action space to models - late latched so handheld models are located as close to submission as possible
+	for ( uint32_t unHand = 0; unHand < 2; unHand++ )
 	{
-		// (5.1) Poll for xr events
-		XrEventDataBaseHeader xrEventDataBaseheader { XR_TYPE_EVENT_DATA_EVENTS_LOST };
-		if ( !XR_SUCCEEDED( pApp->GetSession()->Poll( &xrEventDataBaseheader ) ) )
-			continue;
-
-		// (5.2) Process xr events
-		pApp->ProcessXrEvents( xrEventDataBaseheader );
-
-		// (5.3) Get thread pool manager
-		CThreadPool *pThreadPool = pApp->pThreadPool.get();
-
-		// (5.4) Input Frame
-		pThreadPool->SubmitInputTask( [ pInput = pInput ]() { pInput->ProcessInput(); } ).get();
-		if ( pApp->assets.pBladeLeft->instances[ 0 ].scale.z > k_bladeScaleHapticThreshold )
-			pApp->ActionHaptic( &actionHaptic, 0 );
-		if ( pApp->assets.pBladeRight->instances[ 0 ].scale.z > k_bladeScaleHapticThreshold )
-			pApp->ActionHaptic( &actionHaptic, 1 );
-
-		// (5.5) Render frame
-		bool bFrameStarted = pThreadPool->SubmitRenderTask( [ pApp = pApp.get() ]() { return pApp->StartRenderFrame(); } ).get();
-
-		if ( bFrameStarted && pApp->pRenderInfo->state.frameState.shouldRender )
-		{
-			// Update sky animation
-			float displayRate = pApp->GetDisplayRate() ? 
-				pApp->GetDisplayRate()->GetCurrentRefreshRate( pApp->GetSession()->GetXrSession() ) : 72.0f;
-
-			pApp->skyanim.UpdateAnimation(
-				pApp->assets, 
-				pApp->pRenderInfo->state.frameState.predictedDisplayPeriod,
-				displayRate,
-				pApp->gamestate.skyMateriaDataId,
-				pApp->gamestate.vecMaterialData	);
-
-			auto now = std::chrono::high_resolution_clock::now();
-			auto duration = std::chrono::duration< float >( now.time_since_epoch() );
-			float timeInSeconds = duration.count();
-			pApp->gamestate.vecMaterialData[ pApp->gamestate.skyMateriaDataId ]->emissiveFactor[ 0 ] = timeInSeconds;
-
-			// Update player position for floor marker
-			XrVector3f hmdLocation = pApp->pRenderInfo->state.hmdPose.position;
-			pApp->gamestate.vecMaterialData[ pApp->gamestate.floorMateriaDataId ]->emissiveFactor[ 0 ] = hmdLocation.x;
-			pApp->gamestate.vecMaterialData[ pApp->gamestate.floorMateriaDataId ]->emissiveFactor[ 1 ] = hmdLocation.z;
-
-			// Update plasma blade effect
-			pApp->plasma.UpdateEffect( 
-				pApp->gamestate.vecMaterialData[ pApp->gamestate.leftBladeMateriaDataId ],
-				pApp->gamestate.vecMaterialData[ pApp->gamestate.rightBladeMateriaDataId ] );
-
-		}
-
-		// Submit EndRenderFrame to render thread and wait for it
-		pThreadPool->SubmitRenderTask( [ pApp = pApp.get() ]() { pApp->EndRenderFrame(); } ).get();
+		pApp->AddLateLatchSpace( pApp->assets.hilt[ unHand ].pRenderModel, pApp->assets.hilt[ unHand ].unInstance, actionHiltPose.vecActionSpaces[ unHand ] );
+		pApp->AddLateLatchSpace( pApp->assets.buttonBottom[ unHand ].pRenderModel, pApp->assets.buttonBottom[ unHand ].unInstance, actionHiltPose.vecActionSpaces[ unHand ] );
+		pApp->AddLateLatchSpace( pApp->assets.buttonTop[ unHand ].pRenderModel, pApp->assets.buttonTop[ unHand ].unInstance, actionHiltPose.vecActionSpaces[ unHand ] );
+		pApp->AddLateLatchSpace( pApp->assets.blade[ unHand ].pRenderModel, pApp->assets.blade[ unHand ].unInstance, actionBladePose.vecActionSpaces[ unHand ] );
 	}
 
-	// (6) Exit app - xrlib objects (instance, session, renderer, etc) handles proper cleanup once unique pointers goes out of scope.
+	// (5) Frame tasks - input and simulation write to the app's render state back buffer,
+	//     which is published to the renderables once the render thread is done with the previous frame
+	SFrameTasks frameTasks;
+	frameTasks.fnInput = [ pApp = pApp.get(), &actionHaptic ]()
+	{
+		pApp->actionDispatcher.Sync( pApp->GetSession()->GetXrSession() );
+
+		// Vibrate while a blade is extended past the threshold
+		pApp->ActionHapticSustain( &actionHaptic, 0, pApp->renderstate.bladeScale[ 0 ].z > k_bladeScaleHapticThreshold );
+		pApp->ActionHapticSustain( &actionHaptic, 1, pApp->renderstate.bladeScale[ 1 ].z > k_bladeScaleHapticThreshold );
+	};
+
+	frameTasks.fnSimulate = [ pApp = pApp.get() ]( const SFrameContext &context ) { pApp->Simulate( context ); };
+	frameTasks.fnPublish = [ pApp = pApp.get() ]() { pApp->PublishRenderState(); };
+
+	// (6) Render loop - input and simulation of the next frame overlap with the render thread submitting the current one
+	CFrameScheduler frameScheduler( pApp.get(), frameTasks );
+	frameScheduler.bEndUnstartedFrames = true;
+
+	while ( frameScheduler.Tick() ) {}
+
+	frameScheduler.Flush();
+
+	// (7) Exit app - xrlib objects (instance, session, renderer, etc) handles proper cleanup once unique pointers goes out of scope.
 	//				  Note that as they are in the same scope in this demo, order of destruction here is automatically enforced only when using C++20 and above
     #ifdef XR_USE_PLATFORM_ANDROID
         return xrlib::ExitApp( pAndroidApp );
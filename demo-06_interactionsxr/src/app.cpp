@@ -146,21 +146,19 @@ namespace app
                     return EXIT_FAILURE;
 					#endif
 
-			// (4.4) Add passthrough geometry (plane) to the layer
-			m_vecVertices.push_back( { -0.5f, 0.5f, 0.0f } );  // top left
-			m_vecVertices.push_back( { 0.5f, 0.5f, 0.0f } );   // top right
-			m_vecVertices.push_back( { 0.5f, -0.5f, 0.0f } );  // bottom right
-			m_vecVertices.push_back( { -0.5f, -0.5f, 0.0f } ); // bottom left
-			m_vecIndices = { 0, 1, 2, 2, 3, 0 };
-			XrResult result = GetPassthrough()->AddGeometry(
-				m_pXrSession->GetXrSession(),
-				GetPassthrough()->GetPassthroughLayers()->at(0).layer,
-				m_vecVertices,
-				m_vecIndices,
-				m_pXrSession->GetAppSpace(),
-				0,
-				k_windowPose
- 			);
+			// (4.4) Add passthrough geometry (plane) to the layer - the quad mesh is shared with any other quad windows
+			XrResult result = XR_ERROR_FEATURE_UNSUPPORTED;
+			if ( GetPassthroughGeometry() && GetPassthroughGeometry()->BIsValid() )
+			{
+				nWindowGeometry = GetPassthroughGeometry()->Add(
+					GetPassthrough()->GetPassthroughLayers()->at(0).layer,
+					EPassthroughShape::Quad,
+					m_pXrSession->GetAppSpace(),
+					k_windowPose
+				);
+
+				result = nWindowGeometry < 0 ? XR_ERROR_RUNTIME_FAILURE : XR_SUCCESS;
+			}
 
 			if( !XR_UNQUALIFIED_SUCCESS( result ) )
 			#ifdef XR_USE_PLATFORM_ANDROID
@@ -293,35 +291,28 @@ namespace app
 		assets.pSky->instances[ 0 ].pose.position.y = 100.f;
 		assets.pSky->instances[ 0 ].pose.orientation = { 1.0f, 0.0f, 0.0f, 0.0f };
 
-		// (3) Parallel load meshes using built-in thread pool manager
-		ParallelLoadMeshes( { 
-			{ .pRenderModel = assets.pSky, .sFilename = "plane.glb", .scale = { 5000.0f, 1.f, 5000.0f } },
-			{ .pRenderModel = assets.pFloor, .sFilename = "plane.glb", .scale = { 5.0f, 1.f, 5.0f } }
+		// (3) Async load meshes using built-in thread pool manager. The frame loop starts right away,
+		//     each mesh joins the render info's renderables (sky first, then floor) as soon as it's ready.
+		LoadMeshesAsync( {
+			{
+				.mesh = { .pRenderModel = assets.pSky, .sFilename = "plane.glb", .scale = { 5000.0f, 1.f, 5000.0f } },
+				.fnOnParsed = [ this ]( CRenderModel *pSky )
+				{
+					// (4) Load materials where we want dynamic updates to material variables
+					pSky->LoadMaterial( gamestate.vecMaterialData, pRenderInfo.get(), pipelines.pbrFragmentDescriptorLayout, pipelines.pbrFragmentDescriptorPool, pTextureManager.get() );
+					gamestate.skyMateriaDataId = gamestate.vecMaterialData.size() - 1;
+					gamestate.vecMaterialData[ gamestate.skyMateriaDataId ]->emissiveFactor[ 1 ] = 1.0f; // reset opacity value input for shader
+				}
+			},
+			{
+				.mesh = { .pRenderModel = assets.pFloor, .sFilename = "plane.glb", .scale = { 5.0f, 1.f, 5.0f } },
+				.fnOnParsed = [ this ]( CRenderModel *pFloor )
+				{
+					pFloor->LoadMaterial( gamestate.vecMaterialData, pRenderInfo.get(), pipelines.pbrFragmentDescriptorLayout, pipelines.pbrFragmentDescriptorPool, pTextureManager.get() );
+					gamestate.floorMateriaDataId = gamestate.vecMaterialData.size() - 1;
+				}
+			}
 		} );
-
-		// (4) Define and load materials for each mesh
-
-		// load materials for meshes where we want dynamic updates to maerial variables
-		assets.pSky->LoadMaterial( gamestate.vecMaterialData, pRenderInfo.get(), pipelines.pbrFragmentDescriptorLayout, pipelines.pbrFragmentDescriptorPool, pTextureManager.get() );
-		gamestate.skyMateriaDataId = gamestate.vecMaterialData.size() - 1;
-		gamestate.vecMaterialData[ gamestate.skyMateriaDataId ]->emissiveFactor[ 1 ] = 1.0f; // reset opacity value input for shader
-
-		assets.pFloor->LoadMaterial( gamestate.vecMaterialData, pRenderInfo.get(), pipelines.pbrFragmentDescriptorLayout, pipelines.pbrFragmentDescriptorPool, pTextureManager.get() );
-		gamestate.floorMateriaDataId = gamestate.vecMaterialData.size() - 1;
-
-		// (5) Init mesh buffers
-		assets.pSky->InitBuffers();
-		assets.pFloor->InitBuffers();
-
-		// (6) Add all meshes to render info for rendering (arranged sequentially as per desired depth draw)
-		pRenderInfo->vecRenderables.push_back( dynamic_cast< CRenderable * >( assets.pSky ) );
-		pRenderInfo->vecRenderables.push_back( dynamic_cast< CRenderable * >( assets.pFloor ) );
-	}
-
-	void App::ProcessXrEvents( XrEventDataBaseHeader &xrEventDataBaseheader ) 
-	{
-		ProcessEvents_SessionState( xrEventDataBaseheader );
-		ProcessEvents_Vismasks( xrEventDataBaseheader );
 	}
 
 	bool App::StartRenderFrame()
@@ -344,18 +335,13 @@ namespace app
 				pRenderInfo->state.clearValues[ 0 ].color = { { 0.0f, 0.0f, 0.0f, 1.0f } };
 			}
 
-			// Submit actual render work to render thread
-			return GetRender()->StartRenderFrame( pRenderInfo.get() );
+			// Submit actual render work to render thread, xrapp late latches registered poses
+			return XrApp::StartRenderFrame();
 		}
 
 		return false;
 	}
 
-	void App::EndRenderFrame() 
-	{ 
-		GetRender()->EndRenderFrame( mainRenderPass, pRenderInfo.get(), vecMasks ); 
-	}
-
 	void App::ActionCallback_SetControllerActive( SAction *pAction, uint32_t unActionStateIndex )
 	{
 		if ( unActionStateIndex == 0 )
@@ -380,31 +366,26 @@ namespace app
 			gamestate.rightGraspStrength = pAction->vecActionStates[ 1 ].stateFloat.currentState;
 	}
 
-	void App::ActionHaptic( SAction *pAction, uint32_t unActionStateIndex ) const
+	void App::ActionHaptic( SAction *pAction, uint32_t unActionStateIndex )
 	{
-		if ( !pInput )
-			return;
-
-		// Haptic params (these are also params of the GenerateHaptic() function
-		// adding here for visibility
-		uint64_t unDuration = XR_MIN_HAPTIC_DURATION;
-		float fAmplitude = 0.5f;
-		float fFrequency = XR_FREQUENCY_UNSPECIFIED;
+		// Queued and merged with other requests for the same hand, applied once per frame by the app's haptic scheduler
+		SHapticPulse pulse;
+		pulse.fAmplitude = 0.5f;
+		pulse.duration = XR_MIN_HAPTIC_DURATION;
+		pulse.fFrequency = XR_FREQUENCY_UNSPECIFIED;
 
-		// Check if the action has subpaths
-		if ( !pAction->vecSubactionpaths.empty() )
-		{
-			pInput->GenerateHaptic( pAction->xrActionHandle, pAction->vecSubactionpaths[ unActionStateIndex ], unDuration, fAmplitude, fFrequency );
-		}
-		else
-		{
-			pInput->GenerateHaptic( pAction->xrActionHandle, XR_NULL_PATH, unDuration, fAmplitude, fFrequency );
-		}
+		haptics.Request( pAction->xrActionHandle, pAction->vecSubactionpaths.empty() ? XR_NULL_PATH : pAction->vecSubactionpaths[ unActionStateIndex ], pulse );
 	}
 
-	void App::ActionCallback_NoAction( SAction *pAction, uint32_t unActionStateIndex )
+	void App::ActionHapticSustain( SAction *pAction, uint32_t unActionStateIndex, bool bSustain )
 	{
-		// Placeholder for no action callback (i.e. no action is triggered)
+		// One long vibration renewed only when it's about to run out, rather than a pulse each frame
+		XrPath subactionPath = pAction->vecSubactionpaths.empty() ? XR_NULL_PATH : pAction->vecSubactionpaths[ unActionStateIndex ];
+
+		if ( bSustain )
+			haptics.Sustain( pAction->xrActionHandle, subactionPath, 0.5f );
+		else
+			haptics.Release( pAction->xrActionHandle, subactionPath );
 	}
 
 } // namespace app
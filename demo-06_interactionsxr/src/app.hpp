@@ -10,6 +10,7 @@
 #include <chrono>
 
 #include <xrapp.hpp>
+#include <frame_scheduler.hpp>
 
 #include <xrlib/ext/EXT/hand_interaction.hpp>
 #include <xrlib/ext/EXT/hand_joints_motion_range.hpp>
@@ -47,20 +48,17 @@ namespace app
 			int Init();
 		#endif
 
-			~App();
+			~App() override;
 
 			void SetupScene();
-			void ProcessXrEvents( XrEventDataBaseHeader &xrEventDataBaseheader );
+			bool StartRenderFrame() override;
 
-			bool StartRenderFrame();
-			void EndRenderFrame();
-
-			void ActionCallback_NoAction( SAction *pAction, uint32_t unActionStateIndex );
 			void ActionCallback_SetControllerActive( SAction *pAction, uint32_t unActionStateIndex );
 			void ActionCallback_Pinch( SAction *pAction, uint32_t unActionStateIndex );
 			void ActionCallback_Grasp( SAction *pAction, uint32_t unActionStateIndex );
 
-			void ActionHaptic( SAction *pAction, uint32_t unActionStateIndex ) const;
+			void ActionHaptic( SAction *pAction, uint32_t unActionStateIndex );
+			void ActionHapticSustain( SAction *pAction, uint32_t unActionStateIndex, bool bSustain );
 
 			struct SAssets
 			{
@@ -97,13 +95,12 @@ namespace app
 			std::unique_ptr< CInput > pInput = nullptr;
 			SAction* pHapticAction = nullptr;
 
+			// Passthrough window (quad) in the app's passthrough geometry, -1 if passthrough isn't available
+			int32_t nWindowGeometry = -1;
+
 	  private:
 			void CreateGraphicsPipelines();
 
-			// Plane facing user for passthrough mesh projection
-			std::vector< XrVector3f > m_vecVertices;
-			std::vector< uint32_t > m_vecIndices;
-
 			std::unique_ptr < EXT::CHandJointsMotionRange > m_pHandsJointsMotionRange = nullptr;
 			std::unique_ptr < META::CHandsAndControllers > m_pHandsAndControllers = nullptr;
 
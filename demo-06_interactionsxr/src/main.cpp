@@ -139,23 +139,24 @@ int main( int argc, char *argv[] )
 	pApp->pInput->CreateActionSet( &actionsetMain, "main", "main actions" );
 
 	// (4.3) Create action(s) - these represent actions that will be triggered based on hardware state from the openxr runtime
+	//		  callbacks are added to the app's action dispatcher once the action sets are attached (4.7)
 
-	SAction actionControllerPose( XR_ACTION_TYPE_POSE_INPUT, std::bind( &App::ActionCallback_SetControllerActive, pApp.get(), fnArg::_1, fnArg::_2 ) );
+	SAction actionControllerPose( XR_ACTION_TYPE_POSE_INPUT, nullptr );
 	pApp->pInput->CreateAction( &actionControllerPose, &actionsetMain, "controller_pose", "controller pose", { "/user/hand/left", "/user/hand/right" } );
 
-	SAction actionPinchPose( XR_ACTION_TYPE_POSE_INPUT, std::bind( &App::ActionCallback_NoAction, pApp.get(), fnArg::_1, fnArg::_2 ) );
+	SAction actionPinchPose( XR_ACTION_TYPE_POSE_INPUT, nullptr );
 	pApp->pInput->CreateAction( &actionPinchPose, &actionsetMain, "pinch_pose", "pinch pose", { "/user/hand/left", "/user/hand/right" } );
 
-	SAction actionWindowPose( XR_ACTION_TYPE_POSE_INPUT, std::bind( &App::ActionCallback_NoAction, pApp.get(), fnArg::_1, fnArg::_2 ) );
+	SAction actionWindowPose( XR_ACTION_TYPE_POSE_INPUT, nullptr );
 	pApp->pInput->CreateAction( &actionWindowPose, &actionsetMain, "window_pose", "window pose" );
 
-	SAction actionPinch( XR_ACTION_TYPE_FLOAT_INPUT, std::bind( &App::ActionCallback_Pinch, pApp.get(), fnArg::_1, fnArg::_2 ) );
+	SAction actionPinch( XR_ACTION_TYPE_FLOAT_INPUT, nullptr );
 	pApp->pInput->CreateAction( &actionPinch, &actionsetMain, "pinch", "pinch strength", { "/user/hand/left", "/user/hand/right" } );
 
-	SAction actionGrasp( XR_ACTION_TYPE_FLOAT_INPUT, std::bind( &App::ActionCallback_Grasp, pApp.get(), fnArg::_1, fnArg::_2 ) );
+	SAction actionGrasp( XR_ACTION_TYPE_FLOAT_INPUT, nullptr );
 	pApp->pInput->CreateAction( &actionGrasp, &actionsetMain, "grasp", "grasp strength", { "/user/hand/left", "/user/hand/right" } );
 
-	SAction actionHaptic( XR_ACTION_TYPE_VIBRATION_OUTPUT, std::bind( &App::ActionCallback_NoAction, pApp.get(), fnArg::_1, fnArg::_2 ) );
+	SAction actionHaptic( XR_ACTION_TYPE_VIBRATION_OUTPUT, nullptr );
 	pApp->pHapticAction = &actionHaptic;
 	pApp->pInput->CreateAction( pApp->pHapticAction, &actionsetMain, "haptic", "play haptics", { "/user/hand/left", "/user/hand/right" } );
 
@@ -216,7 +217,13 @@ int main( int argc, char *argv[] )
 	// (4.7) Add actionset(s) that will be active during input sync with the openxr runtime
 	//		  these are the action sets (and their actions) whose state will be checked in the successive frames.
 	//		  you can change this anytime (e.g. changing game mode to locomotion vs ui)
-	pApp->pInput->AddActionsetForSync( &actionsetMain ); //  optional sub path is a filter if made available with the action - e.g /user/hand/left
+	pApp->actionDispatcher.AddActionSet( &actionsetMain ); //  optional sub path is a filter if made available with the action - e.g /user/hand/left
+
+	// (4.7.1) Add action callbacks - these only fire when an action's state changes (poses: when they become active/inactive).
+	//		    Pinch and window poses are only used through their action spaces, so they need no callbacks.
+	pApp->actionDispatcher.Add< &App::ActionCallback_SetControllerActive >( &actionControllerPose, pApp.get() );
+	pApp->actionDispatcher.Add< &App::ActionCallback_Pinch >( &actionPinch, pApp.get() );
+	pApp->actionDispatcher.Add< &App::ActionCallback_Grasp >( &actionGrasp, pApp.get() );
 
 	// (4.8) Create action spaces for pose actions - this is the opportunity to tweak the base pose of the mesh for intended use
 	XrPosef poseSpace;
@@ -225,135 +232,124 @@ int main( int argc, char *argv[] )
 	pApp->pInput->CreateActionSpaces( &actionControllerPose, &poseSpace );
 	pApp->pInput->CreateActionSpaces( &actionPinchPose, &poseSpace );
 
-	// assign the action space to models
-	debugControllerIndicator->instances[ 0 ].space = actionControllerPose.vecActionSpaces[ 0 ];
-	debugPinchIndicator->instances[ 0 ].space = actionPinchPose.vecActionSpaces[ 0 ];
+	// assign the action space to models - late latched so they're located as close to submission as possible
+	pApp->AddLateLatchSpace( debugControllerIndicator, 0, actionControllerPose.vecActionSpaces[ 0 ] );
+	pApp->AddLateLatchSpace( debugPinchIndicator, 0, actionPinchPose.vecActionSpaces[ 0 ] );
 
-	debugControllerIndicator->instances[ 1 ].space = actionControllerPose.vecActionSpaces[ 1 ];
-	debugPinchIndicator->instances[ 1 ].space = actionPinchPose.vecActionSpaces[ 1 ];
+	pApp->AddLateLatchSpace( debugControllerIndicator, 1, actionControllerPose.vecActionSpaces[ 1 ] );
+	pApp->AddLateLatchSpace( debugPinchIndicator, 1, actionPinchPose.vecActionSpaces[ 1 ] );
 
-	// (5) Game loop
-	while ( pApp->GetSession()->GetState() != XR_SESSION_STATE_EXITING )
+	// (5) Render state back buffer - written by the input and simulation stages while the render thread
+	//     submits the previous frame, then copied to the debug renderables once the render thread is idle
+	struct SRenderState
 	{
-		// (5.1) Poll for xr events
-		XrEventDataBaseHeader xrEventDataBaseheader { XR_TYPE_EVENT_DATA_EVENTS_LOST };
-		if ( !XR_SUCCEEDED( pApp->GetSession()->Poll( &xrEventDataBaseheader ) ) )
-			continue;
+		bool bControllerActive[ 2 ];	// hand joints conform to a held controller
+
+		XrVector3f controllerScale[ 2 ];
+		XrVector3f pinchScale[ 2 ];
+		XrVector3f windowScale;
+	} renderstate {}, latchstate {};
+
+	// (5.1) Late latched hand joints - located on the render thread at the predicted display time of the frame being submitted,
+	//       just before it's recorded, and written straight to the debug indicators. Left hand joints first, followed by the right.
+	//       Reads latchstate, the render thread's copy of the render state made at publish.
+	SJointBuffer jointBuffer;
+	pApp->AddLateLatch(
+		[ pApp = pApp.get(), &jointLocations, &jointBuffer, &latchstate, debugIndicator ]( XrTime predictedDisplayTime )
+		{
+			if ( !pApp->GetHandTracking() || !( pApp->pRenderInfo->state.sharedEyeState.viewStateFlags & XR_VIEW_STATE_ORIENTATION_VALID_BIT ) )
+				return;
+
+			// Check for joints motion range support
+			if ( pApp->GetHandsJointsMotionRange() )
+			{
+				XrHandJointsMotionRangeInfoEXT motionRangeInfoLeft = latchstate.bControllerActive[ 0 ] ? EXT::CHandJointsMotionRange::GetHandJointsMotionRangeInfo( XR_HAND_JOINTS_MOTION_RANGE_CONFORMING_TO_CONTROLLER_EXT ) :
+																										EXT::CHandJointsMotionRange::GetHandJointsMotionRangeInfo( XR_HAND_JOINTS_MOTION_RANGE_UNOBSTRUCTED_EXT );
 
-		// (5.2) Process xr events
-		pApp->ProcessXrEvents( xrEventDataBaseheader );
+				XrHandJointsMotionRangeInfoEXT motionRangeInfoRight = latchstate.bControllerActive[ 1 ] ? EXT::CHandJointsMotionRange::GetHandJointsMotionRangeInfo( XR_HAND_JOINTS_MOTION_RANGE_CONFORMING_TO_CONTROLLER_EXT ) :
+																										 EXT::CHandJointsMotionRange::GetHandJointsMotionRangeInfo( XR_HAND_JOINTS_MOTION_RANGE_UNOBSTRUCTED_EXT );
+				// Locate hand joints with motion range
+				pApp->GetHandTracking()->LocateHandJoints( &jointLocations, pApp->GetSession()->GetAppSpace(), predictedDisplayTime, &motionRangeInfoLeft, &motionRangeInfoRight );
+			}
+			else
+			{
+				// Locate hand joints
+				pApp->GetHandTracking()->LocateHandJoints( &jointLocations, pApp->GetSession()->GetAppSpace(), predictedDisplayTime );
+			}
+
+			// Record or replay the joints (see --record-input/--replay-input)
+			pApp->inputCapture.Capture( ECaptureStream::HandJoints, &jointLocations.leftJointLocations[ 0 ], XR_HAND_JOINT_COUNT_EXT );
+			pApp->inputCapture.Capture( ECaptureStream::HandJoints, &jointLocations.rightJointLocations[ 0 ], XR_HAND_JOINT_COUNT_EXT );
+
+			// Copy both hands to the joint buffer and validate them in a single pass
+			jointBuffer.Clear();
+			jointBuffer.Append( &jointLocations.leftJointLocations[ 0 ], XR_HAND_JOINT_COUNT_EXT );
+			jointBuffer.Append( &jointLocations.rightJointLocations[ 0 ], XR_HAND_JOINT_COUNT_EXT );
+			UpdateJoints( jointBuffer );
+
+			ForEachValidJoint( jointBuffer,
+				[ debugIndicator ]( uint32_t i, const XrPosef &pose, float radius )
+				{
+					debugIndicator->instances[ i ].pose = pose;
+					debugIndicator->ResetScale( radius, i );
+				} );
+		} );
+
+	SFrameTasks frameTasks;
+	frameTasks.fnInput = [ pApp = pApp.get(), &actionHaptic, &renderstate, controllerScale, pinchScale, zeroScale, idScale ]()
+	{
+		pApp->actionDispatcher.Sync( pApp->GetSession()->GetXrSession() );
 
-		// (5.4) Input Frame
-		pApp->pThreadPool->SubmitInputTask( [ pInput = pApp->pInput.get() ]() { pInput->ProcessInput(); } ).get();
+		renderstate.bControllerActive[ 0 ] = pApp->gamestate.bLeftControllerActive;
+		renderstate.bControllerActive[ 1 ] = pApp->gamestate.bRightControllerActive;
 
 		// Hide/Show controller indicators
-		debugControllerIndicator->instances[ 0 ].scale = pApp->gamestate.bLeftControllerActive ? controllerScale : zeroScale;
-		debugControllerIndicator->instances[ 1 ].scale = pApp->gamestate.bRightControllerActive ? controllerScale : zeroScale;
+		renderstate.controllerScale[ 0 ] = pApp->gamestate.bLeftControllerActive ? controllerScale : zeroScale;
+		renderstate.controllerScale[ 1 ] = pApp->gamestate.bRightControllerActive ? controllerScale : zeroScale;
 
 		// Hide/Show pinch indicators
-		XrVector3f_Scale( &debugPinchIndicator->instances[ 0 ].scale, &pinchScale, pApp->gamestate.leftPinchStrength );
-		XrVector3f_Scale( &debugPinchIndicator->instances[ 1 ].scale, &pinchScale, pApp->gamestate.rightPinchStrength );
+		XrVector3f_Scale( &renderstate.pinchScale[ 0 ], &pinchScale, pApp->gamestate.leftPinchStrength );
+		XrVector3f_Scale( &renderstate.pinchScale[ 1 ], &pinchScale, pApp->gamestate.rightPinchStrength );
 
 		// Hide/Show window
 		float graspStrength = pApp->gamestate.leftGraspStrength + pApp->gamestate.rightGraspStrength;
-		if( pApp->GetPassthrough() && !pApp->GetPassthrough()->GetGeometryInstances()->empty() )
-		{
-			XrVector3f newScale = zeroScale;
-			XrVector3f_Scale( &newScale, &idScale, graspStrength );
-
-			pApp->GetPassthrough()->UpdateGeometry(
-				pApp->GetPassthrough()->GetGeometryInstances()->at(0),
-				pApp->GetSession()->GetAppSpace(),
-				pApp->pRenderInfo->state.frameState.predictedDisplayTime,
-				k_windowPose,
-				newScale
-				);
-		}
-		else
-		{
-			XrVector3f_Scale( &debugWindow->instances[ 0 ].scale, &idScale, graspStrength );
-		}
+		XrVector3f_Scale( &renderstate.windowScale, &idScale, graspStrength );
 
+		// Apply haptics while the window is grasped
+		pApp->ActionHapticSustain( &actionHaptic, 0, graspStrength > 1.f );
+		pApp->ActionHapticSustain( &actionHaptic, 1, graspStrength > 1.f );
+	};
 
-		// Apply haptics
-		if ( graspStrength > 1.f )
-		{
-			pApp->ActionHaptic( &actionHaptic, 0 );
-			pApp->ActionHaptic( &actionHaptic, 1 );
-		}
+	frameTasks.fnSimulate = [ pApp = pApp.get(), &renderstate ]( const SFrameContext &context )
+	{
+		// Passthrough window is a compositor object, place it for the frame being simulated - only reaches the runtime when the grasp changes its scale
+		if ( pApp->nWindowGeometry >= 0 )
+			pApp->GetPassthroughGeometry()->Update( pApp->nWindowGeometry, context.simulationTime, k_windowPose, renderstate.windowScale );
+	};
 
+	frameTasks.fnPublish = [ pApp = pApp.get(), &renderstate, &latchstate, debugControllerIndicator, debugPinchIndicator, debugWindow ]()
+	{
+		// Render thread's copy for the late latch
+		latchstate = renderstate;
 
-		// (5.5) Render frame
-		bool bFrameStarted = pApp->pThreadPool->SubmitRenderTask( [ pApp = pApp.get() ]() { return pApp->StartRenderFrame(); } ).get();
+		debugControllerIndicator->instances[ 0 ].scale = renderstate.controllerScale[ 0 ];
+		debugControllerIndicator->instances[ 1 ].scale = renderstate.controllerScale[ 1 ];
 
-		if ( bFrameStarted )
-		{
-			// Check conditions before submitting to thread pool
-			if ( pApp->GetHandTracking() &&
-				 pApp->pRenderInfo->state.frameState.shouldRender &&
-				 ( pApp->pRenderInfo->state.sharedEyeState.viewStateFlags & XR_VIEW_STATE_ORIENTATION_VALID_BIT )
-			)
-			{
-				// Check for joints motion range support
-				if ( pApp->GetHandsJointsMotionRange() )
-				{
-					XrHandJointsMotionRangeInfoEXT motionRangeInfoLeft = pApp->gamestate.bLeftControllerActive ? EXT::CHandJointsMotionRange::GetHandJointsMotionRangeInfo( XR_HAND_JOINTS_MOTION_RANGE_CONFORMING_TO_CONTROLLER_EXT ) :
-																									   EXT::CHandJointsMotionRange::GetHandJointsMotionRangeInfo( XR_HAND_JOINTS_MOTION_RANGE_UNOBSTRUCTED_EXT );
-
-					XrHandJointsMotionRangeInfoEXT motionRangeInfoRight = pApp->gamestate.bRightControllerActive ? EXT::CHandJointsMotionRange::GetHandJointsMotionRangeInfo( XR_HAND_JOINTS_MOTION_RANGE_CONFORMING_TO_CONTROLLER_EXT ) :
-																									     EXT::CHandJointsMotionRange::GetHandJointsMotionRangeInfo( XR_HAND_JOINTS_MOTION_RANGE_UNOBSTRUCTED_EXT );
-					// Locate hand joints with motion range
-					pApp->GetHandTracking()->LocateHandJoints( &jointLocations, pApp->GetSession()->GetAppSpace(), pApp->pRenderInfo->state.frameState.predictedDisplayTime, &motionRangeInfoLeft, &motionRangeInfoRight );
-				}
-				else
-				{
-					// Locate hand joints (can be done before waiting for the updates)
-					pApp->GetHandTracking()->LocateHandJoints( &jointLocations, pApp->GetSession()->GetAppSpace(), pApp->pRenderInfo->state.frameState.predictedDisplayTime );
-				}
-
-				// Submit task for left hand joints
-				auto leftHandUpdateFuture = pApp->pThreadPool->SubmitTask(
-					[ pApp = pApp.get(), pHandtracking = pApp->GetHandTracking(), &debugIndicator, &jointLocations ]()
-					{
-						// Process left hand joints
-						for ( size_t i = 0; i < XR_HAND_JOINT_COUNT_EXT; i++ )
-						{
-							if ( jointLocations.leftJointLocations[ i ].locationFlags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT )
-							{
-								debugIndicator->instances[ i ].pose = jointLocations.leftJointLocations[ i ].pose;
-								debugIndicator->ResetScale( jointLocations.leftJointLocations[ i ].radius, i );
-							}
-						}
-					} );
-
-				// Submit task for right hand joints
-				auto rightHandUpdateFuture = pApp->pThreadPool->SubmitTask(
-					[ pApp = pApp.get(), pHandtracking = pApp->GetHandTracking(), &debugIndicator, &jointLocations ]()
-					{
-						// Process right hand joints
-						for ( size_t i = 0; i < XR_HAND_JOINT_COUNT_EXT; i++ )
-						{
-							if ( jointLocations.rightJointLocations[ i ].locationFlags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT )
-							{
-								// Offset by XR_HAND_JOINT_COUNT_EXT to store right hand instances after left hand
-								size_t rightHandIndex = i + XR_HAND_JOINT_COUNT_EXT;
-								debugIndicator->instances[ rightHandIndex ].pose = jointLocations.rightJointLocations[ i ].pose;
-								debugIndicator->ResetScale( jointLocations.rightJointLocations[ i ].radius, rightHandIndex );
-							}
-						}
-					} );
-
-				// Wait for both hand updates to complete
-				leftHandUpdateFuture.wait();
-				rightHandUpdateFuture.wait();
-			}
+		debugPinchIndicator->instances[ 0 ].scale = renderstate.pinchScale[ 0 ];
+		debugPinchIndicator->instances[ 1 ].scale = renderstate.pinchScale[ 1 ];
 
-			// Submit EndRenderFrame to render thread and wait for it
-			pApp->pThreadPool->SubmitRenderTask( [ pApp = pApp.get() ]() { pApp->EndRenderFrame(); } ).get();
-		}
-	}
+		// Window is only drawn by the app when it isn't projected by passthrough
+		if ( pApp->nWindowGeometry < 0 )
+			debugWindow->instances[ 0 ].scale = renderstate.windowScale;
+	};
+
+	// (6) Game loop - input and simulation of the next frame overlap with the render thread submitting the current one
+	CFrameScheduler frameScheduler( pApp.get(), frameTasks );
+	while ( frameScheduler.Tick() ) {}
+
+	frameScheduler.Flush();
 
-	// (6) Exit app - xrlib objects (instance, session, renderer, etc) handles proper cleanup once unique pointers goes out of scope.
+	// (7) Exit app - xrlib objects (instance, session, renderer, etc) handles proper cleanup once unique pointers goes out of scope.
 	//				  Note that as they are in the same scope in this demo, order of destruction here is automatically enforced only when using C++20 and above
     #ifdef XR_USE_PLATFORM_ANDROID
         return xrlib::ExitApp( pAndroidApp );
@@ -0,0 +1,313 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+
+#include <app.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace app
+{
+	App::App( int argc, char *argv[], const std::string &sAppName, const XrVersion32 unAppVersion, const ELogLevel eMinLogLevel )
+		: XrApp( argc, argv, sAppName, unAppVersion, eMinLogLevel )
+	{
+		ParseOptions( argc, argv );
+	}
+
+	App::~App()
+	{
+	}
+
+	void App::ParseOptions( int argc, char *argv[] )
+	{
+		for ( int i = 1; i < argc; i++ )
+		{
+			const bool bHasValue = ( i + 1 ) < argc;
+
+			if ( std::strcmp( argv[ i ], "--frames" ) == 0 && bHasValue )
+				options.unFrames = static_cast< uint32_t >( std::strtoul( argv[ ++i ], nullptr, 10 ) );
+			else if ( std::strcmp( argv[ i ], "--warmup" ) == 0 && bHasValue )
+				options.unWarmupFrames = static_cast< uint32_t >( std::strtoul( argv[ ++i ], nullptr, 10 ) );
+			else if ( std::strcmp( argv[ i ], "--cubes" ) == 0 && bHasValue )
+				options.unCubes = std::max( 1u, static_cast< uint32_t >( std::strtoul( argv[ ++i ], nullptr, 10 ) ) );
+			else if ( std::strcmp( argv[ i ], "--materials" ) == 0 && bHasValue )
+				options.unMaterials = static_cast< uint32_t >( std::strtoul( argv[ ++i ], nullptr, 10 ) );
+			else if ( std::strcmp( argv[ i ], "--dynamic-materials" ) == 0 && bHasValue )
+				options.unDynamicMaterials = static_cast< uint32_t >( std::strtoul( argv[ ++i ], nullptr, 10 ) );
+			else if ( std::strcmp( argv[ i ], "--csv" ) == 0 && bHasValue )
+				options.sCsvPath = argv[ ++i ];
+			else if ( std::strcmp( argv[ i ], "--budget-ms" ) == 0 && bHasValue )
+				options.dBudgetMs = std::strtod( argv[ ++i ], nullptr );
+			else if ( std::strcmp( argv[ i ], "--serial" ) == 0 )
+				options.bSerial = true;
+			else if ( ( std::strcmp( argv[ i ], "--record-input" ) == 0 || std::strcmp( argv[ i ], "--replay-input" ) == 0 ) && bHasValue )
+				i++;	// handled by xrapp
+			else
+				std::cerr << "Unknown or incomplete argument ignored: " << argv[ i ] << "\n";
+		}
+
+		options.unFrames = std::max( 1u, options.unFrames );
+		options.unDynamicMaterials = std::min( options.unDynamicMaterials, options.unMaterials );
+	}
+
+	int App::Init()
+	{
+		XrResult xrResult = XR_SUCCESS;
+
+		// (1) Define api layers and extensions - same set the demos use, unsupported ones are filtered out by xrapp
+		std::vector< const char * > vecAPILayers;
+		std::vector< const char * > vecRequiredExtensions = {
+			XR_KHR_VULKAN_ENABLE_EXTENSION_NAME,
+			XR_KHR_VISIBILITY_MASK_EXTENSION_NAME,
+			XR_EXT_HAND_TRACKING_EXTENSION_NAME,
+			XR_FB_DISPLAY_REFRESH_RATE_EXTENSION_NAME };
+
+		// (2) Initialize openxr instance
+		Time( "InitInstance", [ & ]() { xrResult = InitInstance( vecRequiredExtensions, vecAPILayers ); } );
+		if ( !XR_UNQUALIFIED_SUCCESS( xrResult ) )
+			return EXIT_FAILURE;
+
+		// (3) Initialize openxr session
+		SSessionSettings defaultSessionSettings;
+		Time( "InitSession", [ & ]() { xrResult = InitSession( defaultSessionSettings ); } );
+		if ( !XR_UNQUALIFIED_SUCCESS( xrResult ) )
+			return EXIT_FAILURE;
+
+		// (4) Initialize renderer
+		Time( "InitRender", [ & ]() { xrResult = InitRender( { VK_FORMAT_R8G8B8A8_UNORM, VK_FORMAT_R8G8B8A8_SRGB }, { VK_FORMAT_D24_UNORM_S8_UINT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D32_SFLOAT } ); } );
+		if ( !XR_UNQUALIFIED_SUCCESS( xrResult ) )
+			return EXIT_FAILURE;
+
+		// (5) Create render pass
+		Time( "CreateMainRenderPass", [ & ]() { xrResult = CreateMainRenderPass(); } );
+		if ( !XR_UNQUALIFIED_SUCCESS( xrResult ) )
+			return EXIT_FAILURE;
+
+		// (6) Create graphics pipelines
+		Time( "CreateGraphicsPipelines", [ & ]() { CreateGraphicsPipelines(); } );
+
+		// (7) Create vis masks
+		Time( "CreateVismasks", [ & ]() { CreateVismasks(); } );
+
+		return EXIT_SUCCESS;
+	}
+
+	void App::SetupScene()
+	{
+		Time( "SetupScene", [ & ]()
+		{
+			XrVector3f scale { 0.05f, 0.05f, 0.05f };
+
+			m_pCubes = new CColoredCube( GetSession(), pRenderInfo.get(), pipelines.primitiveLayout, pipelines.primitives, std::numeric_limits< uint32_t >::max(), true, 0.5f, scale );
+			if ( options.unCubes > 1 )
+				m_pCubes->AddInstance( options.unCubes - 1, scale );
+
+			// Lay the cubes out on a grid in front of the user
+			const uint32_t unColumns = static_cast< uint32_t >( std::ceil( std::sqrt( static_cast< float >( options.unCubes ) ) ) );
+			for ( uint32_t i = 0; i < options.unCubes; i++ )
+			{
+				const float fX = ( static_cast< float >( i % unColumns ) - static_cast< float >( unColumns ) * 0.5f ) * 0.12f;
+				const float fZ = -0.5f - static_cast< float >( i / unColumns ) * 0.12f;
+				m_pCubes->instances[ i ].pose = { { 0.f, 0.f, 0.f, 1.f }, { fX, 1.2f, fZ } };
+			}
+
+			m_pCubes->InitBuffers();
+			pRenderInfo->AddNewRenderable( dynamic_cast< CRenderable * >( m_pCubes ) );
+
+			m_vecCubeOrientations.resize( options.unCubes, { 0.f, 0.f, 0.f, 1.f } );
+
+			// Materials live in one block like a shared ubo, so flushed ranges of neighbours merge
+			m_vecMaterials.resize( options.unMaterials );
+			for ( auto &material : m_vecMaterials )
+				materialStore.Add( &material );
+		} );
+	}
+
+	void App::CreateGraphicsPipelines()
+	{
+		// Vismask
+		if ( m_pVisMask )
+			CreatePipeline_VisMask( defaultShaders.vismaskVertexShaders, defaultShaders.vismaskFragmentShaders );
+
+		// Primitives
+		pipelines.primitiveLayout = pRenderInfo->AddNewLayout();
+
+		pipelines.primitives = pRenderInfo->AddNewPipeline();
+		CreatePipeline_Primitives( pipelines.primitiveLayout, pipelines.primitives, defaultShaders.primitivesVertexShader, defaultShaders.primitivesFragmentShader );
+	}
+
+	void App::Simulate( XrTime predictedDisplayTime )
+	{
+		// Spin every cube around its up axis, phase shifted per instance so no two poses are identical
+		const double dSeconds = std::fmod( static_cast< double >( predictedDisplayTime ) * 1e-9, 3600.0 );
+		for ( uint32_t i = 0; i < options.unCubes; i++ )
+		{
+			const float fHalfAngle = static_cast< float >( dSeconds + i * 0.05 ) * 0.5f;
+			m_vecCubeOrientations[ i ] = { 0.f, std::sin( fHalfAngle ), 0.f, std::cos( fHalfAngle ) };
+		}
+
+		// Animate a few materials, the rest stay static and shouldn't cost anything once flushed
+		for ( uint32_t i = 0; i < options.unDynamicMaterials; i++ )
+			materialStore.Set( i, materialStore.Get( i ).emissiveFactor[ 0 ], static_cast< float >( dSeconds ) );
+	}
+
+	void App::Publish()
+	{
+		for ( uint32_t i = 0; i < options.unCubes; i++ )
+			m_pCubes->instances[ i ].pose.orientation = m_vecCubeOrientations[ i ];
+	}
+
+	int App::Run()
+	{
+		const uint64_t unTargetFrames = static_cast< uint64_t >( options.unWarmupFrames ) + options.unFrames;
+		uint64_t unFrameCount = 0;
+		bool bExitRequested = false;
+
+		m_vecSamples.reserve( options.unFrames );
+
+		// (1) Frame loop - same scheduler as the demos, minus the input
+		SFrameTasks frameTasks;
+		frameTasks.fnSimulate = [ this ]( const SFrameContext &context ) { Simulate( context.simulationTime ); };
+		frameTasks.fnPublish = [ this ]() { Publish(); };
+
+		CFrameScheduler frameScheduler( this, frameTasks, !options.bSerial );
+
+		while ( frameScheduler.Tick() )
+		{
+			const SFrameTimings &timings = frameScheduler.GetTimings();
+			if ( bExitRequested || !timings.bFrameStarted )
+				continue;
+
+			// (1.1) Record, skipping warmup frames. Main thread time blocked on the render thread counts as end.
+			SFrameSample sample;
+			sample.dEvents = timings.dEvents;
+			sample.dStartFrame = timings.dStartFrame;
+			sample.dSimulate = timings.dInput + timings.dSimulate + timings.dPublish;
+			sample.dEndFrame = timings.dRenderWait;
+			sample.dTotal = timings.dTotal;
+			sample.unMaterialsFlushed = timings.unMaterialsFlushed;
+
+			if ( ++unFrameCount > options.unWarmupFrames )
+				m_vecSamples.push_back( sample );
+
+			// (1.2) Ask the runtime to wind the session down once we have enough samples
+			if ( unFrameCount >= unTargetFrames )
+			{
+				xrRequestExitSession( GetSession()->GetXrSession() );
+				bExitRequested = true;
+			}
+		}
+
+		frameScheduler.Flush();
+
+		return Report();
+	}
+
+	int App::Report()
+	{
+		auto Percentile = []( std::vector< double > vecSorted, double dPercentile )
+		{
+			if ( vecSorted.empty() )
+				return 0.0;
+
+			size_t unIndex = static_cast< size_t >( std::ceil( dPercentile * static_cast< double >( vecSorted.size() ) ) );
+			return vecSorted[ std::clamp< size_t >( unIndex, 1, vecSorted.size() ) - 1 ];
+		};
+
+		auto PrintStats = [ & ]( const char *pccName, double SFrameSample::*pField )
+		{
+			std::vector< double > vecValues;
+			vecValues.reserve( m_vecSamples.size() );
+			double dSum = 0.0;
+
+			for ( auto &sample : m_vecSamples )
+			{
+				vecValues.push_back( sample.*pField );
+				dSum += sample.*pField;
+			}
+
+			std::sort( vecValues.begin(), vecValues.end() );
+			const double dAvg = vecValues.empty() ? 0.0 : dSum / static_cast< double >( vecValues.size() );
+
+			std::printf( "  %-12s min %8.3f | avg %8.3f | p50 %8.3f | p99 %8.3f | max %8.3f\n",
+						 pccName,
+						 vecValues.empty() ? 0.0 : vecValues.front(),
+						 dAvg,
+						 Percentile( vecValues, 0.50 ),
+						 Percentile( vecValues, 0.99 ),
+						 vecValues.empty() ? 0.0 : vecValues.back() );
+
+			return Percentile( vecValues, 0.99 );
+		};
+
+		// (1) Init timings
+		std::printf( "\n[benchxr] startup (ms)\n" );
+		for ( auto &timing : m_vecInitTimings )
+			std::printf( "  %-24s %10.3f\n", timing.first.c_str(), timing.second );
+
+		// (2) Frame timings
+		std::printf( "\n[benchxr] %zu frames, %u cubes, %s (ms)\n", m_vecSamples.size(), options.unCubes, options.bSerial ? "serial" : "pipelined" );
+		PrintStats( "events", &SFrameSample::dEvents );
+		PrintStats( "start", &SFrameSample::dStartFrame );
+		PrintStats( "simulate", &SFrameSample::dSimulate );
+		PrintStats( "end", &SFrameSample::dEndFrame );
+		const double dP99 = PrintStats( "frame", &SFrameSample::dTotal );
+
+		if ( options.unMaterials > 0 )
+		{
+			uint64_t unFlushed = 0;
+			for ( auto &sample : m_vecSamples )
+				unFlushed += sample.unMaterialsFlushed;
+
+			std::printf( "  %-12s %u tracked, %u dynamic, avg %.1f flushed per frame (%llu bytes last frame)\n",
+						 "materials",
+						 options.unMaterials,
+						 options.unDynamicMaterials,
+						 m_vecSamples.empty() ? 0.0 : static_cast< double >( unFlushed ) / static_cast< double >( m_vecSamples.size() ),
+						 static_cast< unsigned long long >( materialStore.GetStats().unBytes ) );
+		}
+
+		// (3) Raw samples
+		if ( !options.sCsvPath.empty() )
+		{
+			std::ofstream csv( options.sCsvPath );
+			csv << "frame,events_ms,start_ms,simulate_ms,end_ms,total_ms\n";
+			for ( size_t i = 0; i < m_vecSamples.size(); i++ )
+			{
+				auto &sample = m_vecSamples[ i ];
+				csv << i << "," << sample.dEvents << "," << sample.dStartFrame << "," << sample.dSimulate << "," << sample.dEndFrame << "," << sample.dTotal << "\n";
+			}
+
+			std::printf( "\n[benchxr] samples written to: %s\n", options.sCsvPath.c_str() );
+		}
+
+		// (4) Budget check, for CI
+		if ( m_vecSamples.size() < options.unFrames )
+		{
+			std::printf( "[benchxr] FAILED: session ended after %zu of %u measured frames\n", m_vecSamples.size(), options.unFrames );
+			return EXIT_FAILURE;
+		}
+
+		if ( options.dBudgetMs > 0.0 && dP99 > options.dBudgetMs )
+		{
+			std::printf( "[benchxr] FAILED: p99 frame time %.3f ms is over the %.3f ms budget\n", dP99, options.dBudgetMs );
+			return EXIT_FAILURE;
+		}
+
+		return EXIT_SUCCESS;
+	}
+
+} // namespace app
@@ -0,0 +1,95 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <xrapp.hpp>
+#include <frame_scheduler.hpp>
+
+using namespace xrlib;
+using namespace xrapp;
+
+namespace app
+{
+	class App : public XrApp
+	{
+	  public:
+		struct SOptions
+		{
+			uint32_t unFrames = 1000;		// --frames n : measured frames
+			uint32_t unWarmupFrames = 100;	// --warmup n : frames to skip before measuring
+			uint32_t unCubes = 256;			// --cubes n : number of animated cube instances in the scene
+			uint32_t unMaterials = 0;		// --materials n : number of materials tracked by the material store
+			uint32_t unDynamicMaterials = 16;	// --dynamic-materials n : how many of those change every frame
+			std::string sCsvPath;			// --csv path : write per-frame samples to a csv file
+			double dBudgetMs = 0.0;			// --budget-ms n : exit with failure if p99 frame time exceeds this (0 = no budget)
+			bool bSerial = false;			// --serial : run the frame loop in lockstep instead of pipelined
+		};
+
+		// Per-frame timings in milliseconds
+		struct SFrameSample
+		{
+			double dEvents = 0.0;
+			double dStartFrame = 0.0;
+			double dSimulate = 0.0;
+			double dEndFrame = 0.0;
+			double dTotal = 0.0;
+			uint32_t unMaterialsFlushed = 0;
+		};
+
+		App( int argc, char *argv[], const std::string &sAppName, const XrVersion32 unAppVersion, const ELogLevel eMinLogLevel );
+		~App();
+
+		int Init();
+		void SetupScene();
+		int Run();
+
+		SOptions options;
+
+		struct SPipelines
+		{
+			uint16_t primitiveLayout = 0;
+			uint32_t primitives = 0;
+		} pipelines;
+
+	  private:
+		void ParseOptions( int argc, char *argv[] );
+		void CreateGraphicsPipelines();
+		void Simulate( XrTime predictedDisplayTime );
+		void Publish();
+
+		int Report();
+
+		template< typename TFunc > double Time( const char *pccStep, TFunc &&func )
+		{
+			auto start = std::chrono::steady_clock::now();
+			func();
+			double dMs = std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now() - start ).count();
+
+			m_vecInitTimings.push_back( { pccStep, dMs } );
+			return dMs;
+		}
+
+		std::vector< std::pair< std::string, double > > m_vecInitTimings;
+		std::vector< SFrameSample > m_vecSamples;
+
+		CColoredCube *m_pCubes = nullptr;
+		std::vector< XrQuaternionf > m_vecCubeOrientations;		// back buffer for cube instances
+		std::vector< SMaterialUBO > m_vecMaterials;				// host memory stand-ins for mapped material ubos
+	};
+
+} // namespace app
@@ -0,0 +1,39 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+
+#include <app.hpp>
+
+#define APP_NAME "benchxr"
+using namespace app;
+
+int main( int argc, char *argv[] )
+{
+	// (1) Create app - keep logging quiet so it doesn't skew frame timings
+	std::unique_ptr< App > pApp = std::make_unique< App >( argc, argv, APP_NAME, XR_MAKE_VERSION32( 1, 0, 0 ), ELogLevel::LogError );
+
+	// (2) Initialize app
+	if ( pApp->Init() == EXIT_FAILURE )
+	{
+		LogError( APP_NAME, "Unable to initialize. Is XR_RUNTIME_JSON pointing to a valid runtime (e.g. tools/mockxr/bin/mockxr.json)?" );
+		return xrlib::ExitApp( EXIT_FAILURE );
+	}
+
+	// (3) Setup scene
+	pApp->SetupScene();
+
+	// (4) Run frame loop and report
+	int nResult = pApp->Run();
+
+	// (5) Exit app - xrlib objects handle cleanup once unique pointers go out of scope
+	return xrlib::ExitApp( nResult );
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <mesh_bake.hpp>
+
+#define APP_NAME "meshbake"
+
+namespace
+{
+	void PrintUsage()
+	{
+		std::cout << "Usage: " << APP_NAME << " <file.gltf|file.glb>... [-o output]\n"
+				  << "Writes each mesh as <file>" << xrapp::k_pccBakedMeshExtension << " next to its source.\n"
+				  << "  -o output   Output path, only valid with a single input\n";
+	}
+}
+
+int main( int argc, char *argv[] )
+{
+	// (1) Parse arguments
+	std::vector< std::string > vecInputs;
+	std::string sOutput;
+
+	for ( int i = 1; i < argc; i++ )
+	{
+		if ( std::strcmp( argv[ i ], "-o" ) == 0 && i + 1 < argc )
+			sOutput = argv[ ++i ];
+		else if ( std::strcmp( argv[ i ], "-h" ) == 0 || std::strcmp( argv[ i ], "--help" ) == 0 )
+		{
+			PrintUsage();
+			return EXIT_SUCCESS;
+		}
+		else
+			vecInputs.push_back( argv[ i ] );
+	}
+
+	if ( vecInputs.empty() || ( !sOutput.empty() && vecInputs.size() > 1 ) )
+	{
+		PrintUsage();
+		return EXIT_FAILURE;
+	}
+
+	// (2) Bake each mesh
+	int nResult = EXIT_SUCCESS;
+	for ( auto &sInput : vecInputs )
+	{
+		std::string sBaked = sOutput.empty() ? sInput + xrapp::k_pccBakedMeshExtension : sOutput;
+
+		std::string sError;
+		if ( !xrapp::BakeMesh( sInput, sBaked, sError ) )
+		{
+			std::cerr << "[" << APP_NAME << "] Unable to bake " << sInput << ": " << sError << "\n";
+			nResult = EXIT_FAILURE;
+			continue;
+		}
+
+		std::cout << "[" << APP_NAME << "] " << sInput << " -> " << sBaked << "\n";
+	}
+
+	return nResult;
+}
@@ -0,0 +1,768 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+
+#include <mock_runtime.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace mockxr
+{
+	static constexpr float k_fPi = 3.14159265358979f;
+
+	// Wrap before narrowing, steady clock values are too large to keep sub-frame precision in a float
+	static float GetAnimationSeconds( XrTime xrTime )
+	{
+		return static_cast< float >( std::fmod( ToSeconds( xrTime ), 3600.0 ) );
+	}
+
+	static SInstance *GetInstance( XrInstance xrInstance )
+	{
+		SInstance *pInstance = FromHandle< SInstance >( xrInstance );
+		return ( pInstance && pInstance == GetRuntime().pInstance ) ? pInstance : nullptr;
+	}
+
+	static SSession *GetSession( XrSession xrSession )
+	{
+		SSession *pSession = FromHandle< SSession >( xrSession );
+		SInstance *pInstance = GetRuntime().pInstance;
+		return ( pSession && pInstance && pInstance->pSession == pSession ) ? pSession : nullptr;
+	}
+
+	static SActionSet *GetActionSet( XrActionSet xrActionSet )
+	{
+		SActionSet *pActionSet = FromHandle< SActionSet >( xrActionSet );
+		SInstance *pInstance = GetRuntime().pInstance;
+		if ( !pActionSet || !pInstance )
+			return nullptr;
+
+		auto &vecSets = pInstance->vecActionSets;
+		return std::find( vecSets.begin(), vecSets.end(), pActionSet ) != vecSets.end() ? pActionSet : nullptr;
+	}
+
+	static SAction *GetAction( XrAction xrAction )
+	{
+		SAction *pAction = FromHandle< SAction >( xrAction );
+		SInstance *pInstance = GetRuntime().pInstance;
+		if ( !pAction || !pInstance )
+			return nullptr;
+
+		auto &vecActions = pInstance->vecActions;
+		return std::find( vecActions.begin(), vecActions.end(), pAction ) != vecActions.end() ? pAction : nullptr;
+	}
+
+	// -------------------------------------------------------------------------------------------
+	// Math
+	// -------------------------------------------------------------------------------------------
+
+	XrQuaternionf QuatMultiply( const XrQuaternionf &a, const XrQuaternionf &b )
+	{
+		return { a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+				 a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+				 a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+				 a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z };
+	}
+
+	XrQuaternionf QuatFromAxisAngle( const XrVector3f &axis, float fRadians )
+	{
+		const float fHalf = fRadians * 0.5f;
+		const float fSin = std::sin( fHalf );
+		return { axis.x * fSin, axis.y * fSin, axis.z * fSin, std::cos( fHalf ) };
+	}
+
+	XrVector3f QuatRotate( const XrQuaternionf &q, const XrVector3f &v )
+	{
+		// v' = v + 2w(u x v) + 2(u x (u x v))
+		const XrVector3f u { q.x, q.y, q.z };
+		const XrVector3f uv { u.y * v.z - u.z * v.y, u.z * v.x - u.x * v.z, u.x * v.y - u.y * v.x };
+		const XrVector3f uuv { u.y * uv.z - u.z * uv.y, u.z * uv.x - u.x * uv.z, u.x * uv.y - u.y * uv.x };
+
+		return { v.x + 2.0f * ( q.w * uv.x + uuv.x ), v.y + 2.0f * ( q.w * uv.y + uuv.y ), v.z + 2.0f * ( q.w * uv.z + uuv.z ) };
+	}
+
+	XrPosef PoseMultiply( const XrPosef &parent, const XrPosef &child )
+	{
+		XrPosef result;
+		result.orientation = QuatMultiply( parent.orientation, child.orientation );
+
+		const XrVector3f rotated = QuatRotate( parent.orientation, child.position );
+		result.position = { parent.position.x + rotated.x, parent.position.y + rotated.y, parent.position.z + rotated.z };
+
+		return result;
+	}
+
+	XrPosef PoseInverse( const XrPosef &pose )
+	{
+		XrPosef result;
+		result.orientation = { -pose.orientation.x, -pose.orientation.y, -pose.orientation.z, pose.orientation.w };
+
+		const XrVector3f rotated = QuatRotate( result.orientation, pose.position );
+		result.position = { -rotated.x, -rotated.y, -rotated.z };
+
+		return result;
+	}
+
+	// -------------------------------------------------------------------------------------------
+	// Synthetic tracking
+	// -------------------------------------------------------------------------------------------
+
+	XrPosef GetHeadPose( XrTime xrTime )
+	{
+		// Standing user slowly looking around
+		const float fSeconds = GetAnimationSeconds( xrTime );
+
+		XrPosef pose;
+		pose.orientation = QuatMultiply( QuatFromAxisAngle( { 0.0f, 1.0f, 0.0f }, 0.35f * std::sin( fSeconds * 0.5f ) ), QuatFromAxisAngle( { 1.0f, 0.0f, 0.0f }, 0.1f * std::sin( fSeconds * 0.7f ) ) );
+		pose.position = { 0.02f * std::sin( fSeconds * 1.1f ), 1.6f + 0.01f * std::sin( fSeconds * 2.0f ), 0.0f };
+
+		return pose;
+	}
+
+	XrPosef GetHandPose( uint32_t unHand, XrTime xrTime )
+	{
+		// Hands held out in front, tracing small circles
+		const float fSeconds = GetAnimationSeconds( xrTime );
+		const float fSide = unHand == 0 ? -1.0f : 1.0f;
+		const float fPhase = fSeconds * 1.5f + ( unHand == 0 ? 0.0f : k_fPi );
+
+		XrPosef pose;
+		pose.orientation = QuatFromAxisAngle( { 0.0f, 0.0f, 1.0f }, fSide * 0.2f * std::sin( fPhase ) );
+		pose.position = { fSide * 0.2f + 0.05f * std::cos( fPhase ), 1.3f + 0.05f * std::sin( fPhase ), -0.35f };
+
+		return pose;
+	}
+
+	XrPosef GetSpacePose( const SSpace *pSpace, XrTime xrTime )
+	{
+		XrPosef base { { 0.0f, 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, 0.0f } };
+
+		if ( pSpace->eKind == SSpace::EKind::Action )
+		{
+			base = GetHandPose( pSpace->unSubactionSlot, xrTime );
+		}
+		else if ( pSpace->xrReferenceSpaceType == XR_REFERENCE_SPACE_TYPE_VIEW )
+		{
+			base = GetHeadPose( xrTime );
+		}
+		else if ( pSpace->xrReferenceSpaceType == XR_REFERENCE_SPACE_TYPE_LOCAL )
+		{
+			base.position.y = 1.6f;
+		}
+
+		return PoseMultiply( base, pSpace->offset );
+	}
+
+	uint32_t GetSubactionSlot( SInstance *pInstance, XrPath xrSubactionPath )
+	{
+		if ( xrSubactionPath == XR_NULL_PATH || xrSubactionPath >= pInstance->vecPathStrings.size() )
+			return 0;
+
+		return pInstance->vecPathStrings[ xrSubactionPath ] == "/user/hand/right" ? 1 : 0;
+	}
+
+	void SampleActionStates( SSession *pSession, XrTime xrTime )
+	{
+		const float fSeconds = GetAnimationSeconds( xrTime );
+
+		uint32_t unActionIndex = 0;
+		for ( SActionSet *pActionSet : pSession->vecAttachedActionSets )
+		{
+			const bool bSetActive = std::find( pSession->vecActiveActionSets.begin(), pSession->vecActiveActionSets.end(), pActionSet ) != pSession->vecActiveActionSets.end();
+
+			for ( SAction *pAction : pActionSet->vecActions )
+			{
+				unActionIndex++;
+
+				const uint32_t unSlots = std::clamp( static_cast< uint32_t >( pAction->vecSubactionPaths.size() ), 1u, k_unMaxSubactionSlots );
+				for ( uint32_t unSlot = 0; unSlot < unSlots; unSlot++ )
+				{
+					SAction::SState &state = pAction->states[ unSlot ];
+					state.previous = state.current;
+					state.previousVec2 = state.currentVec2;
+					state.isActive = bSetActive;
+
+					if ( !bSetActive )
+						continue;
+
+					// Stagger each action and hand so inputs don't all fire on the same frame
+					const float fPhase = fSeconds + static_cast< float >( unActionIndex ) * 0.37f + static_cast< float >( unSlot ) * 0.61f;
+
+					switch ( pAction->xrActionType )
+					{
+						case XR_ACTION_TYPE_BOOLEAN_INPUT:
+							state.current = std::fmod( fPhase, 2.0f ) < 0.25f ? 1.0f : 0.0f;
+							break;
+						case XR_ACTION_TYPE_FLOAT_INPUT:
+							state.current = 0.5f + 0.5f * std::sin( fPhase * 1.3f );
+							break;
+						case XR_ACTION_TYPE_VECTOR2F_INPUT:
+							state.currentVec2 = { std::cos( fPhase ), std::sin( fPhase ) };
+							break;
+						default:
+							break;
+					}
+
+					if ( state.current != state.previous || state.currentVec2.x != state.previousVec2.x || state.currentVec2.y != state.previousVec2.y )
+						state.lastChangeTime = xrTime;
+				}
+			}
+		}
+	}
+
+	// -------------------------------------------------------------------------------------------
+	// Paths
+	// -------------------------------------------------------------------------------------------
+
+	XrResult XRAPI_CALL StringToPath( XrInstance instance, const char *pathString, XrPath *path )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		SInstance *pInstance = GetInstance( instance );
+		if ( !pInstance )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( !pathString || !path )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		const size_t unLength = std::strlen( pathString );
+		if ( unLength < 2 || unLength >= XR_MAX_PATH_LENGTH || pathString[ 0 ] != '/' || pathString[ unLength - 1 ] == '/' )
+			return XR_ERROR_PATH_FORMAT_INVALID;
+
+		*path = pInstance->GetOrCreatePath( pathString );
+		return XR_SUCCESS;
+	}
+
+	XrResult XRAPI_CALL PathToString( XrInstance instance, XrPath path, uint32_t bufferCapacityInput, uint32_t *bufferCountOutput, char *buffer )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		SInstance *pInstance = GetInstance( instance );
+		if ( !pInstance )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( path == XR_NULL_PATH || path >= pInstance->vecPathStrings.size() )
+			return XR_ERROR_PATH_INVALID;
+
+		return FillString( bufferCapacityInput, bufferCountOutput, buffer, pInstance->vecPathStrings[ path ] );
+	}
+
+	// -------------------------------------------------------------------------------------------
+	// Actions
+	// -------------------------------------------------------------------------------------------
+
+	XrResult XRAPI_CALL CreateActionSet( XrInstance instance, const XrActionSetCreateInfo *createInfo, XrActionSet *actionSet )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		SInstance *pInstance = GetInstance( instance );
+		if ( !pInstance )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( !createInfo || !actionSet )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		if ( createInfo->actionSetName[ 0 ] == '\0' )
+			return XR_ERROR_NAME_INVALID;
+
+		for ( SActionSet *pExisting : pInstance->vecActionSets )
+		{
+			if ( pExisting->sName == createInfo->actionSetName )
+				return XR_ERROR_NAME_DUPLICATED;
+		}
+
+		SActionSet *pActionSet = new SActionSet();
+		pActionSet->sName = createInfo->actionSetName;
+
+		pInstance->vecActionSets.push_back( pActionSet );
+		*actionSet = ToHandle< XrActionSet >( pActionSet );
+
+		return XR_SUCCESS;
+	}
+
+	XrResult XRAPI_CALL DestroyActionSet( XrActionSet actionSet )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		SActionSet *pActionSet = GetActionSet( actionSet );
+		if ( !pActionSet )
+			return XR_ERROR_HANDLE_INVALID;
+
+		SInstance *pInstance = GetRuntime().pInstance;
+		for ( SAction *pAction : pActionSet->vecActions )
+		{
+			pInstance->vecActions.erase( std::remove( pInstance->vecActions.begin(), pInstance->vecActions.end(), pAction ), pInstance->vecActions.end() );
+			delete pAction;
+		}
+
+		pInstance->vecActionSets.erase( std::remove( pInstance->vecActionSets.begin(), pInstance->vecActionSets.end(), pActionSet ), pInstance->vecActionSets.end() );
+
+		if ( SSession *pSession = pInstance->pSession )
+		{
+			pSession->vecAttachedActionSets.erase( std::remove( pSession->vecAttachedActionSets.begin(), pSession->vecAttachedActionSets.end(), pActionSet ), pSession->vecAttachedActionSets.end() );
+			pSession->vecActiveActionSets.erase( std::remove( pSession->vecActiveActionSets.begin(), pSession->vecActiveActionSets.end(), pActionSet ), pSession->vecActiveActionSets.end() );
+		}
+
+		delete pActionSet;
+		return XR_SUCCESS;
+	}
+
+	XrResult XRAPI_CALL CreateAction( XrActionSet actionSet, const XrActionCreateInfo *createInfo, XrAction *action )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		SActionSet *pActionSet = GetActionSet( actionSet );
+		if ( !pActionSet )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( !createInfo || !action )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		if ( createInfo->actionName[ 0 ] == '\0' )
+			return XR_ERROR_NAME_INVALID;
+
+		SInstance *pInstance = GetRuntime().pInstance;
+		if ( pInstance->pSession && std::find( pInstance->pSession->vecAttachedActionSets.begin(), pInstance->pSession->vecAttachedActionSets.end(), pActionSet ) != pInstance->pSession->vecAttachedActionSets.end() )
+			return XR_ERROR_ACTIONSETS_ALREADY_ATTACHED;
+
+		SAction *pAction = new SAction();
+		pAction->xrActionType = createInfo->actionType;
+		pAction->xrActionSet = actionSet;
+		pAction->vecSubactionPaths.assign( createInfo->subactionPaths, createInfo->subactionPaths + createInfo->countSubactionPaths );
+
+		pActionSet->vecActions.push_back( pAction );
+		pInstance->vecActions.push_back( pAction );
+		*action = ToHandle< XrAction >( pAction );
+
+		return XR_SUCCESS;
+	}
+
+	XrResult XRAPI_CALL DestroyAction( XrAction action )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		SAction *pAction = GetAction( action );
+		if ( !pAction )
+			return XR_ERROR_HANDLE_INVALID;
+
+		SInstance *pInstance = GetRuntime().pInstance;
+		if ( SActionSet *pActionSet = GetActionSet( pAction->xrActionSet ) )
+			pActionSet->vecActions.erase( std::remove( pActionSet->vecActions.begin(), pActionSet->vecActions.end(), pAction ), pActionSet->vecActions.end() );
+
+		pInstance->vecActions.erase( std::remove( pInstance->vecActions.begin(), pInstance->vecActions.end(), pAction ), pInstance->vecActions.end() );
+		delete pAction;
+
+		return XR_SUCCESS;
+	}
+
+	XrResult XRAPI_CALL SuggestInteractionProfileBindings( XrInstance instance, const XrInteractionProfileSuggestedBinding *suggestedBindings )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		SInstance *pInstance = GetInstance( instance );
+		if ( !pInstance )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( !suggestedBindings || suggestedBindings->countSuggestedBindings == 0 )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		if ( suggestedBindings->interactionProfile == XR_NULL_PATH || suggestedBindings->interactionProfile >= pInstance->vecPathStrings.size() )
+			return XR_ERROR_PATH_INVALID;
+
+		for ( uint32_t i = 0; i < suggestedBindings->countSuggestedBindings; i++ )
+		{
+			if ( !GetAction( suggestedBindings->suggestedBindings[ i ].action ) )
+				return XR_ERROR_HANDLE_INVALID;
+		}
+
+		auto &vecProfiles = pInstance->vecSuggestedProfiles;
+		if ( std::find( vecProfiles.begin(), vecProfiles.end(), suggestedBindings->interactionProfile ) == vecProfiles.end() )
+			vecProfiles.push_back( suggestedBindings->interactionProfile );
+
+		return XR_SUCCESS;
+	}
+
+	XrResult XRAPI_CALL AttachSessionActionSets( XrSession session, const XrSessionActionSetsAttachInfo *attachInfo )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		SSession *pSession = GetSession( session );
+		if ( !pSession )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( !attachInfo || attachInfo->countActionSets == 0 )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		if ( !pSession->vecAttachedActionSets.empty() )
+			return XR_ERROR_ACTIONSETS_ALREADY_ATTACHED;
+
+		for ( uint32_t i = 0; i < attachInfo->countActionSets; i++ )
+		{
+			SActionSet *pActionSet = GetActionSet( attachInfo->actionSets[ i ] );
+			if ( !pActionSet )
+				return XR_ERROR_HANDLE_INVALID;
+
+			pSession->vecAttachedActionSets.push_back( pActionSet );
+		}
+
+		// Bind to the first suggested profile, as soon as actions are attached
+		SInstance *pInstance = GetRuntime().pInstance;
+		if ( !pInstance->vecSuggestedProfiles.empty() )
+		{
+			XrEventDataInteractionProfileChanged event { XR_TYPE_EVENT_DATA_INTERACTION_PROFILE_CHANGED };
+			event.session = session;
+			QueueEvent( event );
+		}
+
+		return XR_SUCCESS;
+	}
+
+	XrResult XRAPI_CALL GetCurrentInteractionProfile( XrSession session, XrPath topLevelUserPath, XrInteractionProfileState *interactionProfile )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		SSession *pSession = GetSession( session );
+		if ( !pSession )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( !interactionProfile )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		if ( pSession->vecAttachedActionSets.empty() )
+			return XR_ERROR_ACTIONSET_NOT_ATTACHED;
+
+		const auto &vecProfiles = GetRuntime().pInstance->vecSuggestedProfiles;
+		interactionProfile->interactionProfile = vecProfiles.empty() ? XR_NULL_PATH : vecProfiles.front();
+
+		return XR_SUCCESS;
+	}
+
+	XrResult XRAPI_CALL SyncActions( XrSession session, const XrActionsSyncInfo *syncInfo )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		SSession *pSession = GetSession( session );
+		if ( !pSession )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( !syncInfo )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		pSession->vecActiveActionSets.clear();
+		for ( uint32_t i = 0; i < syncInfo->countActiveActionSets; i++ )
+		{
+			SActionSet *pActionSet = GetActionSet( syncInfo->activeActionSets[ i ].actionSet );
+			if ( !pActionSet )
+				return XR_ERROR_HANDLE_INVALID;
+
+			if ( std::find( pSession->vecAttachedActionSets.begin(), pSession->vecAttachedActionSets.end(), pActionSet ) == pSession->vecAttachedActionSets.end() )
+				return XR_ERROR_ACTIONSET_NOT_ATTACHED;
+
+			pSession->vecActiveActionSets.push_back( pActionSet );
+		}
+
+		// Input is only delivered to a focused session
+		if ( pSession->xrState != XR_SESSION_STATE_FOCUSED )
+			pSession->vecActiveActionSets.clear();
+
+		SampleActionStates( pSession, GetCurrentTime() );
+		pSession->stats.unSyncs++;
+
+		return pSession->xrState == XR_SESSION_STATE_FOCUSED ? XR_SUCCESS : XR_SESSION_NOT_FOCUSED;
+	}
+
+	static XrResult GetActionStateSlot( XrSession session, const XrActionStateGetInfo *getInfo, XrActionType xrExpectedType, SAction::SState **ppState )
+	{
+		SSession *pSession = GetSession( session );
+		if ( !pSession )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( !getInfo )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		SAction *pAction = GetAction( getInfo->action );
+		if ( !pAction )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( pAction->xrActionType != xrExpectedType )
+			return XR_ERROR_ACTION_TYPE_MISMATCH;
+
+		if ( getInfo->subactionPath != XR_NULL_PATH && std::find( pAction->vecSubactionPaths.begin(), pAction->vecSubactionPaths.end(), getInfo->subactionPath ) == pAction->vecSubactionPaths.end() )
+			return XR_ERROR_PATH_UNSUPPORTED;
+
+		*ppState = &pAction->states[ GetSubactionSlot( GetRuntime().pInstance, getInfo->subactionPath ) ];
+		return XR_SUCCESS;
+	}
+
+	XrResult XRAPI_CALL GetActionStateBoolean( XrSession session, const XrActionStateGetInfo *getInfo, XrActionStateBoolean *state )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		if ( !state )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		SAction::SState *pState = nullptr;
+		MOCKXR_RETURN_ON_ERROR( GetActionStateSlot( session, getInfo, XR_ACTION_TYPE_BOOLEAN_INPUT, &pState ) );
+
+		state->currentState = pState->current > 0.5f ? XR_TRUE : XR_FALSE;
+		state->changedSinceLastSync = ( pState->current > 0.5f ) != ( pState->previous > 0.5f ) ? XR_TRUE : XR_FALSE;
+		state->lastChangeTime = pState->lastChangeTime;
+		state->isActive = pState->isActive ? XR_TRUE : XR_FALSE;
+
+		return XR_SUCCESS;
+	}
+
+	XrResult XRAPI_CALL GetActionStateFloat( XrSession session, const XrActionStateGetInfo *getInfo, XrActionStateFloat *state )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		if ( !state )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		SAction::SState *pState = nullptr;
+		MOCKXR_RETURN_ON_ERROR( GetActionStateSlot( session, getInfo, XR_ACTION_TYPE_FLOAT_INPUT, &pState ) );
+
+		state->currentState = pState->current;
+		state->changedSinceLastSync = pState->current != pState->previous ? XR_TRUE : XR_FALSE;
+		state->lastChangeTime = pState->lastChangeTime;
+		state->isActive = pState->isActive ? XR_TRUE : XR_FALSE;
+
+		return XR_SUCCESS;
+	}
+
+	XrResult XRAPI_CALL GetActionStateVector2f( XrSession session, const XrActionStateGetInfo *getInfo, XrActionStateVector2f *state )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		if ( !state )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		SAction::SState *pState = nullptr;
+		MOCKXR_RETURN_ON_ERROR( GetActionStateSlot( session, getInfo, XR_ACTION_TYPE_VECTOR2F_INPUT, &pState ) );
+
+		state->currentState = pState->currentVec2;
+		state->changedSinceLastSync = ( pState->currentVec2.x != pState->previousVec2.x || pState->currentVec2.y != pState->previousVec2.y ) ? XR_TRUE : XR_FALSE;
+		state->lastChangeTime = pState->lastChangeTime;
+		state->isActive = pState->isActive ? XR_TRUE : XR_FALSE;
+
+		return XR_SUCCESS;
+	}
+
+	XrResult XRAPI_CALL GetActionStatePose( XrSession session, const XrActionStateGetInfo *getInfo, XrActionStatePose *state )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		if ( !state )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		SAction::SState *pState = nullptr;
+		MOCKXR_RETURN_ON_ERROR( GetActionStateSlot( session, getInfo, XR_ACTION_TYPE_POSE_INPUT, &pState ) );
+
+		state->isActive = pState->isActive ? XR_TRUE : XR_FALSE;
+		return XR_SUCCESS;
+	}
+
+	XrResult XRAPI_CALL EnumerateBoundSourcesForAction( XrSession session, const XrBoundSourcesForActionEnumerateInfo *enumerateInfo, uint32_t sourceCapacityInput, uint32_t *sourceCountOutput, XrPath *sources )
+	{
+		if ( !GetSession( session ) )
+			return XR_ERROR_HANDLE_INVALID;
+
+		// No physical inputs to report
+		return FillArray< XrPath >( sourceCapacityInput, sourceCountOutput, sources, nullptr, 0 );
+	}
+
+	XrResult XRAPI_CALL GetInputSourceLocalizedName( XrSession session, const XrInputSourceLocalizedNameGetInfo *getInfo, uint32_t bufferCapacityInput, uint32_t *bufferCountOutput, char *buffer )
+	{
+		if ( !GetSession( session ) )
+			return XR_ERROR_HANDLE_INVALID;
+
+		return FillString( bufferCapacityInput, bufferCountOutput, buffer, MOCKXR_NAME " input" );
+	}
+
+	XrResult XRAPI_CALL CreateActionSpace( XrSession session, const XrActionSpaceCreateInfo *createInfo, XrSpace *space )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		SSession *pSession = GetSession( session );
+		if ( !pSession )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( !createInfo || !space )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		SAction *pAction = GetAction( createInfo->action );
+		if ( !pAction )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( pAction->xrActionType != XR_ACTION_TYPE_POSE_INPUT )
+			return XR_ERROR_ACTION_TYPE_MISMATCH;
+
+		SSpace *pSpace = new SSpace();
+		pSpace->eKind = SSpace::EKind::Action;
+		pSpace->pAction = pAction;
+		pSpace->unSubactionSlot = GetSubactionSlot( GetRuntime().pInstance, createInfo->subactionPath );
+		pSpace->offset = createInfo->poseInActionSpace;
+
+		pSession->vecSpaces.push_back( pSpace );
+		*space = ToHandle< XrSpace >( pSpace );
+
+		return XR_SUCCESS;
+	}
+
+	XrResult XRAPI_CALL ApplyHapticFeedback( XrSession session, const XrHapticActionInfo *hapticActionInfo, const XrHapticBaseHeader *hapticFeedback )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		SSession *pSession = GetSession( session );
+		if ( !pSession )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( !hapticActionInfo || !hapticFeedback )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		SAction *pAction = GetAction( hapticActionInfo->action );
+		if ( !pAction )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( pAction->xrActionType != XR_ACTION_TYPE_VIBRATION_OUTPUT )
+			return XR_ERROR_ACTION_TYPE_MISMATCH;
+
+		// Nothing to vibrate, just count so benchmarks can see how chatty the app is
+		pSession->stats.unHaptics++;
+		return pSession->xrState == XR_SESSION_STATE_FOCUSED ? XR_SUCCESS : XR_SESSION_NOT_FOCUSED;
+	}
+
+	XrResult XRAPI_CALL StopHapticFeedback( XrSession session, const XrHapticActionInfo *hapticActionInfo )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		if ( !GetSession( session ) )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( !hapticActionInfo || !GetAction( hapticActionInfo->action ) )
+			return XR_ERROR_HANDLE_INVALID;
+
+		return XR_SUCCESS;
+	}
+
+	// -------------------------------------------------------------------------------------------
+	// XR_EXT_hand_tracking
+	// -------------------------------------------------------------------------------------------
+
+	XrResult XRAPI_CALL CreateHandTrackerEXT( XrSession session, const XrHandTrackerCreateInfoEXT *createInfo, XrHandTrackerEXT *handTracker )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		SSession *pSession = GetSession( session );
+		if ( !pSession )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( !createInfo || !handTracker )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		if ( createInfo->hand != XR_HAND_LEFT_EXT && createInfo->hand != XR_HAND_RIGHT_EXT )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		if ( createInfo->handJointSet != XR_HAND_JOINT_SET_DEFAULT_EXT )
+			return XR_ERROR_FEATURE_UNSUPPORTED;
+
+		SHandTracker *pHandTracker = new SHandTracker();
+		pHandTracker->xrHand = createInfo->hand;
+
+		pSession->vecHandTrackers.push_back( pHandTracker );
+		*handTracker = ToHandle< XrHandTrackerEXT >( pHandTracker );
+
+		return XR_SUCCESS;
+	}
+
+	XrResult XRAPI_CALL DestroyHandTrackerEXT( XrHandTrackerEXT handTracker )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		SHandTracker *pHandTracker = FromHandle< SHandTracker >( handTracker );
+		SInstance *pInstance = GetRuntime().pInstance;
+		if ( !pHandTracker || !pInstance || !pInstance->pSession )
+			return XR_ERROR_HANDLE_INVALID;
+
+		auto &vecHandTrackers = pInstance->pSession->vecHandTrackers;
+		auto it = std::find( vecHandTrackers.begin(), vecHandTrackers.end(), pHandTracker );
+		if ( it == vecHandTrackers.end() )
+			return XR_ERROR_HANDLE_INVALID;
+
+		vecHandTrackers.erase( it );
+		delete pHandTracker;
+
+		return XR_SUCCESS;
+	}
+
+	XrResult XRAPI_CALL LocateHandJointsEXT( XrHandTrackerEXT handTracker, const XrHandJointsLocateInfoEXT *locateInfo, XrHandJointLocationsEXT *locations )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		SHandTracker *pHandTracker = FromHandle< SHandTracker >( handTracker );
+		SInstance *pInstance = GetRuntime().pInstance;
+		if ( !pHandTracker || !pInstance || !pInstance->pSession )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( !locateInfo || !locations || locations->jointCount != XR_HAND_JOINT_COUNT_EXT || !locations->jointLocations )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		SSpace *pBaseSpace = FromHandle< SSpace >( locateInfo->baseSpace );
+		auto &vecSpaces = pInstance->pSession->vecSpaces;
+		if ( !pBaseSpace || std::find( vecSpaces.begin(), vecSpaces.end(), pBaseSpace ) == vecSpaces.end() )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( locateInfo->time <= 0 )
+			return XR_ERROR_TIME_INVALID;
+
+		const uint32_t unHand = pHandTracker->xrHand == XR_HAND_LEFT_EXT ? 0 : 1;
+		const float fSide = unHand == 0 ? -1.0f : 1.0f;
+		const XrPosef wristInBase = PoseMultiply( PoseInverse( GetSpacePose( pBaseSpace, locateInfo->time ) ), GetHandPose( unHand, locateInfo->time ) );
+
+		// Fingers slowly open and close
+		const float fCurl = 0.5f + 0.5f * std::sin( GetAnimationSeconds( locateInfo->time ) * 2.0f );
+		const XrQuaternionf identity { 0.0f, 0.0f, 0.0f, 1.0f };
+
+		auto SetJoint = [ & ]( uint32_t unJoint, const XrPosef &localPose, float fRadius )
+		{
+			XrHandJointLocationEXT &joint = locations->jointLocations[ unJoint ];
+			joint.pose = PoseMultiply( wristInBase, localPose );
+			joint.radius = fRadius;
+			joint.locationFlags = XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_POSITION_VALID_BIT | XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT | XR_SPACE_LOCATION_POSITION_TRACKED_BIT;
+		};
+
+		SetJoint( XR_HAND_JOINT_WRIST_EXT, { identity, { 0.0f, 0.0f, 0.0f } }, 0.02f );
+		SetJoint( XR_HAND_JOINT_PALM_EXT, { identity, { 0.0f, 0.0f, -0.05f } }, 0.025f );
+
+		// Thumb has four joints (metacarpal to tip), every other finger five (metacarpal to tip)
+		const uint32_t arrFirstJoint[] = { XR_HAND_JOINT_THUMB_METACARPAL_EXT, XR_HAND_JOINT_INDEX_METACARPAL_EXT, XR_HAND_JOINT_MIDDLE_METACARPAL_EXT, XR_HAND_JOINT_RING_METACARPAL_EXT, XR_HAND_JOINT_LITTLE_METACARPAL_EXT };
+		const uint32_t arrJointCount[] = { 4, 5, 5, 5, 5 };
+		const float arrFingerX[] = { 0.035f, 0.02f, 0.0f, -0.018f, -0.034f };
+
+		for ( uint32_t unFinger = 0; unFinger < 5; unFinger++ )
+		{
+			XrPosef segment { identity, { -fSide * arrFingerX[ unFinger ], 0.0f, -0.01f } };
+			const float fSegmentLength = unFinger == 0 ? 0.03f : 0.035f;
+			const XrQuaternionf curl = QuatFromAxisAngle( { 1.0f, 0.0f, 0.0f }, -fCurl * 0.35f );
+
+			for ( uint32_t unJoint = 0; unJoint < arrJointCount[ unFinger ]; unJoint++ )
+			{
+				SetJoint( arrFirstJoint[ unFinger ] + unJoint, segment, 0.01f - 0.001f * static_cast< float >( unJoint ) );
+
+				// Walk down the finger, bending a little more at each knuckle past the metacarpal
+				if ( unJoint > 0 )
+					segment.orientation = QuatMultiply( segment.orientation, curl );
+
+				segment = PoseMultiply( segment, { identity, { 0.0f, 0.0f, -fSegmentLength } } );
+			}
+		}
+
+		locations->isActive = XR_TRUE;
+
+		// Velocities are optional, report them as unavailable
+		auto *pNext = reinterpret_cast< XrBaseOutStructure * >( locations->next );
+		while ( pNext )
+		{
+			if ( pNext->type == XR_TYPE_HAND_JOINT_VELOCITIES_EXT )
+			{
+				auto *pVelocities = reinterpret_cast< XrHandJointVelocitiesEXT * >( pNext );
+				for ( uint32_t i = 0; i < pVelocities->jointCount; i++ )
+					pVelocities->jointVelocities[ i ].velocityFlags = 0;
+			}
+
+			pNext = pNext->next;
+		}
+
+		return XR_SUCCESS;
+	}
+
+} // namespace mockxr
@@ -0,0 +1,1177 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+
+#include <mock_runtime.hpp>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <thread>
+
+#include <openxr/openxr_reflection.h>
+
+namespace mockxr
+{
+	static constexpr const char *k_pccSupportedExtensions[] = {
+		XR_KHR_VULKAN_ENABLE_EXTENSION_NAME,
+		XR_KHR_VULKAN_ENABLE2_EXTENSION_NAME,
+		XR_KHR_VISIBILITY_MASK_EXTENSION_NAME,
+		XR_EXT_HAND_TRACKING_EXTENSION_NAME,
+		XR_FB_DISPLAY_REFRESH_RATE_EXTENSION_NAME,
+	};
+
+	static constexpr uint32_t k_unSupportedExtensionVersions[] = {
+		XR_KHR_vulkan_enable_SPEC_VERSION,
+		XR_KHR_vulkan_enable2_SPEC_VERSION,
+		XR_KHR_visibility_mask_SPEC_VERSION,
+		XR_EXT_hand_tracking_SPEC_VERSION,
+		XR_FB_display_refresh_rate_SPEC_VERSION,
+	};
+
+	SRuntime &GetRuntime()
+	{
+		static SRuntime runtime;
+		return runtime;
+	}
+
+	static uint64_t ReadEnvU64( const char *pccName, uint64_t unDefault )
+	{
+		const char *pccValue = std::getenv( pccName );
+		return pccValue ? std::strtoull( pccValue, nullptr, 10 ) : unDefault;
+	}
+
+	void SConfig::LoadFromEnvironment()
+	{
+		if ( const char *pccRate = std::getenv( "MOCKXR_REFRESH_RATE" ) )
+			fRefreshRate = std::strtof( pccRate, nullptr );
+
+		if ( fRefreshRate <= 0.0f )
+			fRefreshRate = 90.0f;
+
+		if ( std::find( vecSupportedRates.begin(), vecSupportedRates.end(), fRefreshRate ) == vecSupportedRates.end() )
+		{
+			vecSupportedRates.push_back( fRefreshRate );
+			std::sort( vecSupportedRates.begin(), vecSupportedRates.end() );
+		}
+
+		unEyeWidth = static_cast< uint32_t >( ReadEnvU64( "MOCKXR_EYE_WIDTH", unEyeWidth ) );
+		unEyeHeight = static_cast< uint32_t >( ReadEnvU64( "MOCKXR_EYE_HEIGHT", unEyeHeight ) );
+		unExitAfterFrames = ReadEnvU64( "MOCKXR_EXIT_AFTER_FRAMES", unExitAfterFrames );
+		unVismaskEventInterval = static_cast< uint32_t >( ReadEnvU64( "MOCKXR_VISMASK_INTERVAL", unVismaskEventInterval ) );
+		unVkDeviceIndex = static_cast< uint32_t >( ReadEnvU64( "MOCKXR_VK_DEVICE", unVkDeviceIndex ) );
+		bPacing = ReadEnvU64( "MOCKXR_NO_PACING", 0 ) == 0;
+		bLogStats = ReadEnvU64( "MOCKXR_QUIET", 0 ) == 0;
+	}
+
+	XrTime GetCurrentTime()
+	{
+		return std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now().time_since_epoch() ).count();
+	}
+
+	XrResult FillString( uint32_t unCapacity, uint32_t *pCountOutput, char *pBuffer, const std::string &sValue )
+	{
+		if ( !pCountOutput )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		*pCountOutput = static_cast< uint32_t >( sValue.size() + 1 );
+		if ( unCapacity == 0 )
+			return XR_SUCCESS;
+
+		if ( unCapacity < *pCountOutput )
+			return XR_ERROR_SIZE_INSUFFICIENT;
+
+		if ( !pBuffer )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		std::memcpy( pBuffer, sValue.c_str(), sValue.size() + 1 );
+		return XR_SUCCESS;
+	}
+
+	bool SInstance::IsExtensionEnabled( const char *pccExtensionName ) const
+	{
+		for ( auto &sExtension : vecEnabledExtensions )
+		{
+			if ( sExtension == pccExtensionName )
+				return true;
+		}
+
+		return false;
+	}
+
+	XrPath SInstance::GetOrCreatePath( const std::string &sPath )
+	{
+		auto it = mapStringToPath.find( sPath );
+		if ( it != mapStringToPath.end() )
+			return it->second;
+
+		XrPath xrPath = static_cast< XrPath >( vecPathStrings.size() );
+		vecPathStrings.push_back( sPath );
+		mapStringToPath[ sPath ] = xrPath;
+
+		return xrPath;
+	}
+
+	void QueueSessionState( SSession *pSession, XrSessionState xrState )
+	{
+		pSession->xrState = xrState;
+
+		XrEventDataSessionStateChanged event { XR_TYPE_EVENT_DATA_SESSION_STATE_CHANGED };
+		event.session = ToHandle< XrSession >( pSession );
+		event.state = xrState;
+		event.time = GetCurrentTime();
+		QueueEvent( event );
+	}
+
+	static SInstance *GetInstance( XrInstance xrInstance )
+	{
+		SInstance *pInstance = FromHandle< SInstance >( xrInstance );
+		return ( pInstance && pInstance == GetRuntime().pInstance ) ? pInstance : nullptr;
+	}
+
+	static SSession *GetSession( XrSession xrSession )
+	{
+		SSession *pSession = FromHandle< SSession >( xrSession );
+		SInstance *pInstance = GetRuntime().pInstance;
+		return ( pSession && pInstance && pInstance->pSession == pSession ) ? pSession : nullptr;
+	}
+
+	static SSpace *GetSpace( XrSpace xrSpace )
+	{
+		SSpace *pSpace = FromHandle< SSpace >( xrSpace );
+		SInstance *pInstance = GetRuntime().pInstance;
+		if ( !pSpace || !pInstance || !pInstance->pSession )
+			return nullptr;
+
+		auto &vecSpaces = pInstance->pSession->vecSpaces;
+		return std::find( vecSpaces.begin(), vecSpaces.end(), pSpace ) != vecSpaces.end() ? pSpace : nullptr;
+	}
+
+	// -------------------------------------------------------------------------------------------
+	// Instance
+	// -------------------------------------------------------------------------------------------
+
+	static XrResult XRAPI_CALL EnumerateInstanceExtensionProperties( const char *layerName, uint32_t propertyCapacityInput, uint32_t *propertyCountOutput, XrExtensionProperties *properties )
+	{
+		if ( layerName )
+			return XR_ERROR_API_LAYER_NOT_PRESENT;
+
+		const uint32_t unCount = static_cast< uint32_t >( std::size( k_pccSupportedExtensions ) );
+		std::vector< XrExtensionProperties > vecProperties( unCount, { XR_TYPE_EXTENSION_PROPERTIES } );
+		for ( uint32_t i = 0; i < unCount; i++ )
+		{
+			std::snprintf( vecProperties[ i ].extensionName, XR_MAX_EXTENSION_NAME_SIZE, "%s", k_pccSupportedExtensions[ i ] );
+			vecProperties[ i ].extensionVersion = k_unSupportedExtensionVersions[ i ];
+		}
+
+		return FillArray( propertyCapacityInput, propertyCountOutput, properties, vecProperties.data(), unCount );
+	}
+
+	static XrResult XRAPI_CALL CreateInstance( const XrInstanceCreateInfo *createInfo, XrInstance *instance )
+	{
+		if ( !createInfo || !instance || createInfo->type != XR_TYPE_INSTANCE_CREATE_INFO )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		std::scoped_lock lock( GetRuntime().mutex );
+		if ( GetRuntime().pInstance )
+			return XR_ERROR_LIMIT_REACHED;
+
+		for ( uint32_t i = 0; i < createInfo->enabledExtensionCount; i++ )
+		{
+			auto itEnd = std::end( k_pccSupportedExtensions );
+			auto it = std::find_if( std::begin( k_pccSupportedExtensions ), itEnd, [ & ]( const char *pccName ) { return std::strcmp( pccName, createInfo->enabledExtensionNames[ i ] ) == 0; } );
+
+			if ( it == itEnd )
+				return XR_ERROR_EXTENSION_NOT_PRESENT;
+		}
+
+		GetRuntime().config.LoadFromEnvironment();
+
+		SInstance *pInstance = new SInstance();
+		pInstance->sAppName = createInfo->applicationInfo.applicationName;
+		pInstance->fCurrentRefreshRate = GetRuntime().config.fRefreshRate;
+		for ( uint32_t i = 0; i < createInfo->enabledExtensionCount; i++ )
+			pInstance->vecEnabledExtensions.push_back( createInfo->enabledExtensionNames[ i ] );
+
+		GetRuntime().pInstance = pInstance;
+		*instance = ToHandle< XrInstance >( pInstance );
+
+		return XR_SUCCESS;
+	}
+
+	static XrResult XRAPI_CALL DestroyInstance( XrInstance instance )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		SInstance *pInstance = GetInstance( instance );
+		if ( !pInstance )
+			return XR_ERROR_HANDLE_INVALID;
+
+		for ( auto pAction : pInstance->vecActions )
+			delete pAction;
+
+		for ( auto pActionSet : pInstance->vecActionSets )
+			delete pActionSet;
+
+		delete pInstance;
+		GetRuntime().pInstance = nullptr;
+
+		std::scoped_lock lockEvents( GetRuntime().mutexEvents );
+		GetRuntime().queueEvents.clear();
+
+		return XR_SUCCESS;
+	}
+
+	static XrResult XRAPI_CALL GetInstanceProperties( XrInstance instance, XrInstanceProperties *instanceProperties )
+	{
+		if ( !GetInstance( instance ) )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( !instanceProperties )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		instanceProperties->runtimeVersion = MOCKXR_VERSION;
+		std::snprintf( instanceProperties->runtimeName, XR_MAX_RUNTIME_NAME_SIZE, "%s", MOCKXR_NAME );
+
+		return XR_SUCCESS;
+	}
+
+	static XrResult XRAPI_CALL PollEvent( XrInstance instance, XrEventDataBuffer *eventData )
+	{
+		if ( !GetInstance( instance ) )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( !eventData )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		std::scoped_lock lock( GetRuntime().mutexEvents );
+		if ( GetRuntime().queueEvents.empty() )
+			return XR_EVENT_UNAVAILABLE;
+
+		*eventData = GetRuntime().queueEvents.front();
+		GetRuntime().queueEvents.pop_front();
+
+		return XR_SUCCESS;
+	}
+
+	static XrResult XRAPI_CALL ResultToString( XrInstance instance, XrResult value, char buffer[ XR_MAX_RESULT_STRING_SIZE ] )
+	{
+		#define MOCKXR_RESULT_CASE( name, val ) \
+			case name: std::snprintf( buffer, XR_MAX_RESULT_STRING_SIZE, "%s", #name ); return XR_SUCCESS;
+
+		switch ( value )
+		{
+			XR_LIST_ENUM_XrResult( MOCKXR_RESULT_CASE )
+			default:
+				std::snprintf( buffer, XR_MAX_RESULT_STRING_SIZE, "%s_%d", value < 0 ? "XR_UNKNOWN_FAILURE" : "XR_UNKNOWN_SUCCESS", static_cast< int >( value ) );
+				return XR_SUCCESS;
+		}
+
+		#undef MOCKXR_RESULT_CASE
+	}
+
+	static XrResult XRAPI_CALL StructureTypeToString( XrInstance instance, XrStructureType value, char buffer[ XR_MAX_STRUCTURE_NAME_SIZE ] )
+	{
+		#define MOCKXR_STRUCTURE_CASE( name, val ) \
+			case name: std::snprintf( buffer, XR_MAX_STRUCTURE_NAME_SIZE, "%s", #name ); return XR_SUCCESS;
+
+		switch ( value )
+		{
+			XR_LIST_ENUM_XrStructureType( MOCKXR_STRUCTURE_CASE )
+			default:
+				std::snprintf( buffer, XR_MAX_STRUCTURE_NAME_SIZE, "XR_UNKNOWN_STRUCTURE_TYPE_%d", static_cast< int >( value ) );
+				return XR_SUCCESS;
+		}
+
+		#undef MOCKXR_STRUCTURE_CASE
+	}
+
+	// -------------------------------------------------------------------------------------------
+	// System
+	// -------------------------------------------------------------------------------------------
+
+	static XrResult XRAPI_CALL GetSystem( XrInstance instance, const XrSystemGetInfo *getInfo, XrSystemId *systemId )
+	{
+		if ( !GetInstance( instance ) )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( !getInfo || !systemId )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		if ( getInfo->formFactor != XR_FORM_FACTOR_HEAD_MOUNTED_DISPLAY )
+			return XR_ERROR_FORM_FACTOR_UNSUPPORTED;
+
+		*systemId = k_systemId;
+		return XR_SUCCESS;
+	}
+
+	static XrResult XRAPI_CALL GetSystemProperties( XrInstance instance, XrSystemId systemId, XrSystemProperties *properties )
+	{
+		SInstance *pInstance = GetInstance( instance );
+		if ( !pInstance )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( systemId != k_systemId )
+			return XR_ERROR_SYSTEM_INVALID;
+
+		if ( !properties )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		properties->systemId = k_systemId;
+		properties->vendorId = 0;
+		std::snprintf( properties->systemName, XR_MAX_SYSTEM_NAME_SIZE, "%s headless hmd", MOCKXR_NAME );
+		properties->graphicsProperties.maxLayerCount = XR_MIN_COMPOSITION_LAYERS_SUPPORTED;
+		properties->graphicsProperties.maxSwapchainImageWidth = 4096;
+		properties->graphicsProperties.maxSwapchainImageHeight = 4096;
+		properties->trackingProperties.orientationTracking = XR_TRUE;
+		properties->trackingProperties.positionTracking = XR_TRUE;
+
+		// Fill in the extension property structs we know about, leave everything else untouched
+		auto *pNext = reinterpret_cast< XrBaseOutStructure * >( properties->next );
+		while ( pNext )
+		{
+			if ( pNext->type == XR_TYPE_SYSTEM_HAND_TRACKING_PROPERTIES_EXT )
+				reinterpret_cast< XrSystemHandTrackingPropertiesEXT * >( pNext )->supportsHandTracking = pInstance->IsExtensionEnabled( XR_EXT_HAND_TRACKING_EXTENSION_NAME ) ? XR_TRUE : XR_FALSE;
+
+			pNext = pNext->next;
+		}
+
+		return XR_SUCCESS;
+	}
+
+	static XrResult XRAPI_CALL EnumerateEnvironmentBlendModes( XrInstance instance, XrSystemId systemId, XrViewConfigurationType viewConfigurationType, uint32_t environmentBlendModeCapacityInput, uint32_t *environmentBlendModeCountOutput, XrEnvironmentBlendMode *environmentBlendModes )
+	{
+		if ( !GetInstance( instance ) )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( viewConfigurationType != XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO )
+			return XR_ERROR_VIEW_CONFIGURATION_TYPE_UNSUPPORTED;
+
+		const XrEnvironmentBlendMode blendMode = XR_ENVIRONMENT_BLEND_MODE_OPAQUE;
+		return FillArray( environmentBlendModeCapacityInput, environmentBlendModeCountOutput, environmentBlendModes, &blendMode, 1 );
+	}
+
+	static XrResult XRAPI_CALL EnumerateViewConfigurations( XrInstance instance, XrSystemId systemId, uint32_t viewConfigurationTypeCapacityInput, uint32_t *viewConfigurationTypeCountOutput, XrViewConfigurationType *viewConfigurationTypes )
+	{
+		if ( !GetInstance( instance ) )
+			return XR_ERROR_HANDLE_INVALID;
+
+		const XrViewConfigurationType viewConfig = XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO;
+		return FillArray( viewConfigurationTypeCapacityInput, viewConfigurationTypeCountOutput, viewConfigurationTypes, &viewConfig, 1 );
+	}
+
+	static XrResult XRAPI_CALL GetViewConfigurationProperties( XrInstance instance, XrSystemId systemId, XrViewConfigurationType viewConfigurationType, XrViewConfigurationProperties *configurationProperties )
+	{
+		if ( !GetInstance( instance ) )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( viewConfigurationType != XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO )
+			return XR_ERROR_VIEW_CONFIGURATION_TYPE_UNSUPPORTED;
+
+		if ( !configurationProperties )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		configurationProperties->viewConfigurationType = viewConfigurationType;
+		configurationProperties->fovMutable = XR_FALSE;
+
+		return XR_SUCCESS;
+	}
+
+	static XrResult XRAPI_CALL EnumerateViewConfigurationViews( XrInstance instance, XrSystemId systemId, XrViewConfigurationType viewConfigurationType, uint32_t viewCapacityInput, uint32_t *viewCountOutput, XrViewConfigurationView *views )
+	{
+		if ( !GetInstance( instance ) )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( viewConfigurationType != XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO )
+			return XR_ERROR_VIEW_CONFIGURATION_TYPE_UNSUPPORTED;
+
+		const SConfig &config = GetRuntime().config;
+
+		XrViewConfigurationView view { XR_TYPE_VIEW_CONFIGURATION_VIEW };
+		view.recommendedImageRectWidth = config.unEyeWidth;
+		view.recommendedImageRectHeight = config.unEyeHeight;
+		view.maxImageRectWidth = 4096;
+		view.maxImageRectHeight = 4096;
+		view.recommendedSwapchainSampleCount = 1;
+		view.maxSwapchainSampleCount = 1;
+
+		const XrViewConfigurationView arrViews[ k_unViewCount ] = { view, view };
+		return FillArray( viewCapacityInput, viewCountOutput, views, arrViews, k_unViewCount );
+	}
+
+	// -------------------------------------------------------------------------------------------
+	// Session
+	// -------------------------------------------------------------------------------------------
+
+	static XrResult XRAPI_CALL CreateSession( XrInstance instance, const XrSessionCreateInfo *createInfo, XrSession *session )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		SInstance *pInstance = GetInstance( instance );
+		if ( !pInstance )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( !createInfo || !session )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		if ( createInfo->systemId != k_systemId )
+			return XR_ERROR_SYSTEM_INVALID;
+
+		if ( pInstance->pSession )
+			return XR_ERROR_LIMIT_REACHED;
+
+		// Look for the vulkan graphics binding (enable and enable2 share the same struct type)
+		const XrGraphicsBindingVulkanKHR *pBinding = nullptr;
+		auto *pNext = reinterpret_cast< const XrBaseInStructure * >( createInfo->next );
+		while ( pNext )
+		{
+			if ( pNext->type == XR_TYPE_GRAPHICS_BINDING_VULKAN_KHR )
+				pBinding = reinterpret_cast< const XrGraphicsBindingVulkanKHR * >( pNext );
+
+			pNext = pNext->next;
+		}
+
+		if ( !pBinding || pBinding->device == VK_NULL_HANDLE || pBinding->physicalDevice == VK_NULL_HANDLE )
+			return XR_ERROR_GRAPHICS_DEVICE_INVALID;
+
+		SSession *pSession = new SSession();
+		pSession->vkInstance = pBinding->instance;
+		pSession->vkPhysicalDevice = pBinding->physicalDevice;
+		pSession->vkDevice = pBinding->device;
+		pSession->unQueueFamilyIndex = pBinding->queueFamilyIndex;
+		pSession->unQueueIndex = pBinding->queueIndex;
+
+		pInstance->pSession = pSession;
+		*session = ToHandle< XrSession >( pSession );
+
+		// Emulate a runtime that is immediately ready to start the frame loop
+		QueueSessionState( pSession, XR_SESSION_STATE_IDLE );
+		QueueSessionState( pSession, XR_SESSION_STATE_READY );
+
+		return XR_SUCCESS;
+	}
+
+	static XrResult XRAPI_CALL DestroySession( XrSession session )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		SSession *pSession = GetSession( session );
+		if ( !pSession )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( GetRuntime().config.bLogStats && pSession->stats.unFrames > 0 )
+		{
+			const SFrameStats &stats = pSession->stats;
+			std::fprintf( stderr,
+						  "[%s] frames: %" PRIu64 " | avg wait block: %.3f ms | avg app frame: %.3f ms | action syncs: %" PRIu64 " | haptics: %" PRIu64 "\n",
+						  MOCKXR_NAME,
+						  stats.unFrames,
+						  ( stats.dWaitBlockSeconds / static_cast< double >( stats.unFrames ) ) * 1000.0,
+						  ( stats.dAppFrameSeconds / static_cast< double >( stats.unFrames ) ) * 1000.0,
+						  stats.unSyncs,
+						  stats.unHaptics );
+		}
+
+		for ( auto pSwapchain : pSession->vecSwapchains )
+		{
+			DestroySwapchainImages( pSession, pSwapchain );
+			delete pSwapchain;
+		}
+
+		for ( auto pSpace : pSession->vecSpaces )
+			delete pSpace;
+
+		for ( auto pHandTracker : pSession->vecHandTrackers )
+			delete pHandTracker;
+
+		GetRuntime().pInstance->pSession = nullptr;
+		delete pSession;
+
+		return XR_SUCCESS;
+	}
+
+	static XrResult XRAPI_CALL BeginSession( XrSession session, const XrSessionBeginInfo *beginInfo )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		SSession *pSession = GetSession( session );
+		if ( !pSession )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( !beginInfo || beginInfo->primaryViewConfigurationType != XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO )
+			return XR_ERROR_VIEW_CONFIGURATION_TYPE_UNSUPPORTED;
+
+		if ( pSession->bRunning )
+			return XR_ERROR_SESSION_RUNNING;
+
+		if ( pSession->xrState != XR_SESSION_STATE_READY )
+			return XR_ERROR_SESSION_NOT_READY;
+
+		pSession->bRunning = true;
+		pSession->lastWaitRelease = 0;
+
+		QueueSessionState( pSession, XR_SESSION_STATE_SYNCHRONIZED );
+		QueueSessionState( pSession, XR_SESSION_STATE_VISIBLE );
+		QueueSessionState( pSession, XR_SESSION_STATE_FOCUSED );
+
+		return XR_SUCCESS;
+	}
+
+	static XrResult XRAPI_CALL EndSession( XrSession session )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		SSession *pSession = GetSession( session );
+		if ( !pSession )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( !pSession->bRunning )
+			return XR_ERROR_SESSION_NOT_RUNNING;
+
+		if ( pSession->xrState != XR_SESSION_STATE_STOPPING )
+			return XR_ERROR_SESSION_NOT_STOPPING;
+
+		pSession->bRunning = false;
+		QueueSessionState( pSession, XR_SESSION_STATE_IDLE );
+
+		if ( pSession->bExitRequested )
+			QueueSessionState( pSession, XR_SESSION_STATE_EXITING );
+
+		return XR_SUCCESS;
+	}
+
+	static void RequestExit( SSession *pSession )
+	{
+		if ( pSession->bExitRequested )
+			return;
+
+		pSession->bExitRequested = true;
+
+		if ( pSession->xrState == XR_SESSION_STATE_FOCUSED )
+			QueueSessionState( pSession, XR_SESSION_STATE_VISIBLE );
+
+		if ( pSession->xrState == XR_SESSION_STATE_VISIBLE )
+			QueueSessionState( pSession, XR_SESSION_STATE_SYNCHRONIZED );
+
+		QueueSessionState( pSession, XR_SESSION_STATE_STOPPING );
+	}
+
+	static XrResult XRAPI_CALL RequestExitSession( XrSession session )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		SSession *pSession = GetSession( session );
+		if ( !pSession )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( !pSession->bRunning )
+			return XR_ERROR_SESSION_NOT_RUNNING;
+
+		RequestExit( pSession );
+		return XR_SUCCESS;
+	}
+
+	// -------------------------------------------------------------------------------------------
+	// Frame loop
+	// -------------------------------------------------------------------------------------------
+
+	static XrResult XRAPI_CALL WaitFrame( XrSession session, const XrFrameWaitInfo *frameWaitInfo, XrFrameState *frameState )
+	{
+		SSession *pSession = nullptr;
+		XrTime period = 0;
+		XrTime target = 0;
+		bool bPacing = true;
+		{
+			std::scoped_lock lock( GetRuntime().mutex );
+			pSession = GetSession( session );
+			if ( !pSession )
+				return XR_ERROR_HANDLE_INVALID;
+
+			if ( !frameState )
+				return XR_ERROR_VALIDATION_FAILURE;
+
+			if ( !pSession->bRunning )
+				return XR_ERROR_SESSION_NOT_RUNNING;
+
+			period = static_cast< XrTime >( 1e9 / static_cast< double >( GetRuntime().pInstance->fCurrentRefreshRate ) );
+			bPacing = GetRuntime().config.bPacing;
+
+			const XrTime now = GetCurrentTime();
+			target = pSession->lastWaitRelease == 0 ? now : pSession->lastWaitRelease + period;
+
+			// Never accumulate debt if the app missed a vsync, snap to the next interval instead
+			if ( target < now && pSession->lastWaitRelease != 0 )
+				target += ( ( now - target ) / period ) * period;
+		}
+
+		// Block outside the lock so other threads (e.g. input) can keep calling into the runtime
+		const XrTime waitStart = GetCurrentTime();
+		if ( bPacing && target > waitStart )
+			std::this_thread::sleep_for( std::chrono::nanoseconds( target - waitStart ) );
+
+		std::scoped_lock lock( GetRuntime().mutex );
+		const XrTime now = GetCurrentTime();
+		pSession->lastWaitRelease = bPacing ? std::max( target, waitStart ) : now;
+		pSession->stats.dWaitBlockSeconds += ToSeconds( now - waitStart );
+
+		frameState->predictedDisplayPeriod = period;
+		frameState->predictedDisplayTime = pSession->lastWaitRelease + period;
+		frameState->shouldRender = ( pSession->xrState == XR_SESSION_STATE_VISIBLE || pSession->xrState == XR_SESSION_STATE_FOCUSED ) ? XR_TRUE : XR_FALSE;
+
+		return XR_SUCCESS;
+	}
+
+	static XrResult XRAPI_CALL BeginFrame( XrSession session, const XrFrameBeginInfo *frameBeginInfo )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		SSession *pSession = GetSession( session );
+		if ( !pSession )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( !pSession->bRunning )
+			return XR_ERROR_SESSION_NOT_RUNNING;
+
+		pSession->lastBeginTime = GetCurrentTime();
+
+		// A begin without a matching end discards the previous frame
+		XrResult xrResult = pSession->bFrameBegun ? XR_FRAME_DISCARDED : XR_SUCCESS;
+		pSession->bFrameBegun = true;
+
+		return xrResult;
+	}
+
+	static XrResult XRAPI_CALL EndFrame( XrSession session, const XrFrameEndInfo *frameEndInfo )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		SSession *pSession = GetSession( session );
+		if ( !pSession )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( !frameEndInfo )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		if ( !pSession->bRunning )
+			return XR_ERROR_SESSION_NOT_RUNNING;
+
+		if ( !pSession->bFrameBegun )
+			return XR_ERROR_CALL_ORDER_INVALID;
+
+		if ( frameEndInfo->displayTime <= 0 )
+			return XR_ERROR_TIME_INVALID;
+
+		if ( frameEndInfo->environmentBlendMode != XR_ENVIRONMENT_BLEND_MODE_OPAQUE )
+			return XR_ERROR_ENVIRONMENT_BLEND_MODE_UNSUPPORTED;
+
+		if ( frameEndInfo->layerCount > XR_MIN_COMPOSITION_LAYERS_SUPPORTED )
+			return XR_ERROR_LAYER_LIMIT_EXCEEDED;
+
+		pSession->bFrameBegun = false;
+		pSession->stats.dAppFrameSeconds += ToSeconds( GetCurrentTime() - pSession->lastBeginTime );
+		pSession->stats.unFrames++;
+
+		const SConfig &config = GetRuntime().config;
+
+		// Emulate a runtime updating the hidden area mesh (e.g. ipd change)
+		if ( config.unVismaskEventInterval > 0 && ( pSession->stats.unFrames % config.unVismaskEventInterval ) == 0 && GetRuntime().pInstance->IsExtensionEnabled( XR_KHR_VISIBILITY_MASK_EXTENSION_NAME ) )
+		{
+			pSession->unVismaskGeneration++;
+			for ( uint32_t i = 0; i < k_unViewCount; i++ )
+			{
+				XrEventDataVisibilityMaskChangedKHR event { XR_TYPE_EVENT_DATA_VISIBILITY_MASK_CHANGED_KHR };
+				event.session = session;
+				event.viewConfigurationType = XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO;
+				event.viewIndex = i;
+				QueueEvent( event );
+			}
+		}
+
+		if ( config.unExitAfterFrames > 0 && pSession->stats.unFrames >= config.unExitAfterFrames )
+			RequestExit( pSession );
+
+		return XR_SUCCESS;
+	}
+
+	// -------------------------------------------------------------------------------------------
+	// Spaces and views
+	// -------------------------------------------------------------------------------------------
+
+	static XrResult XRAPI_CALL EnumerateReferenceSpaces( XrSession session, uint32_t spaceCapacityInput, uint32_t *spaceCountOutput, XrReferenceSpaceType *spaces )
+	{
+		if ( !GetSession( session ) )
+			return XR_ERROR_HANDLE_INVALID;
+
+		const XrReferenceSpaceType arrSpaces[] = { XR_REFERENCE_SPACE_TYPE_VIEW, XR_REFERENCE_SPACE_TYPE_LOCAL, XR_REFERENCE_SPACE_TYPE_STAGE };
+		return FillArray( spaceCapacityInput, spaceCountOutput, spaces, arrSpaces, static_cast< uint32_t >( std::size( arrSpaces ) ) );
+	}
+
+	static XrResult XRAPI_CALL CreateReferenceSpace( XrSession session, const XrReferenceSpaceCreateInfo *createInfo, XrSpace *space )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		SSession *pSession = GetSession( session );
+		if ( !pSession )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( !createInfo || !space )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		if ( createInfo->referenceSpaceType != XR_REFERENCE_SPACE_TYPE_VIEW && createInfo->referenceSpaceType != XR_REFERENCE_SPACE_TYPE_LOCAL && createInfo->referenceSpaceType != XR_REFERENCE_SPACE_TYPE_STAGE )
+			return XR_ERROR_REFERENCE_SPACE_UNSUPPORTED;
+
+		SSpace *pSpace = new SSpace();
+		pSpace->eKind = SSpace::EKind::Reference;
+		pSpace->xrReferenceSpaceType = createInfo->referenceSpaceType;
+		pSpace->offset = createInfo->poseInReferenceSpace;
+
+		pSession->vecSpaces.push_back( pSpace );
+		*space = ToHandle< XrSpace >( pSpace );
+
+		return XR_SUCCESS;
+	}
+
+	static XrResult XRAPI_CALL GetReferenceSpaceBoundsRect( XrSession session, XrReferenceSpaceType referenceSpaceType, XrExtent2Df *bounds )
+	{
+		if ( !GetSession( session ) )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( !bounds )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		if ( referenceSpaceType != XR_REFERENCE_SPACE_TYPE_STAGE )
+		{
+			*bounds = { 0.0f, 0.0f };
+			return XR_SPACE_BOUNDS_UNAVAILABLE;
+		}
+
+		*bounds = { 5.0f, 5.0f };
+		return XR_SUCCESS;
+	}
+
+	static XrResult XRAPI_CALL DestroySpace( XrSpace space )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		SSpace *pSpace = GetSpace( space );
+		if ( !pSpace )
+			return XR_ERROR_HANDLE_INVALID;
+
+		auto &vecSpaces = GetRuntime().pInstance->pSession->vecSpaces;
+		vecSpaces.erase( std::remove( vecSpaces.begin(), vecSpaces.end(), pSpace ), vecSpaces.end() );
+		delete pSpace;
+
+		return XR_SUCCESS;
+	}
+
+	static XrResult XRAPI_CALL LocateSpace( XrSpace space, XrSpace baseSpace, XrTime time, XrSpaceLocation *location )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		SSpace *pSpace = GetSpace( space );
+		SSpace *pBaseSpace = GetSpace( baseSpace );
+		if ( !pSpace || !pBaseSpace )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( !location )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		if ( time <= 0 )
+			return XR_ERROR_TIME_INVALID;
+
+		// Inactive pose actions can't be located
+		if ( pSpace->eKind == SSpace::EKind::Action && !pSpace->pAction->states[ pSpace->unSubactionSlot ].isActive )
+		{
+			location->locationFlags = 0;
+			return XR_SUCCESS;
+		}
+
+		location->pose = PoseMultiply( PoseInverse( GetSpacePose( pBaseSpace, time ) ), GetSpacePose( pSpace, time ) );
+		location->locationFlags = XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_POSITION_VALID_BIT | XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT | XR_SPACE_LOCATION_POSITION_TRACKED_BIT;
+
+		return XR_SUCCESS;
+	}
+
+	static XrResult XRAPI_CALL LocateViews( XrSession session, const XrViewLocateInfo *viewLocateInfo, XrViewState *viewState, uint32_t viewCapacityInput, uint32_t *viewCountOutput, XrView *views )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		if ( !GetSession( session ) )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( !viewLocateInfo || !viewState || !viewCountOutput )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		if ( viewLocateInfo->viewConfigurationType != XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO )
+			return XR_ERROR_VIEW_CONFIGURATION_TYPE_UNSUPPORTED;
+
+		SSpace *pBaseSpace = GetSpace( viewLocateInfo->space );
+		if ( !pBaseSpace )
+			return XR_ERROR_HANDLE_INVALID;
+
+		*viewCountOutput = k_unViewCount;
+		if ( viewCapacityInput == 0 )
+			return XR_SUCCESS;
+
+		if ( viewCapacityInput < k_unViewCount )
+			return XR_ERROR_SIZE_INSUFFICIENT;
+
+		const XrPosef headInBase = PoseMultiply( PoseInverse( GetSpacePose( pBaseSpace, viewLocateInfo->displayTime ) ), GetHeadPose( viewLocateInfo->displayTime ) );
+		const float fHalfIpd = 0.032f;
+
+		for ( uint32_t i = 0; i < k_unViewCount; i++ )
+		{
+			XrPosef eyeInHead { { 0.0f, 0.0f, 0.0f, 1.0f }, { i == 0 ? -fHalfIpd : fHalfIpd, 0.0f, 0.0f } };
+			views[ i ].pose = PoseMultiply( headInBase, eyeInHead );
+
+			// Slightly asymmetric frustums, as with most lens designs
+			const float fInner = 0.75f;
+			const float fOuter = 0.82f;
+			views[ i ].fov.angleLeft = -( i == 0 ? fOuter : fInner );
+			views[ i ].fov.angleRight = ( i == 0 ? fInner : fOuter );
+			views[ i ].fov.angleUp = 0.8f;
+			views[ i ].fov.angleDown = -0.85f;
+		}
+
+		viewState->viewStateFlags = XR_VIEW_STATE_ORIENTATION_VALID_BIT | XR_VIEW_STATE_POSITION_VALID_BIT | XR_VIEW_STATE_ORIENTATION_TRACKED_BIT | XR_VIEW_STATE_POSITION_TRACKED_BIT;
+		return XR_SUCCESS;
+	}
+
+	// -------------------------------------------------------------------------------------------
+	// XR_KHR_visibility_mask
+	// -------------------------------------------------------------------------------------------
+
+	void GenerateHiddenMesh( uint32_t unViewIndex, uint32_t unGeneration, std::vector< XrVector2f > &outVertices, std::vector< uint32_t > &outIndices )
+	{
+		outVertices.clear();
+		outIndices.clear();
+
+		// One triangle per corner of the tangent-space frustum, alternating size per generation to emulate a mask update
+		const float fCut = ( unGeneration % 2 ) == 0 ? 0.35f : 0.45f;
+		const float arrSigns[ 4 ][ 2 ] = { { -1.0f, 1.0f }, { -1.0f, -1.0f }, { 1.0f, -1.0f }, { 1.0f, 1.0f } };
+
+		for ( uint32_t i = 0; i < 4; i++ )
+		{
+			const float fX = arrSigns[ i ][ 0 ];
+			const float fY = arrSigns[ i ][ 1 ];
+
+			// The nasal side of each eye is hidden a bit more
+			const bool bNasal = ( unViewIndex == 0 && fX > 0.0f ) || ( unViewIndex == 1 && fX < 0.0f );
+			const float fExtent = bNasal ? fCut * 1.2f : fCut;
+
+			const uint32_t unBase = static_cast< uint32_t >( outVertices.size() );
+			outVertices.push_back( { fX, fY } );
+			outVertices.push_back( { fX * ( 1.0f - fExtent ), fY } );
+			outVertices.push_back( { fX, fY * ( 1.0f - fExtent ) } );
+
+			// Keep counter-clockwise winding regardless of the quadrant
+			if ( fX * fY > 0.0f )
+				outIndices.insert( outIndices.end(), { unBase, unBase + 2, unBase + 1 } );
+			else
+				outIndices.insert( outIndices.end(), { unBase, unBase + 1, unBase + 2 } );
+		}
+	}
+
+	static XrResult XRAPI_CALL GetVisibilityMaskKHR( XrSession session, XrViewConfigurationType viewConfigurationType, uint32_t viewIndex, XrVisibilityMaskTypeKHR visibilityMaskType, XrVisibilityMaskKHR *visibilityMask )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		SSession *pSession = GetSession( session );
+		if ( !pSession )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( !visibilityMask )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		if ( viewConfigurationType != XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO )
+			return XR_ERROR_VIEW_CONFIGURATION_TYPE_UNSUPPORTED;
+
+		if ( viewIndex >= k_unViewCount )
+			return XR_ERROR_INDEX_OUT_OF_RANGE;
+
+		std::vector< XrVector2f > vecVertices;
+		std::vector< uint32_t > vecIndices;
+
+		if ( visibilityMaskType == XR_VISIBILITY_MASK_TYPE_HIDDEN_TRIANGLE_MESH_KHR )
+		{
+			GenerateHiddenMesh( viewIndex, pSession->unVismaskGeneration, vecVertices, vecIndices );
+		}
+		else if ( visibilityMaskType == XR_VISIBILITY_MASK_TYPE_VISIBLE_TRIANGLE_MESH_KHR )
+		{
+			vecVertices = { { -1.0f, -1.0f }, { 1.0f, -1.0f }, { 1.0f, 1.0f }, { -1.0f, 1.0f } };
+			vecIndices = { 0, 1, 2, 0, 2, 3 };
+		}
+		else if ( visibilityMaskType == XR_VISIBILITY_MASK_TYPE_LINE_LOOP_KHR )
+		{
+			vecVertices = { { -1.0f, -1.0f }, { 1.0f, -1.0f }, { 1.0f, 1.0f }, { -1.0f, 1.0f } };
+			vecIndices = { 0, 1, 2, 3 };
+		}
+		else
+		{
+			return XR_ERROR_VALIDATION_FAILURE;
+		}
+
+		visibilityMask->vertexCountOutput = static_cast< uint32_t >( vecVertices.size() );
+		visibilityMask->indexCountOutput = static_cast< uint32_t >( vecIndices.size() );
+
+		if ( visibilityMask->vertexCapacityInput == 0 && visibilityMask->indexCapacityInput == 0 )
+			return XR_SUCCESS;
+
+		if ( visibilityMask->vertexCapacityInput < vecVertices.size() || visibilityMask->indexCapacityInput < vecIndices.size() )
+			return XR_ERROR_SIZE_INSUFFICIENT;
+
+		std::memcpy( visibilityMask->vertices, vecVertices.data(), vecVertices.size() * sizeof( XrVector2f ) );
+		std::memcpy( visibilityMask->indices, vecIndices.data(), vecIndices.size() * sizeof( uint32_t ) );
+
+		return XR_SUCCESS;
+	}
+
+	// -------------------------------------------------------------------------------------------
+	// XR_FB_display_refresh_rate
+	// -------------------------------------------------------------------------------------------
+
+	static XrResult XRAPI_CALL EnumerateDisplayRefreshRatesFB( XrSession session, uint32_t displayRefreshRateCapacityInput, uint32_t *displayRefreshRateCountOutput, float *displayRefreshRates )
+	{
+		if ( !GetSession( session ) )
+			return XR_ERROR_HANDLE_INVALID;
+
+		const auto &vecRates = GetRuntime().config.vecSupportedRates;
+		return FillArray( displayRefreshRateCapacityInput, displayRefreshRateCountOutput, displayRefreshRates, vecRates.data(), static_cast< uint32_t >( vecRates.size() ) );
+	}
+
+	static XrResult XRAPI_CALL GetDisplayRefreshRateFB( XrSession session, float *displayRefreshRate )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		if ( !GetSession( session ) )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( !displayRefreshRate )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		*displayRefreshRate = GetRuntime().pInstance->fCurrentRefreshRate;
+		return XR_SUCCESS;
+	}
+
+	static XrResult XRAPI_CALL RequestDisplayRefreshRateFB( XrSession session, float displayRefreshRate )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		if ( !GetSession( session ) )
+			return XR_ERROR_HANDLE_INVALID;
+
+		SInstance *pInstance = GetRuntime().pInstance;
+		const auto &vecRates = GetRuntime().config.vecSupportedRates;
+
+		// Zero means "runtime default"
+		if ( displayRefreshRate == 0.0f )
+			displayRefreshRate = GetRuntime().config.fRefreshRate;
+
+		if ( std::find( vecRates.begin(), vecRates.end(), displayRefreshRate ) == vecRates.end() )
+			return XR_ERROR_DISPLAY_REFRESH_RATE_UNSUPPORTED_FB;
+
+		if ( displayRefreshRate == pInstance->fCurrentRefreshRate )
+			return XR_SUCCESS;
+
+		XrEventDataDisplayRefreshRateChangedFB event { XR_TYPE_EVENT_DATA_DISPLAY_REFRESH_RATE_CHANGED_FB };
+		event.fromDisplayRefreshRate = pInstance->fCurrentRefreshRate;
+		event.toDisplayRefreshRate = displayRefreshRate;
+		QueueEvent( event );
+
+		pInstance->fCurrentRefreshRate = displayRefreshRate;
+		return XR_SUCCESS;
+	}
+
+	// -------------------------------------------------------------------------------------------
+	// Function table
+	// -------------------------------------------------------------------------------------------
+
+	// Defined in mock_input.cpp and mock_vulkan.cpp
+	XrResult XRAPI_CALL StringToPath( XrInstance, const char *, XrPath * );
+	XrResult XRAPI_CALL PathToString( XrInstance, XrPath, uint32_t, uint32_t *, char * );
+	XrResult XRAPI_CALL CreateActionSet( XrInstance, const XrActionSetCreateInfo *, XrActionSet * );
+	XrResult XRAPI_CALL DestroyActionSet( XrActionSet );
+	XrResult XRAPI_CALL CreateAction( XrActionSet, const XrActionCreateInfo *, XrAction * );
+	XrResult XRAPI_CALL DestroyAction( XrAction );
+	XrResult XRAPI_CALL SuggestInteractionProfileBindings( XrInstance, const XrInteractionProfileSuggestedBinding * );
+	XrResult XRAPI_CALL AttachSessionActionSets( XrSession, const XrSessionActionSetsAttachInfo * );
+	XrResult XRAPI_CALL GetCurrentInteractionProfile( XrSession, XrPath, XrInteractionProfileState * );
+	XrResult XRAPI_CALL GetActionStateBoolean( XrSession, const XrActionStateGetInfo *, XrActionStateBoolean * );
+	XrResult XRAPI_CALL GetActionStateFloat( XrSession, const XrActionStateGetInfo *, XrActionStateFloat * );
+	XrResult XRAPI_CALL GetActionStateVector2f( XrSession, const XrActionStateGetInfo *, XrActionStateVector2f * );
+	XrResult XRAPI_CALL GetActionStatePose( XrSession, const XrActionStateGetInfo *, XrActionStatePose * );
+	XrResult XRAPI_CALL SyncActions( XrSession, const XrActionsSyncInfo * );
+	XrResult XRAPI_CALL EnumerateBoundSourcesForAction( XrSession, const XrBoundSourcesForActionEnumerateInfo *, uint32_t, uint32_t *, XrPath * );
+	XrResult XRAPI_CALL GetInputSourceLocalizedName( XrSession, const XrInputSourceLocalizedNameGetInfo *, uint32_t, uint32_t *, char * );
+	XrResult XRAPI_CALL CreateActionSpace( XrSession, const XrActionSpaceCreateInfo *, XrSpace * );
+	XrResult XRAPI_CALL ApplyHapticFeedback( XrSession, const XrHapticActionInfo *, const XrHapticBaseHeader * );
+	XrResult XRAPI_CALL StopHapticFeedback( XrSession, const XrHapticActionInfo * );
+	XrResult XRAPI_CALL CreateHandTrackerEXT( XrSession, const XrHandTrackerCreateInfoEXT *, XrHandTrackerEXT * );
+	XrResult XRAPI_CALL DestroyHandTrackerEXT( XrHandTrackerEXT );
+	XrResult XRAPI_CALL LocateHandJointsEXT( XrHandTrackerEXT, const XrHandJointsLocateInfoEXT *, XrHandJointLocationsEXT * );
+
+	XrResult XRAPI_CALL GetVulkanInstanceExtensionsKHR( XrInstance, XrSystemId, uint32_t, uint32_t *, char * );
+	XrResult XRAPI_CALL GetVulkanDeviceExtensionsKHR( XrInstance, XrSystemId, uint32_t, uint32_t *, char * );
+	XrResult XRAPI_CALL GetVulkanGraphicsDeviceKHR( XrInstance, XrSystemId, VkInstance, VkPhysicalDevice * );
+	XrResult XRAPI_CALL GetVulkanGraphicsRequirementsKHR( XrInstance, XrSystemId, XrGraphicsRequirementsVulkanKHR * );
+	XrResult XRAPI_CALL CreateVulkanInstanceKHR( XrInstance, const XrVulkanInstanceCreateInfoKHR *, VkInstance *, VkResult * );
+	XrResult XRAPI_CALL CreateVulkanDeviceKHR( XrInstance, const XrVulkanDeviceCreateInfoKHR *, VkDevice *, VkResult * );
+	XrResult XRAPI_CALL GetVulkanGraphicsDevice2KHR( XrInstance, const XrVulkanGraphicsDeviceGetInfoKHR *, VkPhysicalDevice * );
+	XrResult XRAPI_CALL EnumerateSwapchainFormats( XrSession, uint32_t, uint32_t *, int64_t * );
+	XrResult XRAPI_CALL CreateSwapchain( XrSession, const XrSwapchainCreateInfo *, XrSwapchain * );
+	XrResult XRAPI_CALL DestroySwapchain( XrSwapchain );
+	XrResult XRAPI_CALL EnumerateSwapchainImages( XrSwapchain, uint32_t, uint32_t *, XrSwapchainImageBaseHeader * );
+	XrResult XRAPI_CALL AcquireSwapchainImage( XrSwapchain, const XrSwapchainImageAcquireInfo *, uint32_t * );
+	XrResult XRAPI_CALL WaitSwapchainImage( XrSwapchain, const XrSwapchainImageWaitInfo * );
+	XrResult XRAPI_CALL ReleaseSwapchainImage( XrSwapchain, const XrSwapchainImageReleaseInfo * );
+
+	static XrResult XRAPI_CALL GetInstanceProcAddr( XrInstance instance, const char *name, PFN_xrVoidFunction *function );
+
+	struct SFunctionEntry
+	{
+		const char *pccName;
+		PFN_xrVoidFunction pfnFunction;
+		const char *pccExtension;
+	};
+
+	#define MOCKXR_ENTRY( name, ext ) { "xr" #name, reinterpret_cast< PFN_xrVoidFunction >( name ), ext }
+
+	static const SFunctionEntry k_functionTable[] = {
+		MOCKXR_ENTRY( GetInstanceProcAddr, nullptr ),
+		MOCKXR_ENTRY( EnumerateInstanceExtensionProperties, nullptr ),
+		MOCKXR_ENTRY( CreateInstance, nullptr ),
+		MOCKXR_ENTRY( DestroyInstance, nullptr ),
+		MOCKXR_ENTRY( GetInstanceProperties, nullptr ),
+		MOCKXR_ENTRY( PollEvent, nullptr ),
+		MOCKXR_ENTRY( ResultToString, nullptr ),
+		MOCKXR_ENTRY( StructureTypeToString, nullptr ),
+		MOCKXR_ENTRY( GetSystem, nullptr ),
+		MOCKXR_ENTRY( GetSystemProperties, nullptr ),
+		MOCKXR_ENTRY( EnumerateEnvironmentBlendModes, nullptr ),
+		MOCKXR_ENTRY( CreateSession, nullptr ),
+		MOCKXR_ENTRY( DestroySession, nullptr ),
+		MOCKXR_ENTRY( EnumerateReferenceSpaces, nullptr ),
+		MOCKXR_ENTRY( CreateReferenceSpace, nullptr ),
+		MOCKXR_ENTRY( GetReferenceSpaceBoundsRect, nullptr ),
+		MOCKXR_ENTRY( CreateActionSpace, nullptr ),
+		MOCKXR_ENTRY( LocateSpace, nullptr ),
+		MOCKXR_ENTRY( DestroySpace, nullptr ),
+		MOCKXR_ENTRY( EnumerateViewConfigurations, nullptr ),
+		MOCKXR_ENTRY( GetViewConfigurationProperties, nullptr ),
+		MOCKXR_ENTRY( EnumerateViewConfigurationViews, nullptr ),
+		MOCKXR_ENTRY( EnumerateSwapchainFormats, nullptr ),
+		MOCKXR_ENTRY( CreateSwapchain, nullptr ),
+		MOCKXR_ENTRY( DestroySwapchain, nullptr ),
+		MOCKXR_ENTRY( EnumerateSwapchainImages, nullptr ),
+		MOCKXR_ENTRY( AcquireSwapchainImage, nullptr ),
+		MOCKXR_ENTRY( WaitSwapchainImage, nullptr ),
+		MOCKXR_ENTRY( ReleaseSwapchainImage, nullptr ),
+		MOCKXR_ENTRY( BeginSession, nullptr ),
+		MOCKXR_ENTRY( EndSession, nullptr ),
+		MOCKXR_ENTRY( RequestExitSession, nullptr ),
+		MOCKXR_ENTRY( WaitFrame, nullptr ),
+		MOCKXR_ENTRY( BeginFrame, nullptr ),
+		MOCKXR_ENTRY( EndFrame, nullptr ),
+		MOCKXR_ENTRY( LocateViews, nullptr ),
+		MOCKXR_ENTRY( StringToPath, nullptr ),
+		MOCKXR_ENTRY( PathToString, nullptr ),
+		MOCKXR_ENTRY( CreateActionSet, nullptr ),
+		MOCKXR_ENTRY( DestroyActionSet, nullptr ),
+		MOCKXR_ENTRY( CreateAction, nullptr ),
+		MOCKXR_ENTRY( DestroyAction, nullptr ),
+		MOCKXR_ENTRY( SuggestInteractionProfileBindings, nullptr ),
+		MOCKXR_ENTRY( AttachSessionActionSets, nullptr ),
+		MOCKXR_ENTRY( GetCurrentInteractionProfile, nullptr ),
+		MOCKXR_ENTRY( GetActionStateBoolean, nullptr ),
+		MOCKXR_ENTRY( GetActionStateFloat, nullptr ),
+		MOCKXR_ENTRY( GetActionStateVector2f, nullptr ),
+		MOCKXR_ENTRY( GetActionStatePose, nullptr ),
+		MOCKXR_ENTRY( SyncActions, nullptr ),
+		MOCKXR_ENTRY( EnumerateBoundSourcesForAction, nullptr ),
+		MOCKXR_ENTRY( GetInputSourceLocalizedName, nullptr ),
+		MOCKXR_ENTRY( ApplyHapticFeedback, nullptr ),
+		MOCKXR_ENTRY( StopHapticFeedback, nullptr ),
+
+		MOCKXR_ENTRY( GetVulkanInstanceExtensionsKHR, XR_KHR_VULKAN_ENABLE_EXTENSION_NAME ),
+		MOCKXR_ENTRY( GetVulkanDeviceExtensionsKHR, XR_KHR_VULKAN_ENABLE_EXTENSION_NAME ),
+		MOCKXR_ENTRY( GetVulkanGraphicsDeviceKHR, XR_KHR_VULKAN_ENABLE_EXTENSION_NAME ),
+		MOCKXR_ENTRY( GetVulkanGraphicsRequirementsKHR, XR_KHR_VULKAN_ENABLE_EXTENSION_NAME ),
+		MOCKXR_ENTRY( CreateVulkanInstanceKHR, XR_KHR_VULKAN_ENABLE2_EXTENSION_NAME ),
+		MOCKXR_ENTRY( CreateVulkanDeviceKHR, XR_KHR_VULKAN_ENABLE2_EXTENSION_NAME ),
+		MOCKXR_ENTRY( GetVulkanGraphicsDevice2KHR, XR_KHR_VULKAN_ENABLE2_EXTENSION_NAME ),
+		{ "xrGetVulkanGraphicsRequirements2KHR", reinterpret_cast< PFN_xrVoidFunction >( GetVulkanGraphicsRequirementsKHR ), XR_KHR_VULKAN_ENABLE2_EXTENSION_NAME },
+
+		MOCKXR_ENTRY( GetVisibilityMaskKHR, XR_KHR_VISIBILITY_MASK_EXTENSION_NAME ),
+
+		MOCKXR_ENTRY( CreateHandTrackerEXT, XR_EXT_HAND_TRACKING_EXTENSION_NAME ),
+		MOCKXR_ENTRY( DestroyHandTrackerEXT, XR_EXT_HAND_TRACKING_EXTENSION_NAME ),
+		MOCKXR_ENTRY( LocateHandJointsEXT, XR_EXT_HAND_TRACKING_EXTENSION_NAME ),
+
+		MOCKXR_ENTRY( EnumerateDisplayRefreshRatesFB, XR_FB_DISPLAY_REFRESH_RATE_EXTENSION_NAME ),
+		MOCKXR_ENTRY( GetDisplayRefreshRateFB, XR_FB_DISPLAY_REFRESH_RATE_EXTENSION_NAME ),
+		MOCKXR_ENTRY( RequestDisplayRefreshRateFB, XR_FB_DISPLAY_REFRESH_RATE_EXTENSION_NAME ),
+	};
+
+	#undef MOCKXR_ENTRY
+
+	PFN_xrVoidFunction GetFunction( const char *pccName, SInstance *pInstance )
+	{
+		for ( auto &entry : k_functionTable )
+		{
+			if ( std::strcmp( entry.pccName, pccName ) != 0 )
+				continue;
+
+			// Extension functions are only exposed if the app enabled the extension
+			if ( entry.pccExtension && ( !pInstance || !pInstance->IsExtensionEnabled( entry.pccExtension ) ) )
+				return nullptr;
+
+			return entry.pfnFunction;
+		}
+
+		return nullptr;
+	}
+
+	static XrResult XRAPI_CALL GetInstanceProcAddr( XrInstance instance, const char *name, PFN_xrVoidFunction *function )
+	{
+		if ( !name || !function )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		*function = nullptr;
+
+		// Only these are valid to query without an instance
+		if ( instance == XR_NULL_HANDLE )
+		{
+			if ( std::strcmp( name, "xrEnumerateInstanceExtensionProperties" ) != 0 && std::strcmp( name, "xrEnumerateApiLayerProperties" ) != 0 && std::strcmp( name, "xrCreateInstance" ) != 0 )
+				return XR_ERROR_HANDLE_INVALID;
+
+			*function = GetFunction( name, nullptr );
+			return *function ? XR_SUCCESS : XR_ERROR_FUNCTION_UNSUPPORTED;
+		}
+
+		SInstance *pInstance = GetInstance( instance );
+		if ( !pInstance )
+			return XR_ERROR_HANDLE_INVALID;
+
+		*function = GetFunction( name, pInstance );
+		return *function ? XR_SUCCESS : XR_ERROR_FUNCTION_UNSUPPORTED;
+	}
+
+} // namespace mockxr
+
+MOCKXR_EXPORT XrResult XRAPI_CALL xrNegotiateLoaderRuntimeInterface( const XrNegotiateLoaderInfo *loaderInfo, XrNegotiateRuntimeRequest *runtimeRequest )
+{
+	if ( !loaderInfo || !runtimeRequest || loaderInfo->structType != XR_LOADER_INTERFACE_STRUCT_LOADER_INFO || loaderInfo->structVersion != XR_LOADER_INFO_STRUCT_VERSION || loaderInfo->structSize != sizeof( XrNegotiateLoaderInfo ) )
+		return XR_ERROR_INITIALIZATION_FAILED;
+
+	if ( runtimeRequest->structType != XR_LOADER_INTERFACE_STRUCT_RUNTIME_REQUEST || runtimeRequest->structVersion != XR_RUNTIME_INFO_STRUCT_VERSION || runtimeRequest->structSize != sizeof( XrNegotiateRuntimeRequest ) )
+		return XR_ERROR_INITIALIZATION_FAILED;
+
+	if ( loaderInfo->minInterfaceVersion > XR_CURRENT_LOADER_RUNTIME_VERSION || loaderInfo->maxInterfaceVersion < XR_CURRENT_LOADER_RUNTIME_VERSION )
+		return XR_ERROR_INITIALIZATION_FAILED;
+
+	if ( loaderInfo->minApiVersion > XR_CURRENT_API_VERSION || loaderInfo->maxApiVersion < XR_MAKE_VERSION( 1, 0, 0 ) )
+		return XR_ERROR_INITIALIZATION_FAILED;
+
+	runtimeRequest->runtimeInterfaceVersion = XR_CURRENT_LOADER_RUNTIME_VERSION;
+	runtimeRequest->runtimeApiVersion = XR_CURRENT_API_VERSION;
+	runtimeRequest->getInstanceProcAddr = reinterpret_cast< PFN_xrGetInstanceProcAddr >( mockxr::GetFunction( "xrGetInstanceProcAddr", nullptr ) );
+
+	return XR_SUCCESS;
+}
@@ -0,0 +1,272 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifndef XR_USE_GRAPHICS_API_VULKAN
+	#define XR_USE_GRAPHICS_API_VULKAN
+#endif
+
+// The runtime is loaded by the openxr loader, never link against it
+#ifndef XR_NO_PROTOTYPES
+	#define XR_NO_PROTOTYPES
+#endif
+
+#include <vulkan/vulkan.h>
+#include <openxr/openxr.h>
+#include <openxr/openxr_platform.h>
+#include <openxr/openxr_loader_negotiation.h>
+
+#if defined( _WIN32 )
+	#define MOCKXR_EXPORT extern "C" __declspec( dllexport )
+#else
+	#define MOCKXR_EXPORT extern "C" __attribute__( ( visibility( "default" ) ) )
+#endif
+
+#define MOCKXR_NAME "mockxr"
+#define MOCKXR_VERSION XR_MAKE_VERSION( 1, 0, 0 )
+
+#define MOCKXR_RETURN_ON_ERROR( expr )     \
+	{                                      \
+		XrResult xrResultCheck = ( expr ); \
+		if ( XR_FAILED( xrResultCheck ) )  \
+			return xrResultCheck;          \
+	}
+
+/// Headless stand-in OpenXR runtime.
+/// Load it through the openxr loader by pointing XR_RUNTIME_JSON to the generated mockxr.json manifest.
+/// Behavior is configured through environment variables (see SConfig::LoadFromEnvironment).
+namespace mockxr
+{
+	static constexpr uint32_t k_unViewCount = 2;
+	static constexpr uint32_t k_unSwapchainImageCount = 3;
+	static constexpr uint32_t k_unMaxSubactionSlots = 2;
+	static constexpr XrSystemId k_systemId = 1;
+
+	struct SConfig
+	{
+		float fRefreshRate = 90.0f;					// MOCKXR_REFRESH_RATE - initial display refresh rate (hz)
+		uint32_t unEyeWidth = 1024;					// MOCKXR_EYE_WIDTH - recommended swapchain width per eye
+		uint32_t unEyeHeight = 1024;				// MOCKXR_EYE_HEIGHT - recommended swapchain height per eye
+		uint64_t unExitAfterFrames = 0;				// MOCKXR_EXIT_AFTER_FRAMES - request session exit after n frames (0 = never)
+		uint32_t unVismaskEventInterval = 0;		// MOCKXR_VISMASK_INTERVAL - fire vismask changed events every n frames (0 = never)
+		uint32_t unVkDeviceIndex = 0;				// MOCKXR_VK_DEVICE - physical device index to hand to the app
+		bool bPacing = true;						// MOCKXR_NO_PACING=1 - xrWaitFrame returns immediately instead of pacing to the refresh rate
+		bool bLogStats = true;						// MOCKXR_QUIET=1 - suppress the frame stats summary on session destroy
+
+		std::vector< float > vecSupportedRates = { 72.0f, 90.0f, 120.0f };
+
+		void LoadFromEnvironment();
+	};
+
+	struct SAction
+	{
+		XrActionType xrActionType = XR_ACTION_TYPE_MAX_ENUM;
+		XrActionSet xrActionSet = XR_NULL_HANDLE;
+		std::vector< XrPath > vecSubactionPaths;
+
+		struct SState
+		{
+			float current = 0.0f;
+			float previous = 0.0f;
+			XrVector2f currentVec2 { 0.0f, 0.0f };
+			XrVector2f previousVec2 { 0.0f, 0.0f };
+			XrTime lastChangeTime = 0;
+			bool isActive = false;
+		};
+
+		std::array< SState, k_unMaxSubactionSlots > states {};
+	};
+
+	struct SActionSet
+	{
+		std::string sName;
+		std::vector< SAction * > vecActions;
+	};
+
+	struct SSpace
+	{
+		enum class EKind
+		{
+			Reference,
+			Action
+		} eKind = EKind::Reference;
+
+		XrReferenceSpaceType xrReferenceSpaceType = XR_REFERENCE_SPACE_TYPE_STAGE;
+		SAction *pAction = nullptr;
+		uint32_t unSubactionSlot = 0;
+		XrPosef offset { { 0.0f, 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, 0.0f } };
+	};
+
+	struct SSwapchain
+	{
+		XrSwapchainCreateInfo createInfo { XR_TYPE_SWAPCHAIN_CREATE_INFO };
+		std::vector< VkImage > vecImages;
+		std::vector< VkDeviceMemory > vecMemory;
+		uint32_t unNextImage = 0;
+	};
+
+	struct SHandTracker
+	{
+		XrHandEXT xrHand = XR_HAND_LEFT_EXT;
+	};
+
+	struct SFrameStats
+	{
+		uint64_t unFrames = 0;
+		uint64_t unHaptics = 0;
+		uint64_t unSyncs = 0;
+		double dWaitBlockSeconds = 0.0;
+		double dAppFrameSeconds = 0.0;
+	};
+
+	struct SSession
+	{
+		XrSessionState xrState = XR_SESSION_STATE_UNKNOWN;
+		bool bRunning = false;
+		bool bExitRequested = false;
+		bool bFrameBegun = false;
+
+		VkInstance vkInstance = VK_NULL_HANDLE;
+		VkPhysicalDevice vkPhysicalDevice = VK_NULL_HANDLE;
+		VkDevice vkDevice = VK_NULL_HANDLE;
+		uint32_t unQueueFamilyIndex = 0;
+		uint32_t unQueueIndex = 0;
+
+		XrTime lastWaitRelease = 0;
+		XrTime lastBeginTime = 0;
+		uint32_t unVismaskGeneration = 0;
+
+		std::vector< SSpace * > vecSpaces;
+		std::vector< SSwapchain * > vecSwapchains;
+		std::vector< SHandTracker * > vecHandTrackers;
+		std::vector< SActionSet * > vecAttachedActionSets;
+		std::vector< SActionSet * > vecActiveActionSets;
+
+		SFrameStats stats;
+	};
+
+	struct SInstance
+	{
+		std::vector< std::string > vecEnabledExtensions;
+		std::string sAppName;
+
+		std::unordered_map< std::string, XrPath > mapStringToPath;
+		std::vector< std::string > vecPathStrings { "" }; // XR_NULL_PATH is index 0
+
+		std::vector< SActionSet * > vecActionSets;
+		std::vector< SAction * > vecActions;
+		std::vector< XrPath > vecSuggestedProfiles;
+
+		SSession *pSession = nullptr;
+		float fCurrentRefreshRate = 90.0f;
+
+		bool IsExtensionEnabled( const char *pccExtensionName ) const;
+		XrPath GetOrCreatePath( const std::string &sPath );
+	};
+
+	/// Global runtime state - the mock supports a single instance and session at a time
+	struct SRuntime
+	{
+		std::recursive_mutex mutex;
+		SConfig config;
+		SInstance *pInstance = nullptr;
+
+		std::mutex mutexEvents;
+		std::deque< XrEventDataBuffer > queueEvents;
+	};
+
+	SRuntime &GetRuntime();
+
+	// Time
+	XrTime GetCurrentTime();
+	inline double ToSeconds( XrTime xrTime ) { return static_cast< double >( xrTime ) * 1e-9; }
+
+	// Events
+	template< typename T > void QueueEvent( const T &event )
+	{
+		static_assert( sizeof( T ) <= sizeof( XrEventDataBuffer ) );
+
+		XrEventDataBuffer buffer { XR_TYPE_EVENT_DATA_BUFFER };
+		std::memcpy( &buffer, &event, sizeof( T ) );
+
+		std::scoped_lock lock( GetRuntime().mutexEvents );
+		GetRuntime().queueEvents.push_back( buffer );
+	}
+
+	void QueueSessionState( SSession *pSession, XrSessionState xrState );
+
+	// Math helpers
+	XrQuaternionf QuatMultiply( const XrQuaternionf &a, const XrQuaternionf &b );
+	XrQuaternionf QuatFromAxisAngle( const XrVector3f &axis, float fRadians );
+	XrVector3f QuatRotate( const XrQuaternionf &q, const XrVector3f &v );
+	XrPosef PoseMultiply( const XrPosef &parent, const XrPosef &child );
+	XrPosef PoseInverse( const XrPosef &pose );
+
+	// Synthetic tracking (all poses are in stage space)
+	XrPosef GetHeadPose( XrTime xrTime );
+	XrPosef GetHandPose( uint32_t unHand, XrTime xrTime );
+	XrPosef GetSpacePose( const SSpace *pSpace, XrTime xrTime );
+	uint32_t GetSubactionSlot( SInstance *pInstance, XrPath xrSubactionPath );
+	void SampleActionStates( SSession *pSession, XrTime xrTime );
+
+	// Visibility mask
+	void GenerateHiddenMesh( uint32_t unViewIndex, uint32_t unGeneration, std::vector< XrVector2f > &outVertices, std::vector< uint32_t > &outIndices );
+
+	// Vulkan
+	bool IsSwapchainFormatSupported( SSession *pSession, int64_t format );
+	XrResult CreateSwapchainImages( SSession *pSession, SSwapchain *pSwapchain );
+	void DestroySwapchainImages( SSession *pSession, SSwapchain *pSwapchain );
+
+	// Two-call idiom helper
+	template< typename T > XrResult FillArray( uint32_t unCapacity, uint32_t *pCountOutput, T *pOutput, const T *pSource, uint32_t unSourceCount )
+	{
+		if ( !pCountOutput )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		*pCountOutput = unSourceCount;
+		if ( unCapacity == 0 )
+			return XR_SUCCESS;
+
+		if ( unCapacity < unSourceCount )
+			return XR_ERROR_SIZE_INSUFFICIENT;
+
+		if ( !pOutput )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		for ( uint32_t i = 0; i < unSourceCount; i++ )
+			pOutput[ i ] = pSource[ i ];
+
+		return XR_SUCCESS;
+	}
+
+	XrResult FillString( uint32_t unCapacity, uint32_t *pCountOutput, char *pBuffer, const std::string &sValue );
+
+	// Handle conversion
+	template< typename TObject, typename THandle > TObject *FromHandle( THandle handle ) { return reinterpret_cast< TObject * >( handle ); }
+	template< typename THandle, typename TObject > THandle ToHandle( TObject *pObject ) { return reinterpret_cast< THandle >( pObject ); }
+
+	// Function table lookup (mock_runtime.cpp)
+	PFN_xrVoidFunction GetFunction( const char *pccName, SInstance *pInstance );
+
+} // namespace mockxr
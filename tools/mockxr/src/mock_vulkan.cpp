@@ -0,0 +1,468 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+
+#include <mock_runtime.hpp>
+
+#include <algorithm>
+
+namespace mockxr
+{
+	// Formats offered to the app, in order of preference
+	static constexpr int64_t k_arrCandidateFormats[] = {
+		VK_FORMAT_R8G8B8A8_SRGB,
+		VK_FORMAT_B8G8R8A8_SRGB,
+		VK_FORMAT_R8G8B8A8_UNORM,
+		VK_FORMAT_B8G8R8A8_UNORM,
+		VK_FORMAT_D32_SFLOAT,
+		VK_FORMAT_D24_UNORM_S8_UINT,
+		VK_FORMAT_D16_UNORM,
+	};
+
+	static bool IsDepthFormat( int64_t format )
+	{
+		return format == VK_FORMAT_D32_SFLOAT || format == VK_FORMAT_D24_UNORM_S8_UINT || format == VK_FORMAT_D16_UNORM;
+	}
+
+	static SSwapchain *GetSwapchain( XrSwapchain xrSwapchain )
+	{
+		SSwapchain *pSwapchain = FromHandle< SSwapchain >( xrSwapchain );
+		SInstance *pInstance = GetRuntime().pInstance;
+		if ( !pSwapchain || !pInstance || !pInstance->pSession )
+			return nullptr;
+
+		auto &vecSwapchains = pInstance->pSession->vecSwapchains;
+		return std::find( vecSwapchains.begin(), vecSwapchains.end(), pSwapchain ) != vecSwapchains.end() ? pSwapchain : nullptr;
+	}
+
+	static SSession *GetSession( XrSession xrSession )
+	{
+		SSession *pSession = FromHandle< SSession >( xrSession );
+		SInstance *pInstance = GetRuntime().pInstance;
+		return ( pSession && pInstance && pInstance->pSession == pSession ) ? pSession : nullptr;
+	}
+
+	static VkPhysicalDevice SelectPhysicalDevice( VkInstance vkInstance )
+	{
+		uint32_t unCount = 0;
+		if ( vkEnumeratePhysicalDevices( vkInstance, &unCount, nullptr ) != VK_SUCCESS || unCount == 0 )
+			return VK_NULL_HANDLE;
+
+		std::vector< VkPhysicalDevice > vecDevices( unCount );
+		vkEnumeratePhysicalDevices( vkInstance, &unCount, vecDevices.data() );
+
+		const uint32_t unIndex = GetRuntime().config.unVkDeviceIndex;
+		return vecDevices[ unIndex < unCount ? unIndex : 0 ];
+	}
+
+	// -------------------------------------------------------------------------------------------
+	// XR_KHR_vulkan_enable
+	// -------------------------------------------------------------------------------------------
+
+	XrResult XRAPI_CALL GetVulkanInstanceExtensionsKHR( XrInstance instance, XrSystemId systemId, uint32_t bufferCapacityInput, uint32_t *bufferCountOutput, char *buffer )
+	{
+		if ( systemId != k_systemId )
+			return XR_ERROR_SYSTEM_INVALID;
+
+		// Nothing to present to, so no surface extensions are required
+		return FillString( bufferCapacityInput, bufferCountOutput, buffer, "" );
+	}
+
+	XrResult XRAPI_CALL GetVulkanDeviceExtensionsKHR( XrInstance instance, XrSystemId systemId, uint32_t bufferCapacityInput, uint32_t *bufferCountOutput, char *buffer )
+	{
+		if ( systemId != k_systemId )
+			return XR_ERROR_SYSTEM_INVALID;
+
+		return FillString( bufferCapacityInput, bufferCountOutput, buffer, "" );
+	}
+
+	XrResult XRAPI_CALL GetVulkanGraphicsDeviceKHR( XrInstance instance, XrSystemId systemId, VkInstance vkInstance, VkPhysicalDevice *vkPhysicalDevice )
+	{
+		if ( systemId != k_systemId )
+			return XR_ERROR_SYSTEM_INVALID;
+
+		if ( !vkPhysicalDevice || vkInstance == VK_NULL_HANDLE )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		*vkPhysicalDevice = SelectPhysicalDevice( vkInstance );
+		return *vkPhysicalDevice == VK_NULL_HANDLE ? XR_ERROR_RUNTIME_FAILURE : XR_SUCCESS;
+	}
+
+	XrResult XRAPI_CALL GetVulkanGraphicsRequirementsKHR( XrInstance instance, XrSystemId systemId, XrGraphicsRequirementsVulkanKHR *graphicsRequirements )
+	{
+		if ( systemId != k_systemId )
+			return XR_ERROR_SYSTEM_INVALID;
+
+		if ( !graphicsRequirements )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		graphicsRequirements->minApiVersionSupported = XR_MAKE_VERSION( 1, 0, 0 );
+		graphicsRequirements->maxApiVersionSupported = XR_MAKE_VERSION( 1, 3, 0 );
+
+		return XR_SUCCESS;
+	}
+
+	// -------------------------------------------------------------------------------------------
+	// XR_KHR_vulkan_enable2
+	// -------------------------------------------------------------------------------------------
+
+	XrResult XRAPI_CALL CreateVulkanInstanceKHR( XrInstance instance, const XrVulkanInstanceCreateInfoKHR *createInfo, VkInstance *vulkanInstance, VkResult *vulkanResult )
+	{
+		if ( !createInfo || !vulkanInstance || !vulkanResult || !createInfo->pfnGetInstanceProcAddr )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		if ( createInfo->systemId != k_systemId )
+			return XR_ERROR_SYSTEM_INVALID;
+
+		auto pfnCreateInstance = reinterpret_cast< PFN_vkCreateInstance >( createInfo->pfnGetInstanceProcAddr( VK_NULL_HANDLE, "vkCreateInstance" ) );
+		*vulkanResult = pfnCreateInstance( createInfo->vulkanCreateInfo, createInfo->vulkanAllocator, vulkanInstance );
+
+		return XR_SUCCESS;
+	}
+
+	XrResult XRAPI_CALL CreateVulkanDeviceKHR( XrInstance instance, const XrVulkanDeviceCreateInfoKHR *createInfo, VkDevice *vulkanDevice, VkResult *vulkanResult )
+	{
+		if ( !createInfo || !vulkanDevice || !vulkanResult || !createInfo->pfnGetInstanceProcAddr )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		if ( createInfo->systemId != k_systemId )
+			return XR_ERROR_SYSTEM_INVALID;
+
+		auto pfnCreateDevice = reinterpret_cast< PFN_vkCreateDevice >( createInfo->pfnGetInstanceProcAddr( VK_NULL_HANDLE, "vkCreateDevice" ) );
+		*vulkanResult = pfnCreateDevice( createInfo->vulkanPhysicalDevice, createInfo->vulkanCreateInfo, createInfo->vulkanAllocator, vulkanDevice );
+
+		return XR_SUCCESS;
+	}
+
+	XrResult XRAPI_CALL GetVulkanGraphicsDevice2KHR( XrInstance instance, const XrVulkanGraphicsDeviceGetInfoKHR *getInfo, VkPhysicalDevice *vulkanPhysicalDevice )
+	{
+		if ( !getInfo )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		return GetVulkanGraphicsDeviceKHR( instance, getInfo->systemId, getInfo->vulkanInstance, vulkanPhysicalDevice );
+	}
+
+	// -------------------------------------------------------------------------------------------
+	// Swapchains
+	// -------------------------------------------------------------------------------------------
+
+	bool IsSwapchainFormatSupported( SSession *pSession, int64_t format )
+	{
+		VkFormatProperties vkFormatProperties {};
+		vkGetPhysicalDeviceFormatProperties( pSession->vkPhysicalDevice, static_cast< VkFormat >( format ), &vkFormatProperties );
+
+		const VkFormatFeatureFlags requiredFeatures = IsDepthFormat( format ) ? VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT : VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT;
+		return ( vkFormatProperties.optimalTilingFeatures & requiredFeatures ) == requiredFeatures;
+	}
+
+	static uint32_t FindMemoryType( SSession *pSession, uint32_t unTypeBits, VkMemoryPropertyFlags requiredFlags )
+	{
+		VkPhysicalDeviceMemoryProperties vkMemoryProperties {};
+		vkGetPhysicalDeviceMemoryProperties( pSession->vkPhysicalDevice, &vkMemoryProperties );
+
+		for ( uint32_t i = 0; i < vkMemoryProperties.memoryTypeCount; i++ )
+		{
+			if ( ( unTypeBits & ( 1u << i ) ) && ( vkMemoryProperties.memoryTypes[ i ].propertyFlags & requiredFlags ) == requiredFlags )
+				return i;
+		}
+
+		return UINT32_MAX;
+	}
+
+	static VkImageUsageFlags ToVkUsage( XrSwapchainUsageFlags xrUsage )
+	{
+		VkImageUsageFlags vkUsage = 0;
+		if ( xrUsage & XR_SWAPCHAIN_USAGE_COLOR_ATTACHMENT_BIT )
+			vkUsage |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+		if ( xrUsage & XR_SWAPCHAIN_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT )
+			vkUsage |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+		if ( xrUsage & XR_SWAPCHAIN_USAGE_UNORDERED_ACCESS_BIT )
+			vkUsage |= VK_IMAGE_USAGE_STORAGE_BIT;
+		if ( xrUsage & XR_SWAPCHAIN_USAGE_TRANSFER_SRC_BIT )
+			vkUsage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+		if ( xrUsage & XR_SWAPCHAIN_USAGE_TRANSFER_DST_BIT )
+			vkUsage |= VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+		if ( xrUsage & XR_SWAPCHAIN_USAGE_SAMPLED_BIT )
+			vkUsage |= VK_IMAGE_USAGE_SAMPLED_BIT;
+		if ( xrUsage & XR_SWAPCHAIN_USAGE_INPUT_ATTACHMENT_BIT )
+			vkUsage |= VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT;
+
+		return vkUsage;
+	}
+
+	// Real runtimes hand out images already in the attachment layout, so do a one-time transition here
+	static VkResult TransitionImages( SSession *pSession, SSwapchain *pSwapchain, bool bDepth )
+	{
+		VkQueue vkQueue = VK_NULL_HANDLE;
+		vkGetDeviceQueue( pSession->vkDevice, pSession->unQueueFamilyIndex, pSession->unQueueIndex, &vkQueue );
+
+		VkCommandPoolCreateInfo poolInfo { VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+		poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+		poolInfo.queueFamilyIndex = pSession->unQueueFamilyIndex;
+
+		VkCommandPool vkPool = VK_NULL_HANDLE;
+		VkResult vkResult = vkCreateCommandPool( pSession->vkDevice, &poolInfo, nullptr, &vkPool );
+		if ( vkResult != VK_SUCCESS )
+			return vkResult;
+
+		VkCommandBufferAllocateInfo allocInfo { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+		allocInfo.commandPool = vkPool;
+		allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		allocInfo.commandBufferCount = 1;
+
+		VkCommandBuffer vkCmd = VK_NULL_HANDLE;
+		vkResult = vkAllocateCommandBuffers( pSession->vkDevice, &allocInfo, &vkCmd );
+		if ( vkResult == VK_SUCCESS )
+		{
+			VkCommandBufferBeginInfo beginInfo { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+			beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+			vkBeginCommandBuffer( vkCmd, &beginInfo );
+
+			std::vector< VkImageMemoryBarrier > vecBarriers;
+			for ( VkImage vkImage : pSwapchain->vecImages )
+			{
+				VkImageMemoryBarrier barrier { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
+				barrier.srcAccessMask = 0;
+				barrier.dstAccessMask = bDepth ? VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT : VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+				barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+				barrier.newLayout = bDepth ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL : VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+				barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+				barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+				barrier.image = vkImage;
+				barrier.subresourceRange.aspectMask = bDepth ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_COLOR_BIT;
+				barrier.subresourceRange.levelCount = pSwapchain->createInfo.mipCount;
+				barrier.subresourceRange.layerCount = pSwapchain->createInfo.arraySize;
+
+				if ( pSwapchain->createInfo.format == VK_FORMAT_D24_UNORM_S8_UINT )
+					barrier.subresourceRange.aspectMask |= VK_IMAGE_ASPECT_STENCIL_BIT;
+
+				vecBarriers.push_back( barrier );
+			}
+
+			vkCmdPipelineBarrier( vkCmd,
+								  VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+								  bDepth ? VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT : VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+								  0,
+								  0,
+								  nullptr,
+								  0,
+								  nullptr,
+								  static_cast< uint32_t >( vecBarriers.size() ),
+								  vecBarriers.data() );
+
+			vkEndCommandBuffer( vkCmd );
+
+			VkSubmitInfo submitInfo { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+			submitInfo.commandBufferCount = 1;
+			submitInfo.pCommandBuffers = &vkCmd;
+
+			vkResult = vkQueueSubmit( vkQueue, 1, &submitInfo, VK_NULL_HANDLE );
+			if ( vkResult == VK_SUCCESS )
+				vkResult = vkQueueWaitIdle( vkQueue );
+		}
+
+		vkDestroyCommandPool( pSession->vkDevice, vkPool, nullptr );
+		return vkResult;
+	}
+
+	XrResult CreateSwapchainImages( SSession *pSession, SSwapchain *pSwapchain )
+	{
+		const XrSwapchainCreateInfo &createInfo = pSwapchain->createInfo;
+		const bool bDepth = IsDepthFormat( createInfo.format );
+
+		VkImageCreateInfo imageInfo { VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO };
+		imageInfo.imageType = VK_IMAGE_TYPE_2D;
+		imageInfo.format = static_cast< VkFormat >( createInfo.format );
+		imageInfo.extent = { createInfo.width, createInfo.height, 1 };
+		imageInfo.mipLevels = createInfo.mipCount;
+		imageInfo.arrayLayers = createInfo.arraySize;
+		imageInfo.samples = static_cast< VkSampleCountFlagBits >( createInfo.sampleCount );
+		imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+		imageInfo.usage = ToVkUsage( createInfo.usageFlags );
+		imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+		imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+		if ( createInfo.usageFlags & XR_SWAPCHAIN_USAGE_MUTABLE_FORMAT_BIT )
+			imageInfo.flags |= VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT;
+
+		for ( uint32_t i = 0; i < k_unSwapchainImageCount; i++ )
+		{
+			VkImage vkImage = VK_NULL_HANDLE;
+			if ( vkCreateImage( pSession->vkDevice, &imageInfo, nullptr, &vkImage ) != VK_SUCCESS )
+				return XR_ERROR_RUNTIME_FAILURE;
+
+			pSwapchain->vecImages.push_back( vkImage );
+
+			VkMemoryRequirements vkRequirements {};
+			vkGetImageMemoryRequirements( pSession->vkDevice, vkImage, &vkRequirements );
+
+			VkMemoryAllocateInfo allocInfo { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+			allocInfo.allocationSize = vkRequirements.size;
+			allocInfo.memoryTypeIndex = FindMemoryType( pSession, vkRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT );
+
+			if ( allocInfo.memoryTypeIndex == UINT32_MAX )
+				allocInfo.memoryTypeIndex = FindMemoryType( pSession, vkRequirements.memoryTypeBits, 0 );
+
+			VkDeviceMemory vkMemory = VK_NULL_HANDLE;
+			if ( allocInfo.memoryTypeIndex == UINT32_MAX || vkAllocateMemory( pSession->vkDevice, &allocInfo, nullptr, &vkMemory ) != VK_SUCCESS )
+				return XR_ERROR_RUNTIME_FAILURE;
+
+			pSwapchain->vecMemory.push_back( vkMemory );
+
+			if ( vkBindImageMemory( pSession->vkDevice, vkImage, vkMemory, 0 ) != VK_SUCCESS )
+				return XR_ERROR_RUNTIME_FAILURE;
+		}
+
+		return TransitionImages( pSession, pSwapchain, bDepth ) == VK_SUCCESS ? XR_SUCCESS : XR_ERROR_RUNTIME_FAILURE;
+	}
+
+	void DestroySwapchainImages( SSession *pSession, SSwapchain *pSwapchain )
+	{
+		if ( pSession->vkDevice == VK_NULL_HANDLE )
+			return;
+
+		// The app may still have work in flight that references these images
+		vkDeviceWaitIdle( pSession->vkDevice );
+
+		for ( VkImage vkImage : pSwapchain->vecImages )
+			vkDestroyImage( pSession->vkDevice, vkImage, nullptr );
+
+		for ( VkDeviceMemory vkMemory : pSwapchain->vecMemory )
+			vkFreeMemory( pSession->vkDevice, vkMemory, nullptr );
+
+		pSwapchain->vecImages.clear();
+		pSwapchain->vecMemory.clear();
+	}
+
+	XrResult XRAPI_CALL EnumerateSwapchainFormats( XrSession session, uint32_t formatCapacityInput, uint32_t *formatCountOutput, int64_t *formats )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		SSession *pSession = GetSession( session );
+		if ( !pSession )
+			return XR_ERROR_HANDLE_INVALID;
+
+		std::vector< int64_t > vecFormats;
+		for ( int64_t format : k_arrCandidateFormats )
+		{
+			if ( IsSwapchainFormatSupported( pSession, format ) )
+				vecFormats.push_back( format );
+		}
+
+		return FillArray( formatCapacityInput, formatCountOutput, formats, vecFormats.data(), static_cast< uint32_t >( vecFormats.size() ) );
+	}
+
+	XrResult XRAPI_CALL CreateSwapchain( XrSession session, const XrSwapchainCreateInfo *createInfo, XrSwapchain *swapchain )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		SSession *pSession = GetSession( session );
+		if ( !pSession )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( !createInfo || !swapchain || createInfo->width == 0 || createInfo->height == 0 || createInfo->arraySize == 0 || createInfo->mipCount == 0 || createInfo->faceCount != 1 )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		if ( std::find( std::begin( k_arrCandidateFormats ), std::end( k_arrCandidateFormats ), createInfo->format ) == std::end( k_arrCandidateFormats ) || !IsSwapchainFormatSupported( pSession, createInfo->format ) )
+			return XR_ERROR_SWAPCHAIN_FORMAT_UNSUPPORTED;
+
+		SSwapchain *pSwapchain = new SSwapchain();
+		pSwapchain->createInfo = *createInfo;
+		pSwapchain->createInfo.next = nullptr;
+		pSwapchain->createInfo.sampleCount = std::max( 1u, createInfo->sampleCount );
+
+		XrResult xrResult = CreateSwapchainImages( pSession, pSwapchain );
+		if ( XR_FAILED( xrResult ) )
+		{
+			DestroySwapchainImages( pSession, pSwapchain );
+			delete pSwapchain;
+			return xrResult;
+		}
+
+		pSession->vecSwapchains.push_back( pSwapchain );
+		*swapchain = ToHandle< XrSwapchain >( pSwapchain );
+
+		return XR_SUCCESS;
+	}
+
+	XrResult XRAPI_CALL DestroySwapchain( XrSwapchain swapchain )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		SSwapchain *pSwapchain = GetSwapchain( swapchain );
+		if ( !pSwapchain )
+			return XR_ERROR_HANDLE_INVALID;
+
+		SSession *pSession = GetRuntime().pInstance->pSession;
+		DestroySwapchainImages( pSession, pSwapchain );
+
+		auto &vecSwapchains = pSession->vecSwapchains;
+		vecSwapchains.erase( std::remove( vecSwapchains.begin(), vecSwapchains.end(), pSwapchain ), vecSwapchains.end() );
+		delete pSwapchain;
+
+		return XR_SUCCESS;
+	}
+
+	XrResult XRAPI_CALL EnumerateSwapchainImages( XrSwapchain swapchain, uint32_t imageCapacityInput, uint32_t *imageCountOutput, XrSwapchainImageBaseHeader *images )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		SSwapchain *pSwapchain = GetSwapchain( swapchain );
+		if ( !pSwapchain )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( !imageCountOutput )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		const uint32_t unCount = static_cast< uint32_t >( pSwapchain->vecImages.size() );
+		*imageCountOutput = unCount;
+		if ( imageCapacityInput == 0 )
+			return XR_SUCCESS;
+
+		if ( imageCapacityInput < unCount )
+			return XR_ERROR_SIZE_INSUFFICIENT;
+
+		if ( !images || images->type != XR_TYPE_SWAPCHAIN_IMAGE_VULKAN_KHR )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		auto *pVulkanImages = reinterpret_cast< XrSwapchainImageVulkanKHR * >( images );
+		for ( uint32_t i = 0; i < unCount; i++ )
+			pVulkanImages[ i ].image = pSwapchain->vecImages[ i ];
+
+		return XR_SUCCESS;
+	}
+
+	XrResult XRAPI_CALL AcquireSwapchainImage( XrSwapchain swapchain, const XrSwapchainImageAcquireInfo *acquireInfo, uint32_t *index )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		SSwapchain *pSwapchain = GetSwapchain( swapchain );
+		if ( !pSwapchain )
+			return XR_ERROR_HANDLE_INVALID;
+
+		if ( !index )
+			return XR_ERROR_VALIDATION_FAILURE;
+
+		*index = pSwapchain->unNextImage;
+		pSwapchain->unNextImage = ( pSwapchain->unNextImage + 1 ) % static_cast< uint32_t >( pSwapchain->vecImages.size() );
+
+		return XR_SUCCESS;
+	}
+
+	XrResult XRAPI_CALL WaitSwapchainImage( XrSwapchain swapchain, const XrSwapchainImageWaitInfo *waitInfo )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		return GetSwapchain( swapchain ) ? XR_SUCCESS : XR_ERROR_HANDLE_INVALID;
+	}
+
+	XrResult XRAPI_CALL ReleaseSwapchainImage( XrSwapchain swapchain, const XrSwapchainImageReleaseInfo *releaseInfo )
+	{
+		std::scoped_lock lock( GetRuntime().mutex );
+		return GetSwapchain( swapchain ) ? XR_SUCCESS : XR_ERROR_HANDLE_INVALID;
+	}
+
+} // namespace mockxr
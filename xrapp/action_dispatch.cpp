@@ -0,0 +1,223 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+
+
+#include <action_dispatch.hpp>
+
+namespace xrapp
+{
+	void CActionDispatcher::AddActionSet( SActionSet *pActionSet, XrPath subactionPath )
+	{
+		m_vecActiveActionSets.push_back( { pActionSet->xrActionSetHandle, subactionPath } );
+	}
+
+	bool CActionDispatcher::Add( SAction *pAction, void *pContext, ActionFn fnCallback, EActionDispatch eDispatch )
+	{
+		if ( !pAction || pAction->xrActionHandle == XR_NULL_HANDLE || pAction->xrActionType == XR_ACTION_TYPE_VIBRATION_OUTPUT )
+			return false;
+
+		// One state per subaction path, or a single state for actions created without any
+		const uint32_t unStateCount = pAction->vecSubactionpaths.empty() ? 1 : static_cast< uint32_t >( pAction->vecSubactionpaths.size() );
+		if ( pAction->vecActionStates.size() < unStateCount )
+			pAction->vecActionStates.resize( unStateCount );
+
+		for ( uint32_t i = 0; i < unStateCount; i++ )
+		{
+			SActionEntry &entry = m_vecEntries.emplace_back();
+			entry.pAction = pAction;
+			entry.unActionStateIndex = i;
+			entry.xrActionType = pAction->xrActionType;
+			entry.getInfo.action = pAction->xrActionHandle;
+			entry.getInfo.subactionPath = pAction->vecSubactionpaths.empty() ? XR_NULL_PATH : pAction->vecSubactionpaths[ i ];
+			entry.fnCallback = fnCallback;
+			entry.pContext = pContext;
+			entry.eDispatch = eDispatch;
+		}
+
+		// Worst case every state changes in the same sync
+		m_vecStates.resize( m_vecEntries.size() );
+		m_vecChanged.reserve( m_vecEntries.size() );
+		m_vecPending.reserve( m_vecEntries.size() );
+		m_stats.unStates = static_cast< uint32_t >( m_vecEntries.size() );
+
+		return true;
+	}
+
+	XrResult CActionDispatcher::Sync( XrSession xrSession )
+	{
+		m_vecChanged.clear();
+		m_vecPending.clear();
+		m_stats.unChanged = m_stats.unCallbacks = 0;
+
+		if ( m_vecActiveActionSets.empty() )
+			return XR_SUCCESS;
+
+		// (1) Read every state - from the replay when there is one, from the runtime otherwise (recording what it returned)
+		const uint32_t unStateCount = static_cast< uint32_t >( m_vecStates.size() );
+		if ( m_pCapture && m_pCapture->BIsReplaying() && m_pCapture->Capture( ECaptureStream::ActionStates, m_vecStates.data(), unStateCount ) )
+		{
+			WriteStates();
+		}
+		else
+		{
+			XrResult xrResult = QueryStates( xrSession );
+			if ( !XR_SUCCEEDED( xrResult ) )
+				return xrResult;
+
+			if ( m_pCapture && m_pCapture->BIsRecording() )
+				m_pCapture->Capture( ECaptureStream::ActionStates, m_vecStates.data(), unStateCount );
+		}
+
+		// (2) Record the states that changed. Activity changes count for every type, a state that goes inactive is reported once.
+		for ( uint32_t i = 0; i < static_cast< uint32_t >( m_vecEntries.size() ); i++ )
+		{
+			SActionEntry &entry = m_vecEntries[ i ];
+			const SCapturedActionState &state = m_vecStates[ i ];
+
+			const bool bActive = state.unFlags & SCapturedActionState::k_unActive;
+			const bool bChanged = ( ( state.unFlags & SCapturedActionState::k_unChanged ) && bActive ) || bActive != entry.bWasActive;
+			const bool bCall = bChanged || ( entry.eDispatch == EActionDispatch::WhileActive && bActive );
+			entry.bWasActive = bActive;
+
+			if ( bChanged )
+				m_vecChanged.push_back( { entry.pAction, entry.unActionStateIndex } );
+
+			if ( bCall && entry.fnCallback )
+				m_vecPending.push_back( i );
+		}
+
+		// (3) Dispatch
+		for ( uint32_t unEntry : m_vecPending )
+		{
+			const SActionEntry &entry = m_vecEntries[ unEntry ];
+			entry.fnCallback( entry.pContext, entry.pAction, entry.unActionStateIndex );
+		}
+
+		m_stats.unChanged = static_cast< uint32_t >( m_vecChanged.size() );
+		m_stats.unCallbacks = static_cast< uint32_t >( m_vecPending.size() );
+
+		return XR_SUCCESS;
+	}
+
+	XrResult CActionDispatcher::QueryStates( XrSession xrSession )
+	{
+		// Returns XR_SESSION_NOT_FOCUSED when the app doesn't have input focus, states are then all inactive
+		XrActionsSyncInfo syncInfo { XR_TYPE_ACTIONS_SYNC_INFO };
+		syncInfo.countActiveActionSets = static_cast< uint32_t >( m_vecActiveActionSets.size() );
+		syncInfo.activeActionSets = m_vecActiveActionSets.data();
+
+		XrResult xrResult = xrSyncActions( xrSession, &syncInfo );
+		if ( !XR_SUCCEEDED( xrResult ) )
+			return xrResult;
+
+		// Query every state straight into its action
+		for ( size_t i = 0; i < m_vecEntries.size(); i++ )
+		{
+			SActionEntry &entry = m_vecEntries[ i ];
+			SCapturedActionState &state = m_vecStates[ i ];
+			auto &actionState = entry.pAction->vecActionStates[ entry.unActionStateIndex ];
+
+			XrBool32 bActive = XR_FALSE;
+			XrBool32 bChanged = XR_FALSE;
+			switch ( entry.xrActionType )
+			{
+				case XR_ACTION_TYPE_BOOLEAN_INPUT:
+					actionState.stateBoolean = { XR_TYPE_ACTION_STATE_BOOLEAN };
+					xrResult = xrGetActionStateBoolean( xrSession, &entry.getInfo, &actionState.stateBoolean );
+					bActive = actionState.stateBoolean.isActive;
+					bChanged = actionState.stateBoolean.changedSinceLastSync;
+					state.fValue[ 0 ] = actionState.stateBoolean.currentState ? 1.f : 0.f;
+					break;
+
+				case XR_ACTION_TYPE_FLOAT_INPUT:
+					actionState.stateFloat = { XR_TYPE_ACTION_STATE_FLOAT };
+					xrResult = xrGetActionStateFloat( xrSession, &entry.getInfo, &actionState.stateFloat );
+					bActive = actionState.stateFloat.isActive;
+					bChanged = actionState.stateFloat.changedSinceLastSync;
+					state.fValue[ 0 ] = actionState.stateFloat.currentState;
+					break;
+
+				case XR_ACTION_TYPE_VECTOR2F_INPUT:
+					actionState.stateVector2f = { XR_TYPE_ACTION_STATE_VECTOR2F };
+					xrResult = xrGetActionStateVector2f( xrSession, &entry.getInfo, &actionState.stateVector2f );
+					bActive = actionState.stateVector2f.isActive;
+					bChanged = actionState.stateVector2f.changedSinceLastSync;
+					state.fValue[ 0 ] = actionState.stateVector2f.currentState.x;
+					state.fValue[ 1 ] = actionState.stateVector2f.currentState.y;
+					break;
+
+				case XR_ACTION_TYPE_POSE_INPUT:
+					actionState.statePose = { XR_TYPE_ACTION_STATE_POSE };
+					xrResult = xrGetActionStatePose( xrSession, &entry.getInfo, &actionState.statePose );
+					bActive = actionState.statePose.isActive;
+					break;
+
+				default:
+					break;
+			}
+
+			// A failed query reads as inactive
+			state.unFlags = 0;
+			if ( XR_SUCCEEDED( xrResult ) )
+				state.unFlags = ( bActive ? SCapturedActionState::k_unActive : 0 ) | ( bChanged ? SCapturedActionState::k_unChanged : 0 );
+		}
+
+		return XR_SUCCESS;
+	}
+
+	void CActionDispatcher::WriteStates()
+	{
+		for ( size_t i = 0; i < m_vecEntries.size(); i++ )
+		{
+			const SActionEntry &entry = m_vecEntries[ i ];
+			const SCapturedActionState &state = m_vecStates[ i ];
+			auto &actionState = entry.pAction->vecActionStates[ entry.unActionStateIndex ];
+
+			const XrBool32 bActive = ( state.unFlags & SCapturedActionState::k_unActive ) ? XR_TRUE : XR_FALSE;
+			const XrBool32 bChanged = ( state.unFlags & SCapturedActionState::k_unChanged ) ? XR_TRUE : XR_FALSE;
+
+			switch ( entry.xrActionType )
+			{
+				case XR_ACTION_TYPE_BOOLEAN_INPUT:
+					actionState.stateBoolean = { XR_TYPE_ACTION_STATE_BOOLEAN };
+					actionState.stateBoolean.currentState = state.fValue[ 0 ] != 0.f ? XR_TRUE : XR_FALSE;
+					actionState.stateBoolean.changedSinceLastSync = bChanged;
+					actionState.stateBoolean.isActive = bActive;
+					break;
+
+				case XR_ACTION_TYPE_FLOAT_INPUT:
+					actionState.stateFloat = { XR_TYPE_ACTION_STATE_FLOAT };
+					actionState.stateFloat.currentState = state.fValue[ 0 ];
+					actionState.stateFloat.changedSinceLastSync = bChanged;
+					actionState.stateFloat.isActive = bActive;
+					break;
+
+				case XR_ACTION_TYPE_VECTOR2F_INPUT:
+					actionState.stateVector2f = { XR_TYPE_ACTION_STATE_VECTOR2F };
+					actionState.stateVector2f.currentState = { state.fValue[ 0 ], state.fValue[ 1 ] };
+					actionState.stateVector2f.changedSinceLastSync = bChanged;
+					actionState.stateVector2f.isActive = bActive;
+					break;
+
+				case XR_ACTION_TYPE_POSE_INPUT:
+					actionState.statePose = { XR_TYPE_ACTION_STATE_POSE };
+					actionState.statePose.isActive = bActive;
+					break;
+
+				default:
+					break;
+			}
+		}
+	}
+
+} // namespace xrapp
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <xrlib.hpp>
+
+#include <input_capture.hpp>
+
+namespace xrapp
+{
+	enum class EActionDispatch
+	{
+		OnChange = 0,	// state changed, or the action became active/inactive (poses: activity changes only)
+		WhileActive = 1,	// every sync while the action is active, plus the sync it goes inactive (e.g. continuous scaling while a trigger is held)
+	};
+
+	// Action state (action + subaction path) that changed in the last sync
+	struct SActionChange
+	{
+		SAction *pAction = nullptr;
+		uint32_t unActionStateIndex = 0;
+	};
+
+	struct SActionDispatchStats
+	{
+		uint32_t unStates = 0;		// action states queried per sync
+		uint32_t unChanged = 0;		// states that changed in the last sync
+		uint32_t unCallbacks = 0;	// callbacks fired in the last sync
+	};
+
+	// Syncs action sets and dispatches action state changes from a flat table of function pointer/context pairs,
+	// one entry per action state. Replaces CInput::ProcessInput, which calls every action's std::function each sync.
+	// All storage is sized when actions are added, Sync() does no heap allocations. Not thread safe - sync from one thread (e.g. the input task).
+	// States are recorded to, or replayed from, the input capture when it's active.
+	class CActionDispatcher
+	{
+	  public:
+		CActionDispatcher( CInputCapture *pCapture = nullptr ) : m_pCapture( pCapture ) {}
+
+		using ActionFn = void ( * )( void *pContext, SAction *pAction, uint32_t unActionStateIndex );
+
+		// Adds an action set to sync, optionally filtered to a subaction path. Call after the action sets are attached to the session.
+		void AddActionSet( SActionSet *pActionSet, XrPath subactionPath = XR_NULL_PATH );
+
+		// Adds an input action created with CInput::CreateAction, one table entry per subaction path. fnCallback can be null to only
+		// track changes (see GetChanged). Output actions (haptics) aren't synced and are rejected.
+		bool Add( SAction *pAction, void *pContext, ActionFn fnCallback, EActionDispatch eDispatch = EActionDispatch::OnChange );
+
+		// Adds an action with a member function callback, e.g. Add< &App::ActionCallback_Pinch >( &actionPinch, pApp )
+		template < auto pfnCallback, typename TContext >
+		bool Add( SAction *pAction, TContext *pContext, EActionDispatch eDispatch = EActionDispatch::OnChange )
+		{
+			return Add(
+				pAction,
+				pContext,
+				[]( void *pContext, SAction *pAction, uint32_t unActionStateIndex ) { ( static_cast< TContext * >( pContext )->*pfnCallback )( pAction, unActionStateIndex ); },
+				eDispatch );
+		}
+
+		// Syncs the active action sets with the runtime (or takes the next replayed states), writes each action's vecActionStates,
+		// then fires the callbacks of changed states in the order they were added. Callbacks run after all states are updated, so they can read any other action.
+		XrResult Sync( XrSession xrSession );
+
+		// Action states that changed in the last sync, valid until the next one
+		std::span< const SActionChange > GetChanged() const { return { m_vecChanged.data(), m_vecChanged.size() }; }
+
+		const SActionDispatchStats &GetStats() const { return m_stats; }
+
+	  private:
+		struct SActionEntry
+		{
+			SAction *pAction = nullptr;
+			uint32_t unActionStateIndex = 0;
+			XrActionType xrActionType = XR_ACTION_TYPE_BOOLEAN_INPUT;
+			XrActionStateGetInfo getInfo { XR_TYPE_ACTION_STATE_GET_INFO };
+
+			ActionFn fnCallback = nullptr;
+			void *pContext = nullptr;
+			EActionDispatch eDispatch = EActionDispatch::OnChange;
+
+			bool bWasActive = false;
+		};
+
+		XrResult QueryStates( XrSession xrSession );
+		void WriteStates();
+
+		CInputCapture *m_pCapture = nullptr;
+
+		std::vector< XrActiveActionSet > m_vecActiveActionSets;
+		std::vector< SActionEntry > m_vecEntries;
+		std::vector< SCapturedActionState > m_vecStates;	// per entry, what the last sync read
+		std::vector< SActionChange > m_vecChanged;
+		std::vector< uint32_t > m_vecPending;	// entries to call back this sync
+
+		SActionDispatchStats m_stats;
+	};
+
+} // namespace xrapp
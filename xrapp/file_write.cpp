@@ -0,0 +1,59 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+
+
+#include <file_write.hpp>
+
+#include <cstdio>
+#include <fstream>
+
+#ifdef _WIN32
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+#endif
+
+namespace xrapp
+{
+	bool WriteFileAtomic( const std::string &sFilename, const std::function< bool( std::ostream &out ) > &fnWrite, std::string &sError )
+	{
+		const std::string sTempFilename = sFilename + ".tmp";
+		{
+			std::ofstream out( sTempFilename, std::ios::binary | std::ios::trunc );
+			if ( !out || !fnWrite( out ) || !out.flush() )
+			{
+				out.close();
+				std::remove( sTempFilename.c_str() );
+				sError = "Unable to write: " + sTempFilename;
+				return false;
+			}
+		}
+
+		// rename replaces an existing target in one step on posix, windows needs MoveFileEx for that
+		#ifdef _WIN32
+			const bool bReplaced = MoveFileExA( sTempFilename.c_str(), sFilename.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH ) != 0;
+		#else
+			const bool bReplaced = std::rename( sTempFilename.c_str(), sFilename.c_str() ) == 0;
+		#endif
+
+		if ( !bReplaced )
+		{
+			std::remove( sTempFilename.c_str() );
+			sError = "Unable to replace: " + sFilename;
+			return false;
+		}
+
+		return true;
+	}
+
+} // namespace xrapp
@@ -0,0 +1,28 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+
+
+#pragma once
+
+#include <functional>
+#include <ostream>
+#include <string>
+
+namespace xrapp
+{
+	// Writes a file through a temporary next to it that then replaces the target in one step. A crash mid-write leaves
+	// the previous file untouched instead of a half written one, and readers never find the target missing.
+	// fnWrite streams the contents, the write fails if it returns false or the stream goes bad.
+	bool WriteFileAtomic( const std::string &sFilename, const std::function< bool( std::ostream &out ) > &fnWrite, std::string &sError );
+
+} // namespace xrapp
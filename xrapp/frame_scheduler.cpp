@@ -0,0 +1,219 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+
+#include <frame_scheduler.hpp>
+#include <profiler.hpp>
+
+#include <chrono>
+
+namespace xrapp
+{
+	namespace
+	{
+		using clock = std::chrono::steady_clock;
+
+		double ElapsedMs( clock::time_point &last )
+		{
+			auto now = clock::now();
+			double dMs = std::chrono::duration< double, std::milli >( now - last ).count();
+			last = now;
+			return dMs;
+		}
+	}
+
+	CFrameScheduler::CFrameScheduler( XrApp *pApp, SFrameTasks tasks, bool bPipelined )
+		: m_pApp( pApp )
+		, m_tasks( std::move( tasks ) )
+		, m_bPipelined( bPipelined )
+	{
+	}
+
+	CFrameScheduler::~CFrameScheduler()
+	{
+		Flush();
+	}
+
+	void CFrameScheduler::Flush()
+	{
+		XRAPP_PROFILE_ZONE( "RenderWait" );
+
+		if ( m_futureEndFrame.valid() )
+			m_futureEndFrame.get();
+	}
+
+	bool CFrameScheduler::Tick()
+	{
+		XRAPP_PROFILE_THREAD( "Main" );
+		XRAPP_PROFILE_ZONE( "Tick" );
+
+		m_timings = {};
+		auto tickStart = clock::now();
+		auto last = tickStart;
+
+		if ( m_bPipelined )
+		{
+			// (1) Wait for the render thread to finish submitting the previous frame.
+			//     Past this point nothing else touches renderables until the next submit.
+			Flush();
+			m_timings.dRenderWait = ElapsedMs( last );
+
+			// (2) Poll and process xr events - safe to rebuild render resources here (e.g. vismasks)
+			if ( !ProcessEvents() )
+				return m_pApp->GetSession()->GetState() != XR_SESSION_STATE_EXITING;
+			m_timings.dEvents = ElapsedMs( last );
+
+			// (3) Copy last tick's input and simulation results to the renderables, then upload any async loaded meshes
+			Publish();
+			m_pApp->UpdateAsyncLoads();
+			m_timings.dPublish = ElapsedMs( last );
+
+			// (4) Start frame N (includes xrWaitFrame) then hand its recording and submission to the render thread
+			bool bFrameStarted = StartFrame();
+			m_timings.dStartFrame = ElapsedMs( last );
+
+			SubmitEndFrame( bFrameStarted );
+
+			// (5) Sync input and simulate frame N+1 while the render thread works on frame N
+			RunInput();
+			m_timings.dInput = ElapsedMs( last );
+
+			if ( bFrameStarted )
+				Simulate();
+			m_timings.dSimulate = ElapsedMs( last );
+		}
+		else
+		{
+			// Lockstep - same order as the original demo loops
+			if ( !ProcessEvents() )
+				return m_pApp->GetSession()->GetState() != XR_SESSION_STATE_EXITING;
+			m_timings.dEvents = ElapsedMs( last );
+
+			RunInput();
+			m_timings.dInput = ElapsedMs( last );
+
+			// Render thread is idle until the frame starts
+			m_pApp->UpdateAsyncLoads();
+			m_timings.dPublish = ElapsedMs( last );
+
+			bool bFrameStarted = StartFrame();
+			m_timings.dStartFrame = ElapsedMs( last );
+
+			if ( bFrameStarted )
+				Simulate();
+			m_timings.dSimulate = ElapsedMs( last );
+
+			Publish();
+			m_timings.dPublish += ElapsedMs( last );
+
+			SubmitEndFrame( bFrameStarted );
+			Flush();
+			m_timings.dRenderWait = ElapsedMs( last );
+		}
+
+		m_timings.dTotal = std::chrono::duration< double, std::milli >( clock::now() - tickStart ).count();
+		return m_pApp->GetSession()->GetState() != XR_SESSION_STATE_EXITING;
+	}
+
+	bool CFrameScheduler::ProcessEvents()
+	{
+		// Drain the whole queue so bursts (e.g. session transitions) are handled before this frame starts
+		if ( !m_pApp->PollXrEvents() )
+			return false;
+
+		m_timings.unEvents = m_pApp->GetEventStats().unEventCount;
+
+		return m_pApp->GetSession()->GetState() != XR_SESSION_STATE_EXITING;
+	}
+
+	bool CFrameScheduler::StartFrame()
+	{
+		bool bFrameStarted = m_pApp->pThreadPool->SubmitRenderTask(
+			[ pApp = m_pApp ]()
+			{
+				XRAPP_PROFILE_THREAD( "Render" );
+				XRAPP_PROFILE_ZONE( "StartRenderFrame" );
+				return pApp->StartRenderFrame();
+			} ).get();
+		m_timings.bFrameStarted = bFrameStarted;
+
+		if ( !bFrameStarted )
+			return false;
+
+		// Snapshot what the simulation needs, the render thread owns render info from here until the frame is submitted
+		m_context.unFrameIndex = m_unFrameIndex++;
+		m_context.frameState = m_pApp->pRenderInfo->state.frameState;
+		m_context.hmdPose = m_pApp->pRenderInfo->state.hmdPose;
+		m_context.viewStateFlags = m_pApp->pRenderInfo->state.sharedEyeState.viewStateFlags;
+
+		XRAPP_PROFILE_FRAME( m_context.unFrameIndex, m_context.frameState.predictedDisplayTime );
+
+		// Input and simulation this tick run on the frame clock at the simulation time, when pipelined that's the frame after the one just started.
+		// Input replays substitute the recorded time.
+		m_pApp->AdvanceFrameClock( m_context.frameState.predictedDisplayTime + ( m_bPipelined ? m_context.frameState.predictedDisplayPeriod : 0 ), m_context.frameState.predictedDisplayPeriod );
+		m_context.simulationTime = m_pApp->GetFrameClock().time;
+
+		return true;
+	}
+
+	void CFrameScheduler::SubmitEndFrame( bool bFrameStarted )
+	{
+		if ( !bFrameStarted && !bEndUnstartedFrames )
+			return;
+
+		m_futureEndFrame = m_pApp->pThreadPool->SubmitRenderTask(
+			[ pApp = m_pApp ]()
+			{
+				XRAPP_PROFILE_ZONE( "EndRenderFrame" );
+				pApp->EndRenderFrame();
+			} );
+	}
+
+	void CFrameScheduler::RunInput()
+	{
+		if ( m_tasks.fnInput )
+			m_pApp->pThreadPool->SubmitInputTask(
+				[ pApp = m_pApp, &fnInput = m_tasks.fnInput ]()
+				{
+					XRAPP_PROFILE_THREAD( "Input" );
+					XRAPP_PROFILE_ZONE( "Input" );
+					fnInput();
+
+					// Vibrations requested this frame go out together, at most one runtime call per device
+					const XrApp::SFrameClock &clock = pApp->GetFrameClock();
+					pApp->haptics.Submit( pApp->GetSession()->GetXrSession(), clock.time, clock.period );
+				} ).get();
+	}
+
+	void CFrameScheduler::Simulate()
+	{
+		if ( !m_context.frameState.shouldRender )
+			return;
+
+		XRAPP_PROFILE_ZONE( "Simulate" );
+		m_pApp->tweens.Update( m_context.simulationTime );
+
+		if ( m_tasks.fnSimulate )
+			m_tasks.fnSimulate( m_context );
+	}
+
+	void CFrameScheduler::Publish()
+	{
+		XRAPP_PROFILE_ZONE( "Publish" );
+		if ( m_tasks.fnPublish )
+			m_tasks.fnPublish();
+
+		// Material values set during input, simulation or publish go out together
+		m_timings.unMaterialsFlushed = m_pApp->materialStore.Flush();
+	}
+
+} // namespace xrapp
@@ -0,0 +1,105 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+
+#pragma once
+
+#include <functional>
+#include <future>
+
+#include <xrapp.hpp>
+
+namespace xrapp
+{
+	// Snapshot of the frame that was just started, handed to the simulation stage
+	struct SFrameContext
+	{
+		uint64_t unFrameIndex = 0;
+		XrFrameState frameState { XR_TYPE_FRAME_STATE };
+		XrPosef hmdPose { { 0.f, 0.f, 0.f, 1.f }, { 0.f, 0.f, 0.f } };
+		XrViewStateFlags viewStateFlags = 0;
+
+		// Predicted display time of the frame being simulated, also the app's frame clock time.
+		// When pipelined this is the frame after the one the render thread is working on. The recorded time when replaying input.
+		XrTime simulationTime = 0;
+	};
+
+	// App hooks for each stage of a frame
+	struct SFrameTasks
+	{
+		// Input thread - sync actions and run action callbacks. Callbacks should only write to the app's back buffer. The app's haptics are submitted right after.
+		std::function< void() > fnInput = nullptr;
+
+		// Main thread - update the back buffer for context.simulationTime, the app's tweens are already updated to it. When pipelined, this runs while the render thread records and submits the previous frame.
+		std::function< void( const SFrameContext & ) > fnSimulate = nullptr;
+
+		// Main thread - copy the back buffer to renderables. Only called while the render thread is idle, the app's material store is flushed right after.
+		std::function< void() > fnPublish = nullptr;
+	};
+
+	// Main thread time (ms) spent in each stage of the last tick
+	struct SFrameTimings
+	{
+		double dRenderWait = 0.0;
+		double dEvents = 0.0;
+		double dPublish = 0.0;
+		double dStartFrame = 0.0;
+		double dInput = 0.0;
+		double dSimulate = 0.0;
+		double dTotal = 0.0;
+		uint32_t unEvents = 0;	// xr events handled this tick
+		uint32_t unMaterialsFlushed = 0;	// materials with changed values written this tick
+		bool bFrameStarted = false;
+	};
+
+	class CFrameScheduler
+	{
+	  public:
+		CFrameScheduler( XrApp *pApp, SFrameTasks tasks, bool bPipelined = true );
+		~CFrameScheduler();
+
+		// Runs one frame. Returns false once the session is exiting.
+		bool Tick();
+
+		// Blocks until the render thread is done with the in-flight frame
+		void Flush();
+
+		bool BIsPipelined() { return m_bPipelined; }
+		uint64_t GetFrameIndex() { return m_unFrameIndex; }
+
+		const SFrameContext &GetContext() { return m_context; }
+		const SFrameTimings &GetTimings() { return m_timings; }
+
+		// Submit EndRenderFrame even if StartRenderFrame failed
+		bool bEndUnstartedFrames = false;
+
+	  private:
+		bool ProcessEvents();
+		bool StartFrame();
+		void SubmitEndFrame( bool bFrameStarted );
+		void RunInput();
+		void Simulate();
+		void Publish();
+
+		XrApp *m_pApp = nullptr;
+		SFrameTasks m_tasks;
+
+		bool m_bPipelined = true;
+		uint64_t m_unFrameIndex = 0;
+
+		SFrameContext m_context;
+		SFrameTimings m_timings;
+
+		std::future< void > m_futureEndFrame;
+	};
+
+} // namespace xrapp
@@ -0,0 +1,154 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+
+
+#include <haptics.hpp>
+
+#include <algorithm>
+
+namespace xrapp
+{
+	void CHapticScheduler::Request( XrAction xrAction, XrPath subactionPath, const SHapticPulse &pulse )
+	{
+		SHapticDevice &device = GetDevice( xrAction, subactionPath );
+		m_stats.unRequests++;
+
+		if ( !device.bPending )
+		{
+			device.bPending = true;
+			device.pending = pulse;
+			return;
+		}
+
+		// Strongest pulse wins, the longest one sets the end
+		if ( pulse.fAmplitude > device.pending.fAmplitude )
+		{
+			device.pending.fAmplitude = pulse.fAmplitude;
+			device.pending.fFrequency = pulse.fFrequency;
+		}
+
+		device.pending.duration = std::max( device.pending.duration, pulse.duration );
+	}
+
+	void CHapticScheduler::Sustain( XrAction xrAction, XrPath subactionPath, float fAmplitude, float fFrequency )
+	{
+		SHapticDevice &device = GetDevice( xrAction, subactionPath );
+		device.bSustain = true;
+		device.bStop = false;
+		device.fSustainAmplitude = fAmplitude;
+		device.fSustainFrequency = fFrequency;
+	}
+
+	void CHapticScheduler::Release( XrAction xrAction, XrPath subactionPath )
+	{
+		for ( auto &device : m_vecDevices )
+		{
+			if ( device.actionInfo.action == xrAction && device.actionInfo.subactionPath == subactionPath && device.bSustain )
+			{
+				device.bSustain = false;
+				device.bStop = true;
+				return;
+			}
+		}
+	}
+
+	void CHapticScheduler::Submit( XrSession xrSession, XrTime time, XrDuration period )
+	{
+		m_stats.unApplied = m_stats.unStopped = 0;
+
+		for ( auto &device : m_vecDevices )
+		{
+			// (1) Released sustains are cut short, a pulse this frame replaces them instead
+			if ( device.bStop )
+			{
+				if ( device.activeEnd > time && !device.bPending )
+				{
+					xrStopHapticFeedback( xrSession, &device.actionInfo );
+					m_stats.unStopped++;
+				}
+
+				device.activeEnd = 0;
+				device.bStop = false;
+			}
+
+			if ( !device.bPending && !device.bSustain )
+				continue;
+
+			// (2) What the device needs to be doing - sustains need to be covered for the next two frames to renew in time,
+			//     pulses repeated every frame are renewed once half of the last one has played
+			float fAmplitude = 0.f;
+			float fFrequency = XR_FREQUENCY_UNSPECIFIED;
+			XrTime end = 0;
+			XrDuration duration = XR_MIN_HAPTIC_DURATION;
+
+			if ( device.bSustain )
+			{
+				fAmplitude = device.fSustainAmplitude;
+				fFrequency = device.fSustainFrequency;
+				end = time + period * 2;
+				duration = sustainDuration;
+			}
+
+			if ( device.bPending )
+			{
+				if ( device.pending.fAmplitude > fAmplitude )
+				{
+					fAmplitude = device.pending.fAmplitude;
+					fFrequency = device.pending.fFrequency;
+				}
+
+				const XrDuration pulseDuration = device.pending.duration > 0 ? device.pending.duration : period;
+				end = std::max( end, time + pulseDuration - pulseDuration / 2 );
+
+				if ( device.pending.duration > 0 || !device.bSustain )
+					duration = std::max( duration, device.pending.duration );
+
+				device.bPending = false;
+			}
+
+			// (3) Already covered by what's running
+			if ( device.activeEnd >= end && device.fActiveAmplitude >= fAmplitude && device.fActiveFrequency == fFrequency )
+				continue;
+
+			XrHapticVibration vibration { XR_TYPE_HAPTIC_VIBRATION };
+			vibration.amplitude = fAmplitude;
+			vibration.duration = duration;
+			vibration.frequency = fFrequency;
+
+			if ( !XR_SUCCEEDED( xrApplyHapticFeedback( xrSession, &device.actionInfo, reinterpret_cast< XrHapticBaseHeader * >( &vibration ) ) ) )
+				continue;
+
+			device.fActiveAmplitude = fAmplitude;
+			device.fActiveFrequency = fFrequency;
+			device.activeEnd = time + ( duration > 0 ? duration : period );
+			m_stats.unApplied++;
+		}
+
+		m_stats.unRequests = 0;
+	}
+
+	CHapticScheduler::SHapticDevice &CHapticScheduler::GetDevice( XrAction xrAction, XrPath subactionPath )
+	{
+		for ( auto &device : m_vecDevices )
+		{
+			if ( device.actionInfo.action == xrAction && device.actionInfo.subactionPath == subactionPath )
+				return device;
+		}
+
+		SHapticDevice &device = m_vecDevices.emplace_back();
+		device.actionInfo.action = xrAction;
+		device.actionInfo.subactionPath = subactionPath;
+		return device;
+	}
+
+} // namespace xrapp
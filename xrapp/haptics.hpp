@@ -0,0 +1,89 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <openxr/openxr.h>
+
+namespace xrapp
+{
+	struct SHapticPulse
+	{
+		float fAmplitude = 0.5f;
+		XrDuration duration = XR_MIN_HAPTIC_DURATION;	// counts as one display period when merging
+		float fFrequency = XR_FREQUENCY_UNSPECIFIED;
+	};
+
+	struct SHapticStats
+	{
+		uint32_t unRequests = 0;	// pulse requests since the last submit
+		uint32_t unApplied = 0;		// xrApplyHapticFeedback calls in the last submit
+		uint32_t unStopped = 0;		// xrStopHapticFeedback calls in the last submit
+	};
+
+	// Queues vibration requests per haptic action and subaction path (i.e. per device) and applies them once per frame.
+	// Requests made in the same frame are merged (strongest amplitude, latest end), and nothing is applied while the
+	// vibration already running on the device covers them. Sustained vibrations are applied in long chunks and renewed
+	// shortly before they run out, so keeping one going every frame costs no runtime calls. Use from the input thread.
+	class CHapticScheduler
+	{
+	  public:
+		// One pulse, merged with other requests for the same device this frame
+		void Request( XrAction xrAction, XrPath subactionPath, const SHapticPulse &pulse = {} );
+
+		// Keeps the device vibrating until Release(). Calling it again with the same values (e.g. every frame) is free,
+		// a lower amplitude applies once the running chunk is renewed.
+		void Sustain( XrAction xrAction, XrPath subactionPath, float fAmplitude, float fFrequency = XR_FREQUENCY_UNSPECIFIED );
+
+		// Ends a sustained vibration, stopping the device if nothing else keeps it going. No-op if it isn't sustained.
+		void Release( XrAction xrAction, XrPath subactionPath );
+
+		// Applies at most one vibration per device. Once per frame after input (CFrameScheduler does this after the app's input task).
+		void Submit( XrSession xrSession, XrTime time, XrDuration period );
+
+		const SHapticStats &GetStats() const { return m_stats; }
+
+		// Length of each sustained chunk
+		XrDuration sustainDuration = 250'000'000;
+
+	  private:
+		struct SHapticDevice
+		{
+			XrHapticActionInfo actionInfo { XR_TYPE_HAPTIC_ACTION_INFO };
+
+			// Requested since the last submit
+			bool bPending = false;
+			SHapticPulse pending;
+
+			bool bSustain = false;
+			bool bStop = false;
+			float fSustainAmplitude = 0.f;
+			float fSustainFrequency = XR_FREQUENCY_UNSPECIFIED;
+
+			// Applied and still running on the device
+			float fActiveAmplitude = 0.f;
+			float fActiveFrequency = XR_FREQUENCY_UNSPECIFIED;
+			XrTime activeEnd = 0;
+		};
+
+		SHapticDevice &GetDevice( XrAction xrAction, XrPath subactionPath );
+
+		std::vector< SHapticDevice > m_vecDevices;
+		SHapticStats m_stats;
+	};
+
+} // namespace xrapp
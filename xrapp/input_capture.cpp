@@ -0,0 +1,166 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+
+
+#include <input_capture.hpp>
+
+#include <cstring>
+
+namespace xrapp
+{
+	namespace
+	{
+		// Records are buffered and written in blocks of about this size
+		constexpr size_t k_unRecordFlushSize = 64 * 1024;
+
+		constexpr uint64_t PaddedSize( uint64_t unSize ) { return ( unSize + 7 ) & ~uint64_t( 7 ); }
+	}
+
+	CInputCapture::~CInputCapture()
+	{
+		Stop();
+	}
+
+	bool CInputCapture::StartRecording( const std::string &sFilename )
+	{
+		Stop();
+
+		m_outFile.open( sFilename, std::ios::binary | std::ios::trunc );
+		if ( !m_outFile )
+			return false;
+
+		SInputCaptureHeader header;
+		m_outFile.write( reinterpret_cast< const char * >( &header ), sizeof( header ) );
+
+		m_vecRecordBuffer.reserve( k_unRecordFlushSize * 2 );
+		m_eMode = ECaptureMode::Record;
+		return true;
+	}
+
+	bool CInputCapture::StartReplay( const std::string &sFilename )
+	{
+		Stop();
+
+		std::ifstream file( sFilename, std::ios::binary | std::ios::ate );
+		if ( !file )
+			return false;
+
+		m_vecReplayData.resize( static_cast< size_t >( file.tellg() ) );
+		file.seekg( 0 );
+		file.read( reinterpret_cast< char * >( m_vecReplayData.data() ), m_vecReplayData.size() );
+
+		SInputCaptureHeader header;
+		if ( !file || m_vecReplayData.size() < sizeof( header ) )
+			return false;
+
+		std::memcpy( &header, m_vecReplayData.data(), sizeof( header ) );
+		if ( header.unMagic != k_unInputCaptureMagic || header.unVersion != k_unInputCaptureVersion )
+			return false;
+
+		// Index the chunks of each stream, a truncated last chunk (e.g. the app was killed while recording) is dropped
+		uint64_t unOffset = PaddedSize( sizeof( header ) );
+		while ( unOffset + sizeof( SInputCaptureChunk ) <= m_vecReplayData.size() )
+		{
+			SInputCaptureChunk chunk;
+			std::memcpy( &chunk, m_vecReplayData.data() + unOffset, sizeof( chunk ) );
+
+			const uint64_t unPayload = unOffset + sizeof( chunk );
+			if ( unPayload + chunk.unSize > m_vecReplayData.size() )
+				break;
+
+			if ( chunk.unStream < k_unCaptureStreamCount )
+				m_vecReplayChunks[ chunk.unStream ].push_back( unOffset );
+
+			unOffset = unPayload + PaddedSize( chunk.unSize );
+		}
+
+		m_eMode = ECaptureMode::Replay;
+		return true;
+	}
+
+	void CInputCapture::Stop()
+	{
+		if ( m_eMode == ECaptureMode::Record )
+		{
+			std::scoped_lock lock( m_mutexRecord );
+			FlushRecording();
+			m_outFile.close();
+		}
+
+		m_eMode = ECaptureMode::Off;
+		m_vecRecordBuffer.clear();
+		m_vecReplayData.clear();
+
+		for ( size_t i = 0; i < k_unCaptureStreamCount; i++ )
+		{
+			m_vecReplayChunks[ i ].clear();
+			m_unReplayCursors[ i ] = 0;
+		}
+
+		m_bReplayFinished = false;
+	}
+
+	bool CInputCapture::Capture( ECaptureStream eStream, void *pData, uint32_t unSize )
+	{
+		const size_t unStream = static_cast< size_t >( eStream );
+
+		if ( m_eMode == ECaptureMode::Record )
+		{
+			std::scoped_lock lock( m_mutexRecord );
+
+			SInputCaptureChunk chunk { static_cast< uint32_t >( unStream ), unSize };
+			const size_t unStart = m_vecRecordBuffer.size();
+			m_vecRecordBuffer.resize( unStart + sizeof( chunk ) + PaddedSize( unSize ) );
+
+			std::memcpy( m_vecRecordBuffer.data() + unStart, &chunk, sizeof( chunk ) );
+			std::memcpy( m_vecRecordBuffer.data() + unStart + sizeof( chunk ), pData, unSize );
+
+			if ( m_vecRecordBuffer.size() >= k_unRecordFlushSize )
+				FlushRecording();
+
+			return true;
+		}
+
+		if ( m_eMode == ECaptureMode::Replay )
+		{
+			size_t &unCursor = m_unReplayCursors[ unStream ];
+			if ( unCursor >= m_vecReplayChunks[ unStream ].size() )
+			{
+				m_bReplayFinished = true;
+				return false;
+			}
+
+			const uint64_t unOffset = m_vecReplayChunks[ unStream ][ unCursor++ ];
+
+			SInputCaptureChunk chunk;
+			std::memcpy( &chunk, m_vecReplayData.data() + unOffset, sizeof( chunk ) );
+			if ( chunk.unSize != unSize )
+				return false;
+
+			std::memcpy( pData, m_vecReplayData.data() + unOffset + sizeof( chunk ), unSize );
+			return true;
+		}
+
+		return false;
+	}
+
+	void CInputCapture::FlushRecording()
+	{
+		if ( m_vecRecordBuffer.empty() )
+			return;
+
+		m_outFile.write( reinterpret_cast< const char * >( m_vecRecordBuffer.data() ), m_vecRecordBuffer.size() );
+		m_vecRecordBuffer.clear();
+	}
+
+} // namespace xrapp
@@ -0,0 +1,133 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <openxr/openxr.h>
+
+namespace xrapp
+{
+	// Input capture (.xrinput): a header followed by chunks, each a SInputCaptureChunk and its payload padded to 8 bytes.
+	// Chunks of a stream are replayed in the order they were recorded.
+	static constexpr const char *k_pccInputCaptureExtension = ".xrinput";
+	static constexpr uint32_t k_unInputCaptureMagic = 0x43495258; // XRIC
+	static constexpr uint32_t k_unInputCaptureVersion = 1;
+
+	enum class ECaptureStream : uint32_t
+	{
+		FrameClock = 0,		// SCapturedFrameClock, once per frame
+		ActionStates = 1,	// SCapturedActionState per dispatched action state, once per action sync
+		SpacePoses = 2,		// SCapturedSpaceLocation per late latched space, once per late latch
+		HandJoints = 3,		// XrHandJointLocationEXT, as captured by the app (e.g. left hand then right hand per frame)
+		Count
+	};
+
+	static constexpr size_t k_unCaptureStreamCount = static_cast< size_t >( ECaptureStream::Count );
+
+	enum class ECaptureMode
+	{
+		Off = 0,
+		Record = 1,
+		Replay = 2
+	};
+
+	struct SInputCaptureHeader
+	{
+		uint32_t unMagic = k_unInputCaptureMagic;
+		uint32_t unVersion = k_unInputCaptureVersion;
+	};
+
+	struct SInputCaptureChunk
+	{
+		uint32_t unStream = 0;
+		uint32_t unSize = 0;	// payload bytes, without padding
+	};
+
+	struct SCapturedFrameClock
+	{
+		XrTime time = 0;
+		XrDuration period = 0;
+	};
+
+	struct SCapturedActionState
+	{
+		static constexpr uint32_t k_unActive = 1;
+		static constexpr uint32_t k_unChanged = 2;
+
+		uint32_t unFlags = 0;
+		float fValue[ 2 ] = { 0.f, 0.f };	// boolean (0/1), float or vector2f current state
+	};
+
+	struct SCapturedSpaceLocation
+	{
+		XrSpaceLocationFlags locationFlags = 0;
+		XrPosef pose { { 0.f, 0.f, 0.f, 1.f }, { 0.f, 0.f, 0.f } };
+	};
+
+	// Records input (action states, late latched poses, hand joints) and frame timings to a file, or replays them in place of the runtime.
+	// Replaying a capture against the mock runtime reruns a session with exactly the same input, e.g. to compare frame times across builds.
+	// Each stream is expected to be captured from one thread. Recording is thread safe across streams.
+	class CInputCapture
+	{
+	  public:
+		~CInputCapture();
+
+		// Start and stop only while nothing else captures (e.g. before the frame loop, or while the frame scheduler is idle),
+		// the mode and replay data aren't guarded against concurrent Capture calls
+		bool StartRecording( const std::string &sFilename );
+		bool StartReplay( const std::string &sFilename );
+
+		// Ends recording (flushing what's buffered) or replay
+		void Stop();
+
+		ECaptureMode GetMode() const { return m_eMode; }
+		bool BIsRecording() const { return m_eMode == ECaptureMode::Record; }
+		bool BIsReplaying() const { return m_eMode == ECaptureMode::Replay; }
+
+		// Recording - writes the items to the stream. Replay - overwrites the items with the stream's next chunk.
+		// Returns true if the items were recorded or replayed. When a stream runs out or its chunk doesn't match in size, the live items are kept.
+		template < typename T >
+		bool Capture( ECaptureStream eStream, T *pItems, uint32_t unCount )
+		{
+			return Capture( eStream, static_cast< void * >( pItems ), static_cast< uint32_t >( sizeof( T ) * unCount ) );
+		}
+
+		bool Capture( ECaptureStream eStream, void *pData, uint32_t unSize );
+
+		// Replay - true once any stream ran out
+		bool BIsReplayFinished() const { return m_bReplayFinished; }
+
+	  private:
+		void FlushRecording();
+
+		ECaptureMode m_eMode = ECaptureMode::Off;	// only written by Start*/Stop, see above
+
+		std::ofstream m_outFile;
+		std::vector< uint8_t > m_vecRecordBuffer;
+		std::mutex m_mutexRecord;
+
+		std::vector< uint8_t > m_vecReplayData;
+		std::vector< uint64_t > m_vecReplayChunks[ k_unCaptureStreamCount ];	// chunk offsets per stream
+		size_t m_unReplayCursors[ k_unCaptureStreamCount ] = {};
+		std::atomic< bool > m_bReplayFinished = false;	// set by the capturing threads, read by any
+	};
+
+} // namespace xrapp
@@ -0,0 +1,184 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+
+#include <joint_buffer.hpp>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+	#include <emmintrin.h>
+	#define XRAPP_JOINTS_SSE2
+#elif defined( __ARM_NEON ) && ( defined( __aarch64__ ) || defined( _M_ARM64 ) )
+	#include <arm_neon.h>
+	#define XRAPP_JOINTS_NEON
+#endif
+
+namespace xrapp
+{
+	namespace
+	{
+		// Four joints worth of one component. Thin wrapper so the kernel below is written once for sse2, neon and scalar builds.
+		#if defined( XRAPP_JOINTS_SSE2 )
+			struct SFloat4
+			{
+				__m128 v;
+
+				static SFloat4 Load( const float *p ) { return { _mm_load_ps( p ) }; }
+				static SFloat4 Splat( float f ) { return { _mm_set1_ps( f ) }; }
+				void Store( float *p ) const { _mm_store_ps( p, v ); }
+
+				friend SFloat4 operator+( SFloat4 a, SFloat4 b ) { return { _mm_add_ps( a.v, b.v ) }; }
+				friend SFloat4 operator-( SFloat4 a, SFloat4 b ) { return { _mm_sub_ps( a.v, b.v ) }; }
+				friend SFloat4 operator*( SFloat4 a, SFloat4 b ) { return { _mm_mul_ps( a.v, b.v ) }; }
+			};
+
+			// Bit n is set when joint n of the batch has all required flags
+			uint32_t ValidLanes( const uint32_t *pFlags, uint32_t unRequired )
+			{
+				__m128i required = _mm_set1_epi32( static_cast< int >( unRequired ) );
+				__m128i flags = _mm_load_si128( reinterpret_cast< const __m128i * >( pFlags ) );
+				__m128i valid = _mm_cmpeq_epi32( _mm_and_si128( flags, required ), required );
+				return static_cast< uint32_t >( _mm_movemask_ps( _mm_castsi128_ps( valid ) ) );
+			}
+		#elif defined( XRAPP_JOINTS_NEON )
+			struct SFloat4
+			{
+				float32x4_t v;
+
+				static SFloat4 Load( const float *p ) { return { vld1q_f32( p ) }; }
+				static SFloat4 Splat( float f ) { return { vdupq_n_f32( f ) }; }
+				void Store( float *p ) const { vst1q_f32( p, v ); }
+
+				friend SFloat4 operator+( SFloat4 a, SFloat4 b ) { return { vaddq_f32( a.v, b.v ) }; }
+				friend SFloat4 operator-( SFloat4 a, SFloat4 b ) { return { vsubq_f32( a.v, b.v ) }; }
+				friend SFloat4 operator*( SFloat4 a, SFloat4 b ) { return { vmulq_f32( a.v, b.v ) }; }
+			};
+
+			uint32_t ValidLanes( const uint32_t *pFlags, uint32_t unRequired )
+			{
+				static const uint32_t k_laneBits[ 4 ] = { 1, 2, 4, 8 };
+
+				uint32x4_t required = vdupq_n_u32( unRequired );
+				uint32x4_t valid = vceqq_u32( vandq_u32( vld1q_u32( pFlags ), required ), required );
+				return vaddvq_u32( vandq_u32( valid, vld1q_u32( k_laneBits ) ) );
+			}
+		#else
+			struct SFloat4
+			{
+				float v[ 4 ];
+
+				static SFloat4 Load( const float *p ) { return { { p[ 0 ], p[ 1 ], p[ 2 ], p[ 3 ] } }; }
+				static SFloat4 Splat( float f ) { return { { f, f, f, f } }; }
+				void Store( float *p ) const { for ( int i = 0; i < 4; i++ ) p[ i ] = v[ i ]; }
+
+				friend SFloat4 operator+( SFloat4 a, SFloat4 b ) { return { { a.v[ 0 ] + b.v[ 0 ], a.v[ 1 ] + b.v[ 1 ], a.v[ 2 ] + b.v[ 2 ], a.v[ 3 ] + b.v[ 3 ] } }; }
+				friend SFloat4 operator-( SFloat4 a, SFloat4 b ) { return { { a.v[ 0 ] - b.v[ 0 ], a.v[ 1 ] - b.v[ 1 ], a.v[ 2 ] - b.v[ 2 ], a.v[ 3 ] - b.v[ 3 ] } }; }
+				friend SFloat4 operator*( SFloat4 a, SFloat4 b ) { return { { a.v[ 0 ] * b.v[ 0 ], a.v[ 1 ] * b.v[ 1 ], a.v[ 2 ] * b.v[ 2 ], a.v[ 3 ] * b.v[ 3 ] } }; }
+			};
+
+			uint32_t ValidLanes( const uint32_t *pFlags, uint32_t unRequired )
+			{
+				uint32_t unLanes = 0;
+				for ( uint32_t i = 0; i < 4; i++ )
+					unLanes |= ( ( pFlags[ i ] & unRequired ) == unRequired ) ? ( 1u << i ) : 0u;
+				return unLanes;
+			}
+		#endif
+
+		// p' = transform.position + rotate( transform.orientation, p ), q' = transform.orientation * q
+		void TransformBatch( SJointBuffer &joints, uint32_t i, const XrPosef &transform )
+		{
+			const SFloat4 qx = SFloat4::Splat( transform.orientation.x );
+			const SFloat4 qy = SFloat4::Splat( transform.orientation.y );
+			const SFloat4 qz = SFloat4::Splat( transform.orientation.z );
+			const SFloat4 qw = SFloat4::Splat( transform.orientation.w );
+			const SFloat4 two = SFloat4::Splat( 2.f );
+
+			SFloat4 px = SFloat4::Load( &joints.posX[ i ] );
+			SFloat4 py = SFloat4::Load( &joints.posY[ i ] );
+			SFloat4 pz = SFloat4::Load( &joints.posZ[ i ] );
+
+			// t = 2 * cross( q.xyz, p ), p' = p + q.w * t + cross( q.xyz, t )
+			SFloat4 tx = two * ( qy * pz - qz * py );
+			SFloat4 ty = two * ( qz * px - qx * pz );
+			SFloat4 tz = two * ( qx * py - qy * px );
+
+			( px + qw * tx + ( qy * tz - qz * ty ) + SFloat4::Splat( transform.position.x ) ).Store( &joints.posX[ i ] );
+			( py + qw * ty + ( qz * tx - qx * tz ) + SFloat4::Splat( transform.position.y ) ).Store( &joints.posY[ i ] );
+			( pz + qw * tz + ( qx * ty - qy * tx ) + SFloat4::Splat( transform.position.z ) ).Store( &joints.posZ[ i ] );
+
+			SFloat4 rx = SFloat4::Load( &joints.rotX[ i ] );
+			SFloat4 ry = SFloat4::Load( &joints.rotY[ i ] );
+			SFloat4 rz = SFloat4::Load( &joints.rotZ[ i ] );
+			SFloat4 rw = SFloat4::Load( &joints.rotW[ i ] );
+
+			( qw * rx + qx * rw + qy * rz - qz * ry ).Store( &joints.rotX[ i ] );
+			( qw * ry - qx * rz + qy * rw + qz * rx ).Store( &joints.rotY[ i ] );
+			( qw * rz + qx * ry - qy * rx + qz * rw ).Store( &joints.rotZ[ i ] );
+			( qw * rw - qx * rx - qy * ry - qz * rz ).Store( &joints.rotW[ i ] );
+		}
+	}
+
+	uint32_t SJointBuffer::Append( const XrHandJointLocationEXT *pJoints, uint32_t unJointCount )
+	{
+		if ( unCount + unJointCount > k_unMaxTrackedJoints )
+			return k_unMaxTrackedJoints;
+
+		// Runtime joints are an array of structs, this is the only strided pass
+		uint32_t unFirst = unCount;
+		for ( uint32_t i = 0; i < unJointCount; i++ )
+		{
+			const XrHandJointLocationEXT &joint = pJoints[ i ];
+			uint32_t n = unFirst + i;
+
+			posX[ n ] = joint.pose.position.x;
+			posY[ n ] = joint.pose.position.y;
+			posZ[ n ] = joint.pose.position.z;
+
+			rotX[ n ] = joint.pose.orientation.x;
+			rotY[ n ] = joint.pose.orientation.y;
+			rotZ[ n ] = joint.pose.orientation.z;
+			rotW[ n ] = joint.pose.orientation.w;
+
+			radius[ n ] = joint.radius;
+			flags[ n ] = static_cast< uint32_t >( joint.locationFlags );
+		}
+
+		unCount += unJointCount;
+		return unFirst;
+	}
+
+	void UpdateJoints( SJointBuffer &joints, XrSpaceLocationFlags requiredFlags, const XrPosef *pTransform )
+	{
+		// Lanes past the last joint of a partial batch are cleared so they never validate
+		uint32_t unBatchedCount = ( joints.unCount + k_unJointBatchSize - 1 ) & ~( k_unJointBatchSize - 1 );
+		for ( uint32_t i = joints.unCount; i < unBatchedCount; i++ )
+			joints.flags[ i ] = 0;
+
+		// A joint with no required flags is always valid, including any padding lanes
+		uint32_t unRequired = static_cast< uint32_t >( requiredFlags );
+
+		for ( uint64_t &bits : joints.validBits )
+			bits = 0;
+
+		for ( uint32_t i = 0; i < unBatchedCount; i += k_unJointBatchSize )
+		{
+			joints.validBits[ i >> 6 ] |= static_cast< uint64_t >( ValidLanes( &joints.flags[ i ], unRequired ) ) << ( i & 63 );
+
+			if ( pTransform )
+				TransformBatch( joints, i, *pTransform );
+		}
+
+		if ( unRequired == 0 && joints.unCount < unBatchedCount )
+			joints.validBits[ ( unBatchedCount - 1 ) >> 6 ] &= ~( ( ( 1ull << ( unBatchedCount - joints.unCount ) ) - 1 ) << ( joints.unCount & 63 ) );
+	}
+
+} // namespace xrapp
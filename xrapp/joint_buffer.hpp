@@ -0,0 +1,85 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+
+#pragma once
+
+#include <bit>
+#include <cstdint>
+
+#include <openxr/openxr.h>
+
+namespace xrapp
+{
+	// Joints processed per kernel iteration (one simd register)
+	static constexpr uint32_t k_unJointBatchSize = 4;
+
+	// Joint buffer capacity - two hands use 52, the rest is room for more tracked hands or a body
+	static constexpr uint32_t k_unMaxTrackedJoints = 128;
+
+	// Tracked joints in structure of arrays layout so kernels can validate and transform a batch of joints per instruction.
+	// Joint sets are appended back to back (e.g. left hand then right hand) and joint i maps to renderable instance i.
+	struct SJointBuffer
+	{
+		alignas( 16 ) float posX[ k_unMaxTrackedJoints ] {};
+		alignas( 16 ) float posY[ k_unMaxTrackedJoints ] {};
+		alignas( 16 ) float posZ[ k_unMaxTrackedJoints ] {};
+
+		alignas( 16 ) float rotX[ k_unMaxTrackedJoints ] {};
+		alignas( 16 ) float rotY[ k_unMaxTrackedJoints ] {};
+		alignas( 16 ) float rotZ[ k_unMaxTrackedJoints ] {};
+		alignas( 16 ) float rotW[ k_unMaxTrackedJoints ] {};
+
+		alignas( 16 ) float radius[ k_unMaxTrackedJoints ] {};
+
+		// Low 32 bits of each joint's XrSpaceLocationFlags, where all the location bits live
+		alignas( 16 ) uint32_t flags[ k_unMaxTrackedJoints ] {};
+
+		// One bit per joint, set by UpdateJoints
+		uint64_t validBits[ k_unMaxTrackedJoints / 64 ] {};
+
+		uint32_t unCount = 0;
+
+		void Clear() { unCount = 0; }
+
+		// Copies a set of located joints into the buffer. Returns the buffer index of its first joint, or k_unMaxTrackedJoints if it doesn't fit.
+		uint32_t Append( const XrHandJointLocationEXT *pJoints, uint32_t unJointCount );
+
+		bool BIsValid( uint32_t unIndex ) const { return ( validBits[ unIndex >> 6 ] >> ( unIndex & 63 ) ) & 1; }
+
+		XrPosef GetPose( uint32_t unIndex ) const
+		{
+			return { { rotX[ unIndex ], rotY[ unIndex ], rotZ[ unIndex ], rotW[ unIndex ] }, { posX[ unIndex ], posY[ unIndex ], posZ[ unIndex ] } };
+		}
+	};
+
+	// Single pass over all appended joints on the calling thread: a joint is valid when all of requiredFlags are set,
+	// and if pTransform is provided every joint is moved into the space it describes (e.g. a tracked body's root or a world anchor).
+	void UpdateJoints( SJointBuffer &joints, XrSpaceLocationFlags requiredFlags = XR_SPACE_LOCATION_ORIENTATION_VALID_BIT, const XrPosef *pTransform = nullptr );
+
+	// Calls fn( index, pose, radius ) for each valid joint in index order
+	template < typename F >
+	void ForEachValidJoint( const SJointBuffer &joints, F &&fn )
+	{
+		for ( uint32_t w = 0; w < k_unMaxTrackedJoints / 64; w++ )
+		{
+			uint64_t bits = joints.validBits[ w ];
+			while ( bits )
+			{
+				uint32_t unIndex = ( w * 64 ) + std::countr_zero( bits );
+				fn( unIndex, joints.GetPose( unIndex ), joints.radius[ unIndex ] );
+				bits &= bits - 1;
+			}
+		}
+	}
+
+} // namespace xrapp
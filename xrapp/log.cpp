@@ -0,0 +1,181 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+
+
+#include <log.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <xrlib.hpp>
+
+namespace xrapp
+{
+	namespace
+	{
+		// Single producer (the owning thread), single consumer (the log thread) ring
+		struct SLogThread
+		{
+			std::atomic< uint64_t > unWrite { 0 };
+			std::atomic< uint64_t > unRead { 0 };
+			SLogRecord records[ CLog::k_unRingSize ];
+		};
+
+		// Thread rings outlive their threads so records pushed just before a worker exits still get written
+		struct SLogRegistry
+		{
+			std::mutex mutex;
+			std::vector< std::shared_ptr< SLogThread > > vecThreads;
+			std::atomic< uint64_t > unDropped { 0 };
+
+			std::mutex mutexWake;
+			std::condition_variable cvWake;
+			bool bStop = false;
+			std::thread thread;
+
+			std::mutex mutexDrain;	// one drain at a time (log thread or Flush)
+			std::vector< std::shared_ptr< SLogThread > > vecDrainThreads;
+
+			SLogRegistry()
+			{
+				thread = std::thread( [ this ]() { Run(); } );
+			}
+
+			~SLogRegistry()
+			{
+				{
+					std::scoped_lock lock( mutexWake );
+					bStop = true;
+				}
+
+				cvWake.notify_one();
+				thread.join();
+				Drain();
+			}
+
+			void Run()
+			{
+				std::unique_lock lock( mutexWake );
+				while ( !bStop )
+				{
+					// Producers don't signal regular records, polling keeps the logging call free of syscalls
+					cvWake.wait_for( lock, std::chrono::milliseconds( 10 ) );
+
+					lock.unlock();
+					Drain();
+					lock.lock();
+				}
+			}
+
+			void Drain()
+			{
+				std::scoped_lock lockDrain( mutexDrain );
+
+				{
+					std::scoped_lock lock( mutex );
+					vecDrainThreads.assign( vecThreads.begin(), vecThreads.end() );
+				}
+
+				char sText[ 1024 ];
+				for ( auto &pThread : vecDrainThreads )
+				{
+					const uint64_t unWrite = pThread->unWrite.load( std::memory_order_acquire );
+					uint64_t unRead = pThread->unRead.load( std::memory_order_relaxed );
+
+					for ( ; unRead < unWrite; unRead++ )
+					{
+						const SLogRecord &record = pThread->records[ unRead % CLog::k_unRingSize ];
+						record.fnFormat( sText, sizeof( sText ), record.pccFormat, record.payload );
+
+						switch ( record.unLevel )
+						{
+							case XRAPP_LOG_LEVEL_DEBUG:
+								LogDebug( record.sCategory, "%s", sText );
+								break;
+							case XRAPP_LOG_LEVEL_INFO:
+								LogInfo( record.sCategory, "%s", sText );
+								break;
+							default:
+								LogError( record.sCategory, "%s", sText );
+								break;
+						}
+					}
+
+					pThread->unRead.store( unRead, std::memory_order_release );
+				}
+			}
+		};
+
+		SLogRegistry &GetRegistry()
+		{
+			static SLogRegistry registry;
+			return registry;
+		}
+
+		// Only the first log call on each thread takes the registry lock
+		SLogThread &GetThread()
+		{
+			thread_local std::shared_ptr< SLogThread > pThread;
+			if ( !pThread )
+			{
+				pThread = std::make_shared< SLogThread >();
+
+				SLogRegistry &registry = GetRegistry();
+				std::scoped_lock lock( registry.mutex );
+				registry.vecThreads.push_back( pThread );
+			}
+
+			return *pThread;
+		}
+	}
+
+	SLogRecord *CLog::BeginRecord()
+	{
+		SLogThread &thread = GetThread();
+
+		const uint64_t unWrite = thread.unWrite.load( std::memory_order_relaxed );
+		if ( unWrite - thread.unRead.load( std::memory_order_acquire ) >= k_unRingSize )
+		{
+			GetRegistry().unDropped.fetch_add( 1, std::memory_order_relaxed );
+			return nullptr;
+		}
+
+		return &thread.records[ unWrite % k_unRingSize ];
+	}
+
+	void CLog::EndRecord( uint32_t unLevel )
+	{
+		SLogThread &thread = GetThread();
+		thread.unWrite.fetch_add( 1, std::memory_order_release );
+
+		// Errors are written out right away, they may come just before the app exits
+		if ( unLevel >= XRAPP_LOG_LEVEL_ERROR )
+			GetRegistry().cvWake.notify_one();
+	}
+
+	void CLog::Flush()
+	{
+		GetRegistry().Drain();
+	}
+
+	uint64_t CLog::GetDroppedCount()
+	{
+		return GetRegistry().unDropped.load( std::memory_order_relaxed );
+	}
+
+} // namespace xrapp
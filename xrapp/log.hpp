@@ -0,0 +1,185 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+// Async logging - arguments are copied to a per thread lock free ring and formatted on a background thread,
+// which then writes them out through xrlib's logger (its minimum log level still applies).
+// Calls below XRAPP_MIN_LOG_LEVEL compile to nothing (cmake: -D XRAPP_LOG_LEVEL=Debug|Info|Error).
+// Formats must be string literals. String arguments are copied and may be truncated, everything else must be trivially copyable.
+#define XRAPP_LOG_LEVEL_DEBUG 0
+#define XRAPP_LOG_LEVEL_INFO 1
+#define XRAPP_LOG_LEVEL_ERROR 2
+
+#ifndef XRAPP_MIN_LOG_LEVEL
+	#define XRAPP_MIN_LOG_LEVEL XRAPP_LOG_LEVEL_DEBUG
+#endif
+
+#if XRAPP_MIN_LOG_LEVEL <= XRAPP_LOG_LEVEL_DEBUG
+	#define XRAPP_LOG_DEBUG( category, format, ... ) xrapp::CLog::Push( XRAPP_LOG_LEVEL_DEBUG, category, format __VA_OPT__(, ) __VA_ARGS__ )
+#else
+	#define XRAPP_LOG_DEBUG( category, format, ... ) ( (void) 0 )
+#endif
+
+#if XRAPP_MIN_LOG_LEVEL <= XRAPP_LOG_LEVEL_INFO
+	#define XRAPP_LOG_INFO( category, format, ... ) xrapp::CLog::Push( XRAPP_LOG_LEVEL_INFO, category, format __VA_OPT__(, ) __VA_ARGS__ )
+#else
+	#define XRAPP_LOG_INFO( category, format, ... ) ( (void) 0 )
+#endif
+
+#if XRAPP_MIN_LOG_LEVEL <= XRAPP_LOG_LEVEL_ERROR
+	#define XRAPP_LOG_ERROR( category, format, ... ) xrapp::CLog::Push( XRAPP_LOG_LEVEL_ERROR, category, format __VA_OPT__(, ) __VA_ARGS__ )
+#else
+	#define XRAPP_LOG_ERROR( category, format, ... ) ( (void) 0 )
+#endif
+
+namespace xrapp
+{
+	// One log call as it sits in a thread's ring
+	struct SLogRecord
+	{
+		static constexpr size_t k_unCategorySize = 32;
+		static constexpr size_t k_unPayloadSize = 200;
+
+		using FormatFn = void ( * )( char *pOut, size_t unOutSize, const char *pccFormat, const uint8_t *pPayload );
+
+		FormatFn fnFormat = nullptr;
+		const char *pccFormat = nullptr;
+		uint32_t unLevel = 0;
+		char sCategory[ k_unCategorySize ] = {};
+		uint8_t payload[ k_unPayloadSize ];
+	};
+
+	// How a format argument is stored in a record's payload
+	template < typename T >
+	struct SLogArg
+	{
+		static_assert( std::is_trivially_copyable_v< T >, "Log arguments must be strings or trivially copyable" );
+		static constexpr size_t k_unMinSize = sizeof( T );
+
+		static void Write( uint8_t *&pOut, size_t &, const T &value )
+		{
+			std::memcpy( pOut, &value, sizeof( T ) );
+			pOut += sizeof( T );
+		}
+
+		static T Read( const uint8_t *&pIn )
+		{
+			T value;
+			std::memcpy( &value, pIn, sizeof( T ) );
+			pIn += sizeof( T );
+			return value;
+		}
+	};
+
+	// Strings are copied inline with their terminator, truncated to what's left of the payload
+	template <>
+	struct SLogArg< const char * >
+	{
+		static constexpr size_t k_unMinSize = 1;
+
+		static void Write( uint8_t *&pOut, size_t &unSpare, const char *pccValue )
+		{
+			const size_t unLength = pccValue ? std::min( std::strlen( pccValue ), unSpare ) : 0;
+			std::memcpy( pOut, pccValue, unLength );
+			pOut[ unLength ] = 0;
+			pOut += unLength + 1;
+			unSpare -= unLength;
+		}
+
+		static const char *Read( const uint8_t *&pIn )
+		{
+			const char *pccValue = reinterpret_cast< const char * >( pIn );
+			pIn += std::strlen( pccValue ) + 1;
+			return pccValue;
+		}
+	};
+
+	template <>
+	struct SLogArg< char * > : SLogArg< const char * > {};
+
+	class CLog
+	{
+	  public:
+		// Records per thread, calls made while a thread's ring is full are dropped (and counted)
+		static constexpr uint32_t k_unRingSize = 512;
+
+		template < typename... Args >
+		static void Push( uint32_t unLevel, std::string_view sCategory, const char *pccFormat, const Args &...args )
+		{
+			static_assert( ( SLogArg< std::decay_t< Args > >::k_unMinSize + ... + 0 ) <= SLogRecord::k_unPayloadSize, "Too many log arguments" );
+
+			SLogRecord *pRecord = BeginRecord();
+			if ( !pRecord )
+				return;
+
+			pRecord->fnFormat = &Format< std::decay_t< Args >... >;
+			pRecord->pccFormat = pccFormat;
+			pRecord->unLevel = unLevel;
+
+			const size_t unCategory = std::min( sCategory.size(), SLogRecord::k_unCategorySize - 1 );
+			std::memcpy( pRecord->sCategory, sCategory.data(), unCategory );
+			pRecord->sCategory[ unCategory ] = 0;
+
+			[[maybe_unused]] uint8_t *pOut = pRecord->payload;
+			[[maybe_unused]] size_t unSpare = SLogRecord::k_unPayloadSize - ( SLogArg< std::decay_t< Args > >::k_unMinSize + ... + 0 );
+			( SLogArg< std::decay_t< Args > >::Write( pOut, unSpare, args ), ... );
+
+			EndRecord( unLevel );
+		}
+
+		// Blocks until every record pushed so far is written out
+		static void Flush();
+
+		// Records dropped because a ring was full
+		static uint64_t GetDroppedCount();
+
+	  private:
+		static SLogRecord *BeginRecord();
+		static void EndRecord( uint32_t unLevel );
+
+		template < typename... Args >
+		static void Format( char *pOut, size_t unOutSize, const char *pccFormat, const uint8_t *pPayload )
+		{
+			if constexpr ( sizeof...( Args ) == 0 )
+			{
+				// Nothing to format, only unescape %%
+				size_t unOut = 0;
+				for ( const char *pcc = pccFormat; *pcc && unOut + 1 < unOutSize; pcc++ )
+				{
+					if ( pcc[ 0 ] == '%' && pcc[ 1 ] == '%' )
+						pcc++;
+					pOut[ unOut++ ] = *pcc;
+				}
+				pOut[ unOut ] = 0;
+			}
+			else
+			{
+				// Braced initialization reads the arguments in order
+				std::tuple< decltype( SLogArg< Args >::Read( pPayload ) )... > args { SLogArg< Args >::Read( pPayload )... };
+				std::apply( [ & ]( auto... values ) { std::snprintf( pOut, unOutSize, pccFormat, values... ); }, args );
+			}
+		}
+	};
+
+} // namespace xrapp
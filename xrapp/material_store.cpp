@@ -0,0 +1,105 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+
+#include <material_store.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace xrapp
+{
+	uint32_t CMaterialStore::Add( SMaterialUBO *pMaterial )
+	{
+		assert( pMaterial );
+
+		uint32_t unId = static_cast< uint32_t >( m_vecMaterials.size() );
+
+		m_vecMaterials.push_back( *pMaterial );
+		m_vecTargets.push_back( pMaterial );
+		m_vecDirtyRanges.push_back( {} );
+
+		if ( m_vecDirtyBits.size() * 64 < m_vecMaterials.size() )
+			m_vecDirtyBits.push_back( 0 );
+
+		m_stats.unMaterials = GetCount();
+
+		MarkDirty( unId );
+		return unId;
+	}
+
+	SMaterialUBO &CMaterialStore::Edit( uint32_t unId )
+	{
+		MarkDirty( unId );
+		return m_vecMaterials[ unId ];
+	}
+
+	void CMaterialStore::MarkDirty( uint32_t unId, uint32_t unOffset, uint32_t unSize )
+	{
+		assert( unId < m_vecMaterials.size() && unOffset + unSize <= sizeof( SMaterialUBO ) );
+
+		SDirtyRange &range = m_vecDirtyRanges[ unId ];
+		range.unBegin = std::min( range.unBegin, unOffset );
+		range.unEnd = std::max( range.unEnd, unOffset + unSize );
+
+		m_vecDirtyBits[ unId / 64 ] |= 1ull << ( unId % 64 );
+	}
+
+	uint32_t CMaterialStore::Flush()
+	{
+		m_vecFlushedRanges.clear();
+		m_stats.unFlushed = 0;
+		m_stats.unBytes = 0;
+
+		// Only walk dirty materials, a clean word of 64 materials is a single compare
+		for ( size_t w = 0; w < m_vecDirtyBits.size(); w++ )
+		{
+			uint64_t unBits = m_vecDirtyBits[ w ];
+			m_vecDirtyBits[ w ] = 0;
+
+			while ( unBits )
+			{
+				uint32_t unId = static_cast< uint32_t >( w * 64 + std::countr_zero( unBits ) );
+				unBits &= unBits - 1;
+
+				SDirtyRange &range = m_vecDirtyRanges[ unId ];
+				const uint32_t unSize = range.unEnd - range.unBegin;
+
+				uint8_t *pTarget = reinterpret_cast< uint8_t * >( m_vecTargets[ unId ] );
+				std::memcpy( pTarget + range.unBegin, reinterpret_cast< const uint8_t * >( &m_vecMaterials[ unId ] ) + range.unBegin, unSize );
+
+				// Merge with the previous range if this one starts where it ended (materials packed in one buffer)
+				if ( !m_vecFlushedRanges.empty() )
+				{
+					SMaterialRange &last = m_vecFlushedRanges.back();
+					if ( reinterpret_cast< uint8_t * >( last.pTarget ) + last.unOffset + last.unSize == pTarget + range.unBegin )
+						last.unSize += unSize;
+					else
+						m_vecFlushedRanges.push_back( { m_vecTargets[ unId ], range.unBegin, unSize } );
+				}
+				else
+				{
+					m_vecFlushedRanges.push_back( { m_vecTargets[ unId ], range.unBegin, unSize } );
+				}
+
+				m_stats.unFlushed++;
+				m_stats.unBytes += unSize;
+				range = {};
+			}
+		}
+
+		m_stats.unRanges = static_cast< uint32_t >( m_vecFlushedRanges.size() );
+		return m_stats.unFlushed;
+	}
+
+} // namespace xrapp
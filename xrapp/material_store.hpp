@@ -0,0 +1,99 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include <xrvk/render.hpp>
+
+namespace xrapp
+{
+	// Byte range of a material that was written in the last flush. Ranges of materials that sit next to each other in memory are merged.
+	struct SMaterialRange
+	{
+		SMaterialUBO *pTarget = nullptr;
+		uint32_t unOffset = 0;
+		uint32_t unSize = 0;
+	};
+
+	struct SMaterialStoreStats
+	{
+		uint32_t unMaterials = 0;	// tracked materials
+		uint32_t unFlushed = 0;		// materials written in the last flush
+		uint32_t unRanges = 0;		// merged ranges written in the last flush
+		uint64_t unBytes = 0;		// bytes written in the last flush
+	};
+
+	// Cpu copies of material ubo data with per material dirty tracking. Apps write to the copies from the main thread at any point in a frame,
+	// Flush() then writes only the changed bytes to the gpu visible materials while the render thread is idle (CFrameScheduler does this after publish).
+	// Materials that never change cost nothing after their first flush. Not thread safe.
+	class CMaterialStore
+	{
+	  public:
+		// Tracks a material (e.g. the one CRenderModel::LoadMaterial just added). Its current values are the starting point and get flushed once.
+		uint32_t Add( SMaterialUBO *pMaterial );
+
+		const SMaterialUBO &Get( uint32_t unId ) const { return m_vecMaterials[ unId ]; }
+
+		// Sets a field of a material's copy, e.g. Set( id, store.Get( id ).emissiveFactor[ 1 ], 0.5f ).
+		// The material is only marked dirty (for just that field) if the value changed.
+		template < typename T >
+		bool Set( uint32_t unId, const T &field, const T &value )
+		{
+			const uint8_t *pBase = reinterpret_cast< const uint8_t * >( &m_vecMaterials[ unId ] );
+			const uint8_t *pField = reinterpret_cast< const uint8_t * >( &field );
+			assert( pField >= pBase && pField + sizeof( T ) <= pBase + sizeof( SMaterialUBO ) );
+
+			if ( field == value )
+				return false;
+
+			const_cast< T & >( field ) = value;
+			MarkDirty( unId, static_cast< uint32_t >( pField - pBase ), sizeof( T ) );
+			return true;
+		}
+
+		// Writable copy of a whole material, marks all of it dirty
+		SMaterialUBO &Edit( uint32_t unId );
+
+		void MarkDirty( uint32_t unId, uint32_t unOffset = 0, uint32_t unSize = sizeof( SMaterialUBO ) );
+		bool BIsDirty( uint32_t unId ) const { return ( m_vecDirtyBits[ unId / 64 ] >> ( unId % 64 ) ) & 1; }
+
+		// Writes all dirty ranges to their materials and clears them. Returns the number of materials written.
+		uint32_t Flush();
+
+		// What the last flush wrote, for memory that needs an explicit flush (vkFlushMappedMemoryRanges) before the gpu reads it
+		const std::vector< SMaterialRange > &GetFlushedRanges() const { return m_vecFlushedRanges; }
+
+		const SMaterialStoreStats &GetStats() const { return m_stats; }
+		uint32_t GetCount() const { return static_cast< uint32_t >( m_vecMaterials.size() ); }
+
+	  private:
+		struct SDirtyRange
+		{
+			uint32_t unBegin = sizeof( SMaterialUBO );
+			uint32_t unEnd = 0;
+		};
+
+		std::vector< SMaterialUBO > m_vecMaterials;
+		std::vector< SMaterialUBO * > m_vecTargets;
+		std::vector< SDirtyRange > m_vecDirtyRanges;
+		std::vector< uint64_t > m_vecDirtyBits;
+		std::vector< SMaterialRange > m_vecFlushedRanges;
+
+		SMaterialStoreStats m_stats;
+	};
+
+} // namespace xrapp
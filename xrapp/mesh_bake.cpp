@@ -0,0 +1,485 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+
+#include <mesh_bake.hpp>
+#include <file_write.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include <tinygltf/tiny_gltf.h>
+
+#ifdef XR_USE_PLATFORM_ANDROID
+	// AAsset_getBuffer maps uncompressed assets directly
+#elif defined( _WIN32 )
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace xrapp
+{
+	namespace
+	{
+		std::string GetBaseDir( const std::string &sFilename )
+		{
+			size_t unPos = sFilename.find_last_of( "/\\" );
+			return unPos == std::string::npos ? "" : sFilename.substr( 0, unPos + 1 );
+		}
+
+		bool ReadFile( std::vector< uint8_t > &vecOut, const std::string &sFilename )
+		{
+			std::ifstream file( sFilename, std::ios::binary );
+			if ( !file )
+				return false;
+
+			vecOut.assign( std::istreambuf_iterator< char >( file ), std::istreambuf_iterator< char >() );
+			return true;
+		}
+
+		// GetFileSizeInBytes only exists in newer tinygltf versions
+		template< typename TCallbacks, typename TFunc >
+		auto SetFileSizeCallback( TCallbacks &fs, TFunc fn, int ) -> decltype( fs.GetFileSizeInBytes = fn, void() )
+		{
+			fs.GetFileSizeInBytes = fn;
+		}
+
+		template< typename TCallbacks, typename TFunc >
+		void SetFileSizeCallback( TCallbacks &, TFunc, long )
+		{
+		}
+
+		// Bake - record every external file tinygltf reads, keyed relative to the source's directory
+		struct SBakeContext
+		{
+			std::string sBaseDir;
+			std::vector< std::pair< std::string, std::vector< uint8_t > > > vecFiles;
+			std::vector< bool > vecIsImage;
+		};
+
+		bool Bake_FileExists( const std::string &sAbsFilename, void * )
+		{
+			std::ifstream file( sAbsFilename, std::ios::binary );
+			return file.good();
+		}
+
+		std::string Bake_ExpandFilePath( const std::string &sFilepath, void * ) { return sFilepath; }
+
+		bool Bake_ReadWholeFile( std::vector< unsigned char > *pOut, std::string *pErr, const std::string &sFilepath, void *pUserData )
+		{
+			auto pContext = static_cast< SBakeContext * >( pUserData );
+
+			if ( !ReadFile( *pOut, sFilepath ) )
+			{
+				if ( pErr )
+					( *pErr ) += "Unable to read file: " + sFilepath + "\n";
+				return false;
+			}
+
+			std::string sKey = sFilepath;
+			if ( !pContext->sBaseDir.empty() && sKey.rfind( pContext->sBaseDir, 0 ) == 0 )
+				sKey = sKey.substr( pContext->sBaseDir.size() );
+
+			pContext->vecFiles.push_back( { sKey, *pOut } );
+			pContext->vecIsImage.push_back( false );
+			return true;
+		}
+
+		bool Bake_WriteWholeFile( std::string *pErr, const std::string &, const std::vector< unsigned char > &, void * )
+		{
+			if ( pErr )
+				( *pErr ) += "Writing is not supported while baking.\n";
+			return false;
+		}
+
+		bool Bake_GetFileSize( size_t *pSize, std::string *, const std::string &sAbsFilename, void * )
+		{
+			std::ifstream file( sAbsFilename, std::ios::binary | std::ios::ate );
+			if ( !file )
+				return false;
+
+			*pSize = static_cast< size_t >( file.tellg() );
+			return true;
+		}
+
+		bool Bake_LoadImageData( tinygltf::Image *pImage, const int nImageIndex, std::string *pErr, std::string *pWarn, int nReqWidth, int nReqHeight, const unsigned char *pBytes, int nSize, void *pUserData )
+		{
+			auto pContext = static_cast< SBakeContext * >( pUserData );
+
+			// Image files are read right before they're decoded, their encoded bytes aren't needed in the bake
+			if ( !pContext->vecFiles.empty() )
+			{
+				auto &lastFile = pContext->vecFiles.back().second;
+				if ( lastFile.size() == static_cast< size_t >( nSize ) && std::memcmp( lastFile.data(), pBytes, lastFile.size() ) == 0 )
+					pContext->vecIsImage.back() = true;
+			}
+
+			return tinygltf::LoadImageData( pImage, nImageIndex, pErr, pWarn, nReqWidth, nReqHeight, pBytes, nSize, nullptr );
+		}
+
+		// Load - serve external files and decoded images straight from the mapped bake
+		struct SLoadContext
+		{
+			const uint8_t *pData = nullptr;
+			const SBakedMeshHeader *pHeader = nullptr;
+			const SBakedMeshFile *pFiles = nullptr;
+			const SBakedMeshImage *pImages = nullptr;
+
+			const SBakedMeshFile *FindFile( const std::string &sPath ) const
+			{
+				for ( uint32_t i = 0; i < pHeader->unFileCount; i++ )
+				{
+					const SBakedMeshFile &file = pFiles[ i ];
+					if ( file.unPathSize == sPath.size() && std::memcmp( pData + file.unPathOffset, sPath.data(), sPath.size() ) == 0 )
+						return &file;
+				}
+
+				return nullptr;
+			}
+		};
+
+		bool Load_FileExists( const std::string &sAbsFilename, void *pUserData )
+		{
+			return static_cast< SLoadContext * >( pUserData )->FindFile( sAbsFilename ) != nullptr;
+		}
+
+		std::string Load_ExpandFilePath( const std::string &sFilepath, void * ) { return sFilepath; }
+
+		bool Load_ReadWholeFile( std::vector< unsigned char > *pOut, std::string *pErr, const std::string &sFilepath, void *pUserData )
+		{
+			auto pContext = static_cast< SLoadContext * >( pUserData );
+
+			const SBakedMeshFile *pFile = pContext->FindFile( sFilepath );
+			if ( !pFile )
+			{
+				if ( pErr )
+					( *pErr ) += "File not found in baked mesh: " + sFilepath + "\n";
+				return false;
+			}
+
+			// Image files only need to be non-empty, the image loader reads pixels from the image table
+			if ( pFile->unDataSize == 0 )
+			{
+				pOut->assign( 1, 0 );
+				return true;
+			}
+
+			pOut->assign( pContext->pData + pFile->unDataOffset, pContext->pData + pFile->unDataOffset + pFile->unDataSize );
+			return true;
+		}
+
+		bool Load_WriteWholeFile( std::string *pErr, const std::string &, const std::vector< unsigned char > &, void * )
+		{
+			if ( pErr )
+				( *pErr ) += "Writing is not supported for baked meshes.\n";
+			return false;
+		}
+
+		bool Load_GetFileSize( size_t *pSize, std::string *, const std::string &sAbsFilename, void *pUserData )
+		{
+			const SBakedMeshFile *pFile = static_cast< SLoadContext * >( pUserData )->FindFile( sAbsFilename );
+			if ( !pFile )
+				return false;
+
+			*pSize = pFile->unDataSize == 0 ? 1 : static_cast< size_t >( pFile->unDataSize );
+			return true;
+		}
+
+		bool Load_LoadImageData( tinygltf::Image *pImage, const int nImageIndex, std::string *pErr, std::string *, int, int, const unsigned char *, int, void *pUserData )
+		{
+			auto pContext = static_cast< SLoadContext * >( pUserData );
+
+			if ( nImageIndex < 0 || static_cast< uint32_t >( nImageIndex ) >= pContext->pHeader->unImageCount )
+			{
+				if ( pErr )
+					( *pErr ) += "Image index out of range in baked mesh.\n";
+				return false;
+			}
+
+			const SBakedMeshImage &image = pContext->pImages[ nImageIndex ];
+			pImage->width = image.nWidth;
+			pImage->height = image.nHeight;
+			pImage->component = image.nComponent;
+			pImage->bits = image.nBits;
+			pImage->pixel_type = image.nPixelType;
+			pImage->image.assign( pContext->pData + image.unDataOffset, pContext->pData + image.unDataOffset + image.unDataSize );
+
+			return true;
+		}
+
+		void Append( std::vector< uint8_t > &vecOut, const void *pData, size_t unSize, uint64_t &unOutOffset )
+		{
+			vecOut.resize( ( vecOut.size() + k_unBakedMeshAlignment - 1 ) & ~( k_unBakedMeshAlignment - 1 ), 0 );
+			unOutOffset = vecOut.size();
+
+			const uint8_t *pBytes = static_cast< const uint8_t * >( pData );
+			vecOut.insert( vecOut.end(), pBytes, pBytes + unSize );
+		}
+	}
+
+	#ifdef XR_USE_PLATFORM_ANDROID
+
+		CMappedFile::CMappedFile( AAssetManager *pAssetManager, const std::string &sFilename )
+		{
+			if ( !pAssetManager )
+				return;
+
+			m_pAsset = AAssetManager_open( pAssetManager, sFilename.c_str(), AASSET_MODE_BUFFER );
+			if ( !m_pAsset )
+				return;
+
+			m_pData = static_cast< const uint8_t * >( AAsset_getBuffer( m_pAsset ) );
+			m_unSize = m_pData ? static_cast< size_t >( AAsset_getLength64( m_pAsset ) ) : 0;
+		}
+
+		CMappedFile::~CMappedFile()
+		{
+			if ( m_pAsset )
+				AAsset_close( m_pAsset );
+		}
+
+	#elif defined( _WIN32 )
+
+		CMappedFile::CMappedFile( const std::string &sFilename )
+		{
+			HANDLE hFile = CreateFileA( sFilename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+			if ( hFile == INVALID_HANDLE_VALUE )
+				return;
+
+			m_hFile = hFile;
+
+			LARGE_INTEGER size {};
+			if ( !GetFileSizeEx( hFile, &size ) || size.QuadPart == 0 )
+				return;
+
+			m_hMapping = CreateFileMappingA( hFile, nullptr, PAGE_READONLY, 0, 0, nullptr );
+			if ( !m_hMapping )
+				return;
+
+			m_pData = static_cast< const uint8_t * >( MapViewOfFile( m_hMapping, FILE_MAP_READ, 0, 0, 0 ) );
+			m_unSize = m_pData ? static_cast< size_t >( size.QuadPart ) : 0;
+		}
+
+		CMappedFile::~CMappedFile()
+		{
+			if ( m_pData )
+				UnmapViewOfFile( m_pData );
+
+			if ( m_hMapping )
+				CloseHandle( m_hMapping );
+
+			if ( m_hFile )
+				CloseHandle( m_hFile );
+		}
+
+	#else
+
+		CMappedFile::CMappedFile( const std::string &sFilename )
+		{
+			int nFile = open( sFilename.c_str(), O_RDONLY );
+			if ( nFile < 0 )
+				return;
+
+			struct stat fileStat {};
+			if ( fstat( nFile, &fileStat ) == 0 && fileStat.st_size > 0 )
+			{
+				void *pMapped = mmap( nullptr, static_cast< size_t >( fileStat.st_size ), PROT_READ, MAP_PRIVATE, nFile, 0 );
+				if ( pMapped != MAP_FAILED )
+				{
+					m_pData = static_cast< const uint8_t * >( pMapped );
+					m_unSize = static_cast< size_t >( fileStat.st_size );
+				}
+			}
+
+			// The mapping keeps its own reference to the file
+			close( nFile );
+		}
+
+		CMappedFile::~CMappedFile()
+		{
+			if ( m_pData )
+				munmap( const_cast< uint8_t * >( m_pData ), m_unSize );
+		}
+
+	#endif
+
+	bool BakeMesh( const std::string &sSourceFile, const std::string &sBakedFile, std::string &sError )
+	{
+		// (1) Read the source document
+		std::vector< uint8_t > vecSource;
+		if ( !ReadFile( vecSource, sSourceFile ) || vecSource.size() < 4 )
+		{
+			sError = "Unable to read: " + sSourceFile;
+			return false;
+		}
+
+		const bool bIsBinary = std::memcmp( vecSource.data(), "glTF", 4 ) == 0;
+
+		// (2) Load with tinygltf, recording external files and decoding images
+		SBakeContext context;
+		context.sBaseDir = GetBaseDir( sSourceFile );
+
+		tinygltf::FsCallbacks fs {};
+		fs.FileExists = &Bake_FileExists;
+		fs.ExpandFilePath = &Bake_ExpandFilePath;
+		fs.ReadWholeFile = &Bake_ReadWholeFile;
+		fs.WriteWholeFile = &Bake_WriteWholeFile;
+		fs.user_data = &context;
+		SetFileSizeCallback( fs, &Bake_GetFileSize, 0 );
+
+		tinygltf::TinyGLTF loader;
+		loader.SetFsCallbacks( fs );
+		loader.SetImageLoader( &Bake_LoadImageData, &context );
+
+		tinygltf::Model model;
+		std::string sWarn;
+		bool bLoaded = bIsBinary ?
+			loader.LoadBinaryFromMemory( &model, &sError, &sWarn, vecSource.data(), static_cast< unsigned int >( vecSource.size() ), context.sBaseDir ) :
+			loader.LoadASCIIFromString( &model, &sError, &sWarn, reinterpret_cast< const char * >( vecSource.data() ), static_cast< unsigned int >( vecSource.size() ), context.sBaseDir );
+
+		if ( !bLoaded )
+			return false;
+
+		// (3) Lay out the bake: header, source, file table, image table, then the data they point to
+		SBakedMeshHeader header;
+		header.unIsBinary = bIsBinary ? 1 : 0;
+		header.unFileCount = static_cast< uint32_t >( context.vecFiles.size() );
+		header.unImageCount = static_cast< uint32_t >( model.images.size() );
+
+		std::vector< SBakedMeshFile > vecFiles( header.unFileCount );
+		std::vector< SBakedMeshImage > vecImages( header.unImageCount );
+
+		std::vector< uint8_t > vecOut;
+		uint64_t unHeaderOffset = 0;
+		Append( vecOut, &header, sizeof( header ), unHeaderOffset );
+		Append( vecOut, vecSource.data(), vecSource.size(), header.unSourceOffset );
+		header.unSourceSize = vecSource.size();
+
+		for ( uint32_t i = 0; i < header.unFileCount; i++ )
+		{
+			auto &file = context.vecFiles[ i ];
+			Append( vecOut, file.first.data(), file.first.size(), vecFiles[ i ].unPathOffset );
+			vecFiles[ i ].unPathSize = file.first.size();
+
+			if ( !context.vecIsImage[ i ] )
+			{
+				Append( vecOut, file.second.data(), file.second.size(), vecFiles[ i ].unDataOffset );
+				vecFiles[ i ].unDataSize = file.second.size();
+			}
+		}
+
+		for ( uint32_t i = 0; i < header.unImageCount; i++ )
+		{
+			auto &image = model.images[ i ];
+			Append( vecOut, image.image.data(), image.image.size(), vecImages[ i ].unDataOffset );
+			vecImages[ i ].unDataSize = image.image.size();
+			vecImages[ i ].nWidth = image.width;
+			vecImages[ i ].nHeight = image.height;
+			vecImages[ i ].nComponent = image.component;
+			vecImages[ i ].nBits = image.bits;
+			vecImages[ i ].nPixelType = image.pixel_type;
+		}
+
+		Append( vecOut, vecFiles.data(), vecFiles.size() * sizeof( SBakedMeshFile ), header.unFilesOffset );
+		Append( vecOut, vecImages.data(), vecImages.size() * sizeof( SBakedMeshImage ), header.unImagesOffset );
+		std::memcpy( vecOut.data() + unHeaderOffset, &header, sizeof( header ) );
+
+		// (4) Write out
+		return WriteFileAtomic(
+			sBakedFile,
+			[ &vecOut ]( std::ostream &out ) { return static_cast< bool >( out.write( reinterpret_cast< const char * >( vecOut.data() ), static_cast< std::streamsize >( vecOut.size() ) ) ); },
+			sError );
+	}
+
+	bool LoadBakedMesh( tinygltf::Model *pOutModel, const CMappedFile &bakedFile, std::string &sError )
+	{
+		if ( !pOutModel || !bakedFile.BIsValid() || bakedFile.GetSize() < sizeof( SBakedMeshHeader ) )
+		{
+			sError = "Invalid baked mesh.";
+			return false;
+		}
+
+		// (1) Validate header and tables
+		const uint8_t *pData = bakedFile.GetData();
+		const size_t unSize = bakedFile.GetSize();
+		const SBakedMeshHeader *pHeader = reinterpret_cast< const SBakedMeshHeader * >( pData );
+
+		if ( pHeader->unMagic != k_unBakedMeshMagic || pHeader->unVersion != k_unBakedMeshVersion )
+		{
+			sError = "Baked mesh has an unsupported format or version, re-bake it.";
+			return false;
+		}
+
+		auto InRange = [ unSize ]( uint64_t unOffset, uint64_t unLength ) { return unOffset <= unSize && unLength <= unSize - unOffset; };
+
+		if ( !InRange( pHeader->unSourceOffset, pHeader->unSourceSize ) ||
+			 !InRange( pHeader->unFilesOffset, uint64_t( pHeader->unFileCount ) * sizeof( SBakedMeshFile ) ) ||
+			 !InRange( pHeader->unImagesOffset, uint64_t( pHeader->unImageCount ) * sizeof( SBakedMeshImage ) ) )
+		{
+			sError = "Baked mesh is truncated.";
+			return false;
+		}
+
+		SLoadContext context;
+		context.pData = pData;
+		context.pHeader = pHeader;
+		context.pFiles = reinterpret_cast< const SBakedMeshFile * >( pData + pHeader->unFilesOffset );
+		context.pImages = reinterpret_cast< const SBakedMeshImage * >( pData + pHeader->unImagesOffset );
+
+		for ( uint32_t i = 0; i < pHeader->unFileCount; i++ )
+		{
+			if ( !InRange( context.pFiles[ i ].unPathOffset, context.pFiles[ i ].unPathSize ) || !InRange( context.pFiles[ i ].unDataOffset, context.pFiles[ i ].unDataSize ) )
+			{
+				sError = "Baked mesh is truncated.";
+				return false;
+			}
+		}
+
+		for ( uint32_t i = 0; i < pHeader->unImageCount; i++ )
+		{
+			if ( !InRange( context.pImages[ i ].unDataOffset, context.pImages[ i ].unDataSize ) )
+			{
+				sError = "Baked mesh is truncated.";
+				return false;
+			}
+		}
+
+		// (2) Parse the gltf document, external files and images come from the mapping
+		tinygltf::FsCallbacks fs {};
+		fs.FileExists = &Load_FileExists;
+		fs.ExpandFilePath = &Load_ExpandFilePath;
+		fs.ReadWholeFile = &Load_ReadWholeFile;
+		fs.WriteWholeFile = &Load_WriteWholeFile;
+		fs.user_data = &context;
+		SetFileSizeCallback( fs, &Load_GetFileSize, 0 );
+
+		tinygltf::TinyGLTF loader;
+		loader.SetFsCallbacks( fs );
+		loader.SetImageLoader( &Load_LoadImageData, &context );
+
+		std::string sWarn;
+		const uint8_t *pSource = pData + pHeader->unSourceOffset;
+
+		return pHeader->unIsBinary ?
+			loader.LoadBinaryFromMemory( pOutModel, &sError, &sWarn, pSource, static_cast< unsigned int >( pHeader->unSourceSize ), "" ) :
+			loader.LoadASCIIFromString( pOutModel, &sError, &sWarn, reinterpret_cast< const char * >( pSource ), static_cast< unsigned int >( pHeader->unSourceSize ), "" );
+	}
+
+} // namespace xrapp
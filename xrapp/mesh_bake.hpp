@@ -0,0 +1,109 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#ifdef XR_USE_PLATFORM_ANDROID
+	#include <android/asset_manager.h>
+#endif
+
+namespace tinygltf
+{
+	class Model;
+}
+
+namespace xrapp
+{
+	// Baked mesh (.xrmesh): the source gltf/glb followed by its external buffers and pre-decoded images.
+	// Loading one skips image decoding and filesystem lookups, the gltf document itself is still parsed.
+	static constexpr const char *k_pccBakedMeshExtension = ".xrmesh";
+	static constexpr uint32_t k_unBakedMeshMagic = 0x424D5258; // XRMB
+	static constexpr uint32_t k_unBakedMeshVersion = 1;
+	static constexpr uint64_t k_unBakedMeshAlignment = 16;
+
+	struct SBakedMeshHeader
+	{
+		uint32_t unMagic = k_unBakedMeshMagic;
+		uint32_t unVersion = k_unBakedMeshVersion;
+		uint32_t unIsBinary = 0;	// source was a glb
+		uint32_t unFileCount = 0;	// external buffers, keyed by the path tinygltf asked for
+		uint32_t unImageCount = 0;	// decoded images, indexed as in the gltf
+		uint32_t unReserved = 0;
+		uint64_t unSourceOffset = 0;
+		uint64_t unSourceSize = 0;
+		uint64_t unFilesOffset = 0;	// SBakedMeshFile[ unFileCount ]
+		uint64_t unImagesOffset = 0; // SBakedMeshImage[ unImageCount ]
+	};
+
+	struct SBakedMeshFile
+	{
+		uint64_t unPathOffset = 0;
+		uint64_t unPathSize = 0;
+		uint64_t unDataOffset = 0;
+		uint64_t unDataSize = 0;	// 0 for image files, their pixels are in the image table
+	};
+
+	struct SBakedMeshImage
+	{
+		uint64_t unDataOffset = 0;
+		uint64_t unDataSize = 0;
+		int32_t nWidth = 0;
+		int32_t nHeight = 0;
+		int32_t nComponent = 0;
+		int32_t nBits = 0;
+		int32_t nPixelType = 0;
+		int32_t nReserved = 0;
+	};
+
+	// Read only memory mapped file, on android this maps an apk asset
+	class CMappedFile
+	{
+	  public:
+		#ifdef XR_USE_PLATFORM_ANDROID
+			CMappedFile( AAssetManager *pAssetManager, const std::string &sFilename );
+		#else
+			CMappedFile( const std::string &sFilename );
+		#endif
+
+		~CMappedFile();
+
+		CMappedFile( const CMappedFile & ) = delete;
+		CMappedFile &operator=( const CMappedFile & ) = delete;
+
+		bool BIsValid() const { return m_pData != nullptr; }
+		const uint8_t *GetData() const { return m_pData; }
+		size_t GetSize() const { return m_unSize; }
+
+	  private:
+		const uint8_t *m_pData = nullptr;
+		size_t m_unSize = 0;
+
+		#ifdef XR_USE_PLATFORM_ANDROID
+			AAsset *m_pAsset = nullptr;
+		#elif defined( _WIN32 )
+			void *m_hFile = nullptr;
+			void *m_hMapping = nullptr;
+		#endif
+	};
+
+	// Offline - load a gltf/glb (decoding its images) and write it out as a baked mesh
+	bool BakeMesh( const std::string &sSourceFile, const std::string &sBakedFile, std::string &sError );
+
+	// Runtime - rebuild a tinygltf model from a mapped baked mesh
+	bool LoadBakedMesh( tinygltf::Model *pOutModel, const CMappedFile &bakedFile, std::string &sError );
+
+} // namespace xrapp
@@ -0,0 +1,252 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+
+
+#include <passthrough_geometry.hpp>
+
+#include <cmath>
+#include <numbers>
+
+namespace xrapp
+{
+	namespace
+	{
+		constexpr uint32_t k_unDiscSegments = 32;
+
+		template< typename T >
+		void LoadFunction( XrInstance xrInstance, const char *pccName, T &pfn )
+		{
+			if ( !XR_UNQUALIFIED_SUCCESS( xrGetInstanceProcAddr( xrInstance, pccName, reinterpret_cast< PFN_xrVoidFunction * >( &pfn ) ) ) )
+				pfn = nullptr;
+		}
+
+		void BuildShape( EPassthroughShape eShape, std::vector< XrVector3f > &vecVertices, std::vector< uint32_t > &vecIndices )
+		{
+			switch ( eShape )
+			{
+				case EPassthroughShape::Quad:
+					vecVertices = { { -0.5f, 0.5f, 0.f }, { 0.5f, 0.5f, 0.f }, { 0.5f, -0.5f, 0.f }, { -0.5f, -0.5f, 0.f } };
+					vecIndices = { 0, 1, 2, 2, 3, 0 };
+					break;
+
+				case EPassthroughShape::Disc:
+					// Center then the rim, fanned
+					vecVertices.push_back( { 0.f, 0.f, 0.f } );
+					for ( uint32_t i = 0; i < k_unDiscSegments; i++ )
+					{
+						float fAngle = 2.f * std::numbers::pi_v< float > * static_cast< float >( i ) / static_cast< float >( k_unDiscSegments );
+						vecVertices.push_back( { 0.5f * std::cos( fAngle ), 0.5f * std::sin( fAngle ), 0.f } );
+					}
+
+					for ( uint32_t i = 0; i < k_unDiscSegments; i++ )
+						vecIndices.insert( vecIndices.end(), { 0, 1 + ( i + 1 ) % k_unDiscSegments, 1 + i } );
+					break;
+
+				case EPassthroughShape::Box:
+					vecVertices = {
+						{ -0.5f, -0.5f, -0.5f }, { 0.5f, -0.5f, -0.5f }, { 0.5f, 0.5f, -0.5f }, { -0.5f, 0.5f, -0.5f },
+						{ -0.5f, -0.5f, 0.5f }, { 0.5f, -0.5f, 0.5f }, { 0.5f, 0.5f, 0.5f }, { -0.5f, 0.5f, 0.5f } };
+					vecIndices = {
+						4, 6, 5, 4, 7, 6,	// front (+z)
+						1, 3, 0, 1, 2, 3,	// back
+						0, 7, 4, 0, 3, 7,	// left
+						5, 2, 1, 5, 6, 2,	// right
+						7, 2, 6, 7, 3, 2,	// top
+						0, 5, 1, 0, 4, 5 };	// bottom
+					break;
+
+				case EPassthroughShape::Count:
+				default:
+					break;
+			}
+		}
+	}
+
+	CPassthroughGeometry::CPassthroughGeometry( XrInstance xrInstance, XrSession xrSession )
+		: m_xrSession( xrSession )
+	{
+		LoadFunction( xrInstance, "xrCreateTriangleMeshFB", m_pfnCreateTriangleMesh );
+		LoadFunction( xrInstance, "xrDestroyTriangleMeshFB", m_pfnDestroyTriangleMesh );
+		LoadFunction( xrInstance, "xrCreateGeometryInstanceFB", m_pfnCreateGeometryInstance );
+		LoadFunction( xrInstance, "xrDestroyGeometryInstanceFB", m_pfnDestroyGeometryInstance );
+		LoadFunction( xrInstance, "xrGeometryInstanceSetTransformFB", m_pfnGeometryInstanceSetTransform );
+
+		// All or nothing
+		if ( !m_pfnCreateTriangleMesh || !m_pfnDestroyTriangleMesh || !m_pfnDestroyGeometryInstance || !m_pfnGeometryInstanceSetTransform )
+			m_pfnCreateGeometryInstance = nullptr;
+	}
+
+	CPassthroughGeometry::~CPassthroughGeometry()
+	{
+		if ( !BIsValid() )
+			return;
+
+		// Instances before the meshes they reference
+		for ( int32_t i = 0; i < static_cast< int32_t >( m_vecInstances.size() ); i++ )
+			Remove( i );
+
+		for ( auto &xrMesh : m_xrShapeMeshes )
+		{
+			if ( xrMesh != XR_NULL_HANDLE )
+				m_pfnDestroyTriangleMesh( xrMesh );
+		}
+	}
+
+	int32_t CPassthroughGeometry::Add( XrPassthroughLayerFB xrLayer, EPassthroughShape eShape, XrSpace baseSpace, const XrPosef &pose, const XrVector3f &scale )
+	{
+		XrTriangleMeshFB xrMesh = GetShapeMesh( eShape );
+		if ( xrMesh == XR_NULL_HANDLE )
+			return -1;
+
+		return AddInstance( xrLayer, xrMesh, XR_NULL_HANDLE, baseSpace, pose, scale );
+	}
+
+	int32_t CPassthroughGeometry::Add( XrPassthroughLayerFB xrLayer, const std::vector< XrVector3f > &vecVertices, const std::vector< uint32_t > &vecIndices, XrSpace baseSpace, const XrPosef &pose, const XrVector3f &scale )
+	{
+		XrTriangleMeshFB xrMesh = CreateMesh( vecVertices, vecIndices );
+		if ( xrMesh == XR_NULL_HANDLE )
+			return -1;
+
+		int32_t nId = AddInstance( xrLayer, xrMesh, xrMesh, baseSpace, pose, scale );
+		if ( nId < 0 )
+			m_pfnDestroyTriangleMesh( xrMesh );
+
+		return nId;
+	}
+
+	XrResult CPassthroughGeometry::Update( int32_t nId, XrTime time, const XrPosef &pose, const XrVector3f &scale )
+	{
+		if ( nId < 0 || nId >= static_cast< int32_t >( m_vecInstances.size() ) || m_vecInstances[ nId ].xrInstance == XR_NULL_HANDLE )
+			return XR_ERROR_HANDLE_INVALID;
+
+		SGeometryInstance &instance = m_vecInstances[ nId ];
+		if ( BIsUnchanged( instance, pose, scale ) )
+		{
+			m_stats.unSkipped++;
+			return XR_SUCCESS;
+		}
+
+		XrGeometryInstanceTransformFB transform { XR_TYPE_GEOMETRY_INSTANCE_TRANSFORM_FB };
+		transform.baseSpace = instance.baseSpace;
+		transform.time = time;
+		transform.pose = pose;
+		transform.scale = scale;
+
+		XrResult result = m_pfnGeometryInstanceSetTransform( instance.xrInstance, &transform );
+		if ( !XR_UNQUALIFIED_SUCCESS( result ) )
+			return result;
+
+		instance.pose = pose;
+		instance.scale = scale;
+		m_stats.unUpdates++;
+		return result;
+	}
+
+	void CPassthroughGeometry::Remove( int32_t nId )
+	{
+		if ( nId < 0 || nId >= static_cast< int32_t >( m_vecInstances.size() ) )
+			return;
+
+		SGeometryInstance &instance = m_vecInstances[ nId ];
+		if ( instance.xrInstance == XR_NULL_HANDLE )
+			return;
+
+		m_pfnDestroyGeometryInstance( instance.xrInstance );
+		if ( instance.xrOwnedMesh != XR_NULL_HANDLE )
+			m_pfnDestroyTriangleMesh( instance.xrOwnedMesh );
+
+		instance = {};
+		m_stats.unInstances--;
+	}
+
+	XrTriangleMeshFB CPassthroughGeometry::CreateMesh( const std::vector< XrVector3f > &vecVertices, const std::vector< uint32_t > &vecIndices )
+	{
+		if ( !BIsValid() || vecVertices.empty() || vecIndices.size() < 3 )
+			return XR_NULL_HANDLE;
+
+		XrTriangleMeshCreateInfoFB createInfo { XR_TYPE_TRIANGLE_MESH_CREATE_INFO_FB };
+		createInfo.windingOrder = XR_WINDING_ORDER_UNKNOWN_FB;
+		createInfo.vertexCount = static_cast< uint32_t >( vecVertices.size() );
+		createInfo.vertexBuffer = vecVertices.data();
+		createInfo.triangleCount = static_cast< uint32_t >( vecIndices.size() / 3 );
+		createInfo.indexBuffer = vecIndices.data();
+
+		XrTriangleMeshFB xrMesh = XR_NULL_HANDLE;
+		if ( !XR_UNQUALIFIED_SUCCESS( m_pfnCreateTriangleMesh( m_xrSession, &createInfo, &xrMesh ) ) )
+			return XR_NULL_HANDLE;
+
+		m_stats.unMeshes++;
+		return xrMesh;
+	}
+
+	XrTriangleMeshFB CPassthroughGeometry::GetShapeMesh( EPassthroughShape eShape )
+	{
+		if ( eShape >= EPassthroughShape::Count )
+			return XR_NULL_HANDLE;
+
+		// Created on first use, then shared
+		XrTriangleMeshFB &xrMesh = m_xrShapeMeshes[ static_cast< size_t >( eShape ) ];
+		if ( xrMesh == XR_NULL_HANDLE )
+		{
+			std::vector< XrVector3f > vecVertices;
+			std::vector< uint32_t > vecIndices;
+			BuildShape( eShape, vecVertices, vecIndices );
+			xrMesh = CreateMesh( vecVertices, vecIndices );
+		}
+
+		return xrMesh;
+	}
+
+	int32_t CPassthroughGeometry::AddInstance( XrPassthroughLayerFB xrLayer, XrTriangleMeshFB xrMesh, XrTriangleMeshFB xrOwnedMesh, XrSpace baseSpace, const XrPosef &pose, const XrVector3f &scale )
+	{
+		XrGeometryInstanceCreateInfoFB createInfo { XR_TYPE_GEOMETRY_INSTANCE_CREATE_INFO_FB };
+		createInfo.layer = xrLayer;
+		createInfo.mesh = xrMesh;
+		createInfo.baseSpace = baseSpace;
+		createInfo.pose = pose;
+		createInfo.scale = scale;
+
+		XrGeometryInstanceFB xrInstance = XR_NULL_HANDLE;
+		if ( !XR_UNQUALIFIED_SUCCESS( m_pfnCreateGeometryInstance( m_xrSession, &createInfo, &xrInstance ) ) )
+			return -1;
+
+		// Reuse a free slot so ids stay small
+		int32_t nId = 0;
+		while ( nId < static_cast< int32_t >( m_vecInstances.size() ) && m_vecInstances[ nId ].xrInstance != XR_NULL_HANDLE )
+			nId++;
+
+		if ( nId == static_cast< int32_t >( m_vecInstances.size() ) )
+			m_vecInstances.emplace_back();
+
+		SGeometryInstance &instance = m_vecInstances[ nId ];
+		instance.xrInstance = xrInstance;
+		instance.xrOwnedMesh = xrOwnedMesh;
+		instance.baseSpace = baseSpace;
+		instance.pose = pose;
+		instance.scale = scale;
+
+		m_stats.unInstances++;
+		return nId;
+	}
+
+	bool CPassthroughGeometry::BIsUnchanged( const SGeometryInstance &instance, const XrPosef &pose, const XrVector3f &scale ) const
+	{
+		auto BNear = [ fEpsilon = fEpsilon ]( float a, float b ) { return std::fabs( a - b ) <= fEpsilon; };
+
+		return BNear( instance.pose.position.x, pose.position.x ) && BNear( instance.pose.position.y, pose.position.y ) && BNear( instance.pose.position.z, pose.position.z ) &&
+			   BNear( instance.pose.orientation.x, pose.orientation.x ) && BNear( instance.pose.orientation.y, pose.orientation.y ) &&
+			   BNear( instance.pose.orientation.z, pose.orientation.z ) && BNear( instance.pose.orientation.w, pose.orientation.w ) &&
+			   BNear( instance.scale.x, scale.x ) && BNear( instance.scale.y, scale.y ) && BNear( instance.scale.z, scale.z );
+	}
+
+} // namespace xrapp
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <openxr/openxr.h>
+
+namespace xrapp
+{
+	// Built-in passthrough shapes, unit sized and centered on the origin. Quad and disc are in the xy plane.
+	enum class EPassthroughShape
+	{
+		Quad = 0,
+		Disc = 1,
+		Box = 2,
+		Count
+	};
+
+	struct SPassthroughGeometryStats
+	{
+		uint32_t unMeshes = 0;		// triangle meshes created, shared by all instances of a shape
+		uint32_t unInstances = 0;	// live geometry instances
+		uint32_t unUpdates = 0;		// transforms sent to the runtime
+		uint32_t unSkipped = 0;		// transforms within fEpsilon of the last one sent
+	};
+
+	// Geometry instances on a mesh projection passthrough layer (XR_FB_triangle_mesh). Each shape's triangle mesh is
+	// created once and shared by every instance of it, and transforms only reach the runtime when they change.
+	class CPassthroughGeometry
+	{
+	  public:
+		CPassthroughGeometry( XrInstance xrInstance, XrSession xrSession );
+		~CPassthroughGeometry();
+
+		CPassthroughGeometry( const CPassthroughGeometry & ) = delete;
+		CPassthroughGeometry &operator=( const CPassthroughGeometry & ) = delete;
+
+		// False if the runtime doesn't provide the triangle mesh functions
+		bool BIsValid() const { return m_pfnCreateGeometryInstance != nullptr; }
+
+		// Adds an instance of a built-in shape to the layer. Returns its id for Update() and Remove(), or -1 on failure.
+		int32_t Add( XrPassthroughLayerFB xrLayer, EPassthroughShape eShape, XrSpace baseSpace, const XrPosef &pose, const XrVector3f &scale = { 1.f, 1.f, 1.f } );
+
+		// Same for a custom mesh, which isn't shared with other instances
+		int32_t Add( XrPassthroughLayerFB xrLayer, const std::vector< XrVector3f > &vecVertices, const std::vector< uint32_t > &vecIndices, XrSpace baseSpace, const XrPosef &pose, const XrVector3f &scale = { 1.f, 1.f, 1.f } );
+
+		// Moves an instance. Returns XR_SUCCESS without calling the runtime if pose and scale are within fEpsilon of what was last sent.
+		XrResult Update( int32_t nId, XrTime time, const XrPosef &pose, const XrVector3f &scale );
+
+		// Destroys the instance, its id is reused by later adds
+		void Remove( int32_t nId );
+
+		const SPassthroughGeometryStats &GetStats() const { return m_stats; }
+
+		float fEpsilon = 1e-4f;
+
+	  private:
+		struct SGeometryInstance
+		{
+			XrGeometryInstanceFB xrInstance = XR_NULL_HANDLE;
+			XrTriangleMeshFB xrOwnedMesh = XR_NULL_HANDLE;	// custom meshes only
+			XrSpace baseSpace = XR_NULL_HANDLE;
+			XrPosef pose { { 0.f, 0.f, 0.f, 1.f }, { 0.f, 0.f, 0.f } };
+			XrVector3f scale { 1.f, 1.f, 1.f };
+		};
+
+		XrTriangleMeshFB CreateMesh( const std::vector< XrVector3f > &vecVertices, const std::vector< uint32_t > &vecIndices );
+		XrTriangleMeshFB GetShapeMesh( EPassthroughShape eShape );
+		int32_t AddInstance( XrPassthroughLayerFB xrLayer, XrTriangleMeshFB xrMesh, XrTriangleMeshFB xrOwnedMesh, XrSpace baseSpace, const XrPosef &pose, const XrVector3f &scale );
+		bool BIsUnchanged( const SGeometryInstance &instance, const XrPosef &pose, const XrVector3f &scale ) const;
+
+		XrSession m_xrSession = XR_NULL_HANDLE;
+
+		PFN_xrCreateTriangleMeshFB m_pfnCreateTriangleMesh = nullptr;
+		PFN_xrDestroyTriangleMeshFB m_pfnDestroyTriangleMesh = nullptr;
+		PFN_xrCreateGeometryInstanceFB m_pfnCreateGeometryInstance = nullptr;
+		PFN_xrDestroyGeometryInstanceFB m_pfnDestroyGeometryInstance = nullptr;
+		PFN_xrGeometryInstanceSetTransformFB m_pfnGeometryInstanceSetTransform = nullptr;
+
+		XrTriangleMeshFB m_xrShapeMeshes[ static_cast< size_t >( EPassthroughShape::Count ) ] {};
+		std::vector< SGeometryInstance > m_vecInstances;	// slots with a null instance are free
+		SPassthroughGeometryStats m_stats;
+	};
+
+} // namespace xrapp
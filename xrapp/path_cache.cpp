@@ -0,0 +1,132 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+
+
+#include <path_cache.hpp>
+
+#include <mutex>
+
+namespace xrapp
+{
+	namespace
+	{
+		const std::string k_sEmpty;
+	}
+
+	XrPath CPathCache::GetPath( std::string_view sPath )
+	{
+		{
+			std::shared_lock lock( m_mutex );
+			auto it = m_mapPaths.find( sPath );
+			if ( it != m_mapPaths.end() )
+				return it->second;
+		}
+
+		// Runtime wants a null terminated string
+		const std::string sPathString( sPath );
+		XrPath path = XR_NULL_PATH;
+		if ( !XR_UNQUALIFIED_SUCCESS( xrStringToPath( m_xrInstance, sPathString.c_str(), &path ) ) )
+			return XR_NULL_PATH;
+
+		Insert( path, sPathString );
+		return path;
+	}
+
+	const std::string &CPathCache::GetString( XrPath path )
+	{
+		if ( path == XR_NULL_PATH )
+			return k_sEmpty;
+
+		{
+			std::shared_lock lock( m_mutex );
+			auto it = m_mapStrings.find( path );
+			if ( it != m_mapStrings.end() )
+				return it->second;
+		}
+
+		uint32_t unCount = 0;
+		char sPath[ XR_MAX_PATH_LENGTH ];
+		if ( !XR_UNQUALIFIED_SUCCESS( xrPathToString( m_xrInstance, path, sizeof( sPath ), &unCount, sPath ) ) )
+			return k_sEmpty;
+
+		Insert( path, sPath );
+
+		std::shared_lock lock( m_mutex );
+		return m_mapStrings.find( path )->second;
+	}
+
+	void CPathCache::Warm( const std::vector< std::string > &vecPaths )
+	{
+		for ( auto &sPath : vecPaths )
+			GetPath( sPath );
+	}
+
+	std::vector< std::string > CPathCache::GetCommonPaths()
+	{
+		static const char *k_pccProfiles[] = {
+			"/interaction_profiles/valve/index_controller",
+			"/interaction_profiles/oculus/touch_controller",
+			"/interaction_profiles/htc/vive_controller",
+			"/interaction_profiles/microsoft/motion_controller",
+			"/interaction_profiles/ext/hand_interaction_ext" };
+
+		static const char *k_pccComponents[] = {
+			"/input/grip/pose",
+			"/input/aim/pose",
+			"/input/trigger/value",
+			"/input/trigger/click",
+			"/input/squeeze/value",
+			"/input/squeeze/click",
+			"/input/a/click",
+			"/input/b/click",
+			"/input/x/click",
+			"/input/y/click",
+			"/input/menu/click",
+			"/input/system/click",
+			"/input/thumbstick",
+			"/input/trackpad",
+			"/input/pinch_ext/pose",
+			"/input/pinch_ext/value",
+			"/input/grasp_ext/value",
+			"/input/poke_ext/pose",
+			"/output/haptic" };
+
+		static const char *k_pccHands[] = { "/user/hand/left", "/user/hand/right" };
+
+		std::vector< std::string > vecPaths = { "/user/head" };
+		vecPaths.insert( vecPaths.end(), std::begin( k_pccProfiles ), std::end( k_pccProfiles ) );
+
+		for ( const char *pccHand : k_pccHands )
+		{
+			vecPaths.push_back( pccHand );
+			for ( const char *pccComponent : k_pccComponents )
+				vecPaths.push_back( std::string( pccHand ) + pccComponent );
+		}
+
+		return vecPaths;
+	}
+
+	size_t CPathCache::GetCount()
+	{
+		std::shared_lock lock( m_mutex );
+		return m_mapStrings.size();
+	}
+
+	void CPathCache::Insert( XrPath path, std::string_view sPath )
+	{
+		std::unique_lock lock( m_mutex );
+		m_mapPaths.try_emplace( std::string( sPath ), path );
+		m_mapStrings.try_emplace( path, sPath );
+	}
+
+} // namespace xrapp
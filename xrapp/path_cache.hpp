@@ -0,0 +1,66 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+
+
+#pragma once
+
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <openxr/openxr.h>
+
+namespace xrapp
+{
+	// Interned XrPath <-> string conversions for an instance. The runtime is only called on a miss,
+	// hits take a shared lock so any thread can look paths up while the cache is being warmed.
+	// Covers xrapp's own lookups (e.g. subaction names in action logging). Actions and bindings created through xrlib's CInput
+	// still convert their paths there, until xrlib can take a path resolver.
+	class CPathCache
+	{
+	  public:
+		CPathCache( XrInstance xrInstance ) : m_xrInstance( xrInstance ) {}
+
+		// XR_NULL_PATH if the runtime can't convert the string
+		XrPath GetPath( std::string_view sPath );
+
+		// Empty if the runtime doesn't know the path. References stay valid for the cache's lifetime.
+		const std::string &GetString( XrPath path );
+
+		// Converts paths ahead of use (e.g. on a worker during startup)
+		void Warm( const std::vector< std::string > &vecPaths );
+
+		// User paths, interaction profiles and input/output paths of both hands for the controllers the demos bind
+		static std::vector< std::string > GetCommonPaths();
+
+		size_t GetCount();
+
+	  private:
+		struct SStringHash
+		{
+			using is_transparent = void;
+			size_t operator()( std::string_view sValue ) const { return std::hash< std::string_view > {}( sValue ); }
+		};
+
+		void Insert( XrPath path, std::string_view sPath );
+
+		XrInstance m_xrInstance = XR_NULL_HANDLE;
+
+		std::shared_mutex m_mutex;
+		std::unordered_map< std::string, XrPath, SStringHash, std::equal_to<> > m_mapPaths;
+		std::unordered_map< XrPath, std::string > m_mapStrings;
+	};
+
+} // namespace xrapp
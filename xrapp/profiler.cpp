@@ -0,0 +1,197 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+
+#include <profiler.hpp>
+
+// Only built with the profiler enabled, the zone macros compile to nothing otherwise
+#ifdef XRAPP_ENABLE_PROFILER
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace xrapp
+{
+	namespace
+	{
+		struct SProfileEvent
+		{
+			const char *pccName = nullptr;
+			uint64_t unStart = 0;
+			uint64_t unEnd = 0;
+			uint64_t unFrameIndex = 0;
+			int64_t predictedDisplayTime = 0;
+		};
+
+		// Written only by its owning thread, read when exporting
+		struct SProfileThread
+		{
+			uint32_t unId = 0;
+			std::string sName;
+			std::atomic< uint64_t > unWriteCount { 0 };
+			SProfileEvent events[ CProfiler::k_unRingSize ];
+		};
+
+		// Thread buffers outlive their threads so zones from finished workers still make it into the trace
+		struct SProfileRegistry
+		{
+			std::mutex mutex;
+			std::vector< std::shared_ptr< SProfileThread > > vecThreads;
+			std::string sExitTraceFile;
+
+			std::atomic< uint64_t > unFrameIndex { 0 };
+			std::atomic< int64_t > predictedDisplayTime { 0 };
+			std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+			SProfileRegistry()
+			{
+				#ifndef XR_USE_PLATFORM_ANDROID
+					sExitTraceFile = "xrapp_trace.json";
+				#endif
+			}
+
+			~SProfileRegistry()
+			{
+				if ( !sExitTraceFile.empty() )
+					CProfiler::WriteChromeTrace( sExitTraceFile );
+			}
+		};
+
+		SProfileRegistry &GetRegistry()
+		{
+			static SProfileRegistry registry;
+			return registry;
+		}
+
+		// Only the first zone on each thread takes the registry lock
+		SProfileThread &GetThread()
+		{
+			thread_local std::shared_ptr< SProfileThread > pThread;
+			if ( !pThread )
+			{
+				pThread = std::make_shared< SProfileThread >();
+
+				SProfileRegistry &registry = GetRegistry();
+				std::scoped_lock lock( registry.mutex );
+				pThread->unId = static_cast< uint32_t >( registry.vecThreads.size() );
+				pThread->sName = "Thread " + std::to_string( pThread->unId );
+				registry.vecThreads.push_back( pThread );
+			}
+
+			return *pThread;
+		}
+
+		void WriteEscaped( std::ofstream &file, const std::string &sText )
+		{
+			for ( char c : sText )
+			{
+				if ( c == '"' || c == '\\' )
+					file << '\\';
+				file << c;
+			}
+		}
+	}
+
+	void CProfiler::SetFrame( uint64_t unFrameIndex, int64_t predictedDisplayTime )
+	{
+		SProfileRegistry &registry = GetRegistry();
+		registry.unFrameIndex.store( unFrameIndex, std::memory_order_relaxed );
+		registry.predictedDisplayTime.store( predictedDisplayTime, std::memory_order_relaxed );
+	}
+
+	void CProfiler::SetThreadName( const char *pccName )
+	{
+		SProfileThread &thread = GetThread();
+		if ( thread.sName == pccName )
+			return;
+
+		std::scoped_lock lock( GetRegistry().mutex );
+		thread.sName = pccName;
+	}
+
+	void CProfiler::SetExitTraceFile( const std::string &sFilename )
+	{
+		SProfileRegistry &registry = GetRegistry();
+		std::scoped_lock lock( registry.mutex );
+		registry.sExitTraceFile = sFilename;
+	}
+
+	uint64_t CProfiler::Now()
+	{
+		return static_cast< uint64_t >( std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now() - GetRegistry().epoch ).count() );
+	}
+
+	uint64_t CProfiler::GetFrameIndex() { return GetRegistry().unFrameIndex.load( std::memory_order_relaxed ); }
+
+	int64_t CProfiler::GetPredictedDisplayTime() { return GetRegistry().predictedDisplayTime.load( std::memory_order_relaxed ); }
+
+	void CProfiler::Record( const char *pccName, uint64_t unStart, uint64_t unEnd, uint64_t unFrameIndex, int64_t predictedDisplayTime )
+	{
+		SProfileThread &thread = GetThread();
+
+		uint64_t unCount = thread.unWriteCount.load( std::memory_order_relaxed );
+		thread.events[ unCount % k_unRingSize ] = { pccName, unStart, unEnd, unFrameIndex, predictedDisplayTime };
+		thread.unWriteCount.store( unCount + 1, std::memory_order_release );
+	}
+
+	bool CProfiler::WriteChromeTrace( const std::string &sFilename )
+	{
+		std::ofstream file( sFilename );
+		if ( !file )
+			return false;
+
+		SProfileRegistry &registry = GetRegistry();
+		std::scoped_lock lock( registry.mutex );
+
+		// Timestamps are in microseconds
+		file << std::fixed << std::setprecision( 3 );
+		file << "{\"traceEvents\":[\n";
+		bool bFirst = true;
+
+		for ( auto &pThread : registry.vecThreads )
+		{
+			// (1) Thread name
+			file << ( bFirst ? "" : ",\n" ) << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":0,\"tid\":" << pThread->unId << ",\"args\":{\"name\":\"";
+			WriteEscaped( file, pThread->sName );
+			file << "\"}}";
+			bFirst = false;
+
+			// (2) Zones, oldest first. Leave a margin at the tail of the ring that the owning thread may be overwriting.
+			uint64_t unCount = pThread->unWriteCount.load( std::memory_order_acquire );
+			uint64_t unMargin = k_unRingSize / 16;
+			uint64_t unFirst = unCount > k_unRingSize - unMargin ? unCount - ( k_unRingSize - unMargin ) : 0;
+
+			for ( uint64_t i = unFirst; i < unCount; i++ )
+			{
+				const SProfileEvent &event = pThread->events[ i % k_unRingSize ];
+
+				file << ",\n{\"ph\":\"X\",\"pid\":0,\"tid\":" << pThread->unId << ",\"name\":\"";
+				WriteEscaped( file, event.pccName ? event.pccName : "" );
+				file << "\",\"ts\":" << event.unStart / 1000.0
+					 << ",\"dur\":" << ( event.unEnd - event.unStart ) / 1000.0
+					 << ",\"args\":{\"frame\":" << event.unFrameIndex << ",\"predictedDisplayTime\":" << event.predictedDisplayTime << "}}";
+			}
+		}
+
+		file << "\n]}\n";
+		return file.good();
+	}
+
+} // namespace xrapp
+
+#endif // XRAPP_ENABLE_PROFILER
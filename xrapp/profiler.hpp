@@ -0,0 +1,84 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// Scoped zone profiler - compiled out unless XRAPP_ENABLE_PROFILER is defined (cmake: -D ENABLE_PROFILER=ON).
+// Zones are recorded to per thread ring buffers without locks and exported as chrome trace json (chrome://tracing, ui.perfetto.dev).
+#ifdef XRAPP_ENABLE_PROFILER
+	#define XRAPP_PROFILE_CONCAT_INNER( a, b ) a##b
+	#define XRAPP_PROFILE_CONCAT( a, b ) XRAPP_PROFILE_CONCAT_INNER( a, b )
+
+	// Name must be a string literal (or otherwise outlive the profiler)
+	#define XRAPP_PROFILE_ZONE( name ) xrapp::CProfileZone XRAPP_PROFILE_CONCAT( profileZone_, __LINE__ )( name )
+	#define XRAPP_PROFILE_FRAME( frameIndex, predictedDisplayTime ) xrapp::CProfiler::SetFrame( frameIndex, predictedDisplayTime )
+	#define XRAPP_PROFILE_THREAD( name ) xrapp::CProfiler::SetThreadName( name )
+#else
+	#define XRAPP_PROFILE_ZONE( name ) ( (void) 0 )
+	#define XRAPP_PROFILE_FRAME( frameIndex, predictedDisplayTime ) ( (void) 0 )
+	#define XRAPP_PROFILE_THREAD( name ) ( (void) 0 )
+#endif
+
+namespace xrapp
+{
+	class CProfiler
+	{
+	  public:
+		// Events kept per thread, older events are overwritten
+		static constexpr uint32_t k_unRingSize = 16384;
+
+		// Tags zones that start from now on with the frame index and its predicted display time
+		static void SetFrame( uint64_t unFrameIndex, int64_t predictedDisplayTime );
+
+		// Name shown for the calling thread in the trace
+		static void SetThreadName( const char *pccName );
+
+		// Writes every recorded zone as chrome trace json. Zones recorded while writing may be skipped.
+		static bool WriteChromeTrace( const std::string &sFilename );
+
+		// Trace written when the app exits, empty to disable. Defaults to xrapp_trace.json in the working directory on desktop.
+		static void SetExitTraceFile( const std::string &sFilename );
+
+		static uint64_t Now();
+		static void Record( const char *pccName, uint64_t unStart, uint64_t unEnd, uint64_t unFrameIndex, int64_t predictedDisplayTime );
+		static uint64_t GetFrameIndex();
+		static int64_t GetPredictedDisplayTime();
+	};
+
+	class CProfileZone
+	{
+	  public:
+		CProfileZone( const char *pccName )
+			: m_pccName( pccName )
+			, m_unFrameIndex( CProfiler::GetFrameIndex() )
+			, m_predictedDisplayTime( CProfiler::GetPredictedDisplayTime() )
+			, m_unStart( CProfiler::Now() )
+		{
+		}
+
+		~CProfileZone() { CProfiler::Record( m_pccName, m_unStart, CProfiler::Now(), m_unFrameIndex, m_predictedDisplayTime ); }
+
+		CProfileZone( const CProfileZone & ) = delete;
+		CProfileZone &operator=( const CProfileZone & ) = delete;
+
+	  private:
+		const char *m_pccName = nullptr;
+		uint64_t m_unFrameIndex = 0;
+		int64_t m_predictedDisplayTime = 0;
+		uint64_t m_unStart = 0;
+	};
+
+} // namespace xrapp
@@ -0,0 +1,177 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+
+#include <task_graph.hpp>
+#include <profiler.hpp>
+
+#include <cassert>
+
+namespace xrapp
+{
+	CTaskGraph::CTaskGraph( CThreadPool *pThreadPool )
+		: m_pThreadPool( pThreadPool )
+	{
+		assert( m_pThreadPool );
+	}
+
+	CTaskGraph::~CTaskGraph()
+	{
+		Wait();
+	}
+
+	CTaskGraph::TaskId CTaskGraph::AddTask( std::function< void() > fnTask, const std::vector< TaskId > &vecDependencies, ETaskLane eLane )
+	{
+		assert( m_unRemainingTasks == 0 );
+
+		TaskId taskId = m_vecTasks.size();
+
+		auto pTask = std::make_unique< STask >();
+		pTask->fnTask = std::move( fnTask );
+		pTask->eLane = eLane;
+		pTask->unDependencyCount = static_cast< uint32_t >( vecDependencies.size() );
+
+		for ( TaskId dependency : vecDependencies )
+		{
+			assert( dependency < taskId );
+			m_vecTasks[ dependency ]->vecDependents.push_back( taskId );
+		}
+
+		m_vecTasks.push_back( std::move( pTask ) );
+		return taskId;
+	}
+
+	void CTaskGraph::Run()
+	{
+		Wait();
+
+		if ( m_vecTasks.empty() )
+			return;
+
+		// (1) Reset dependency counters, all tasks must be counted before any of them can finish
+		{
+			std::scoped_lock lock( m_doneMutex );
+			m_unRemainingTasks = m_vecTasks.size();
+		}
+
+		for ( auto &pTask : m_vecTasks )
+			pTask->unPendingDependencies = pTask->unDependencyCount;
+
+		// (2) Kick off the roots
+		for ( TaskId i = 0; i < m_vecTasks.size(); i++ )
+		{
+			if ( m_vecTasks[ i ]->unDependencyCount == 0 )
+				Schedule( i );
+		}
+	}
+
+	void CTaskGraph::Wait()
+	{
+		std::unique_lock< std::mutex > lock( m_doneMutex );
+		m_doneCondition.wait( lock, [ this ]() { return m_unRemainingTasks == 0; } );
+	}
+
+	void CTaskGraph::Clear()
+	{
+		Wait();
+		m_vecTasks.clear();
+	}
+
+	void CTaskGraph::Schedule( TaskId taskId )
+	{
+		if ( m_vecTasks[ taskId ]->eLane == ETaskLane::Worker )
+		{
+			m_pThreadPool->SubmitTask(
+				[ this, taskId ]()
+				{
+					Execute( taskId );
+					Finish();
+				} );
+			return;
+		}
+
+		// Serial lane - queue the task and start a drain unless one is already running
+		bool bStartDrain = false;
+		{
+			std::scoped_lock lock( m_serialMutex );
+			m_serialQueue.push_back( taskId );
+			bStartDrain = !m_bSerialLaneRunning;
+			m_bSerialLaneRunning = true;
+		}
+
+		if ( bStartDrain )
+			m_pThreadPool->SubmitTask( [ this ]() { DrainSerialLane(); } );
+	}
+
+	void CTaskGraph::DrainSerialLane()
+	{
+		TaskId taskId = 0;
+		{
+			std::scoped_lock lock( m_serialMutex );
+			taskId = m_serialQueue.front();
+			m_serialQueue.pop_front();
+		}
+
+		while ( true )
+		{
+			Execute( taskId );
+
+			bool bHasNext = false;
+			{
+				std::scoped_lock lock( m_serialMutex );
+				bHasNext = !m_serialQueue.empty();
+
+				if ( bHasNext )
+				{
+					taskId = m_serialQueue.front();
+					m_serialQueue.pop_front();
+				}
+				else
+				{
+					m_bSerialLaneRunning = false;
+				}
+			}
+
+			// Last touch of the graph if this was its final task
+			Finish();
+
+			if ( !bHasNext )
+				return;
+		}
+	}
+
+	void CTaskGraph::Execute( TaskId taskId )
+	{
+		STask &task = *m_vecTasks[ taskId ];
+
+		if ( task.fnTask )
+		{
+			XRAPP_PROFILE_ZONE( task.eLane == ETaskLane::Serial ? "Task (serial)" : "Task" );
+			task.fnTask();
+		}
+
+		// Release dependents whose last dependency this was
+		for ( TaskId dependent : task.vecDependents )
+		{
+			if ( m_vecTasks[ dependent ]->unPendingDependencies.fetch_sub( 1 ) == 1 )
+				Schedule( dependent );
+		}
+	}
+
+	void CTaskGraph::Finish()
+	{
+		std::scoped_lock lock( m_doneMutex );
+		if ( --m_unRemainingTasks == 0 )
+			m_doneCondition.notify_all();
+	}
+
+} // namespace xrapp
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <xrlib/thread_pool.hpp>
+
+using namespace xrlib;
+
+namespace xrapp
+{
+	// Dependency-aware tasks on top of CThreadPool. Each task is submitted as soon as all of its dependencies have finished,
+	// so independent chains (e.g. per asset load -> parse -> material -> buffers) flow through without global barriers.
+	// A graph is built once and can be run any number of times (e.g. once per frame).
+	class CTaskGraph
+	{
+	  public:
+		using TaskId = size_t;
+
+		enum class ETaskLane
+		{
+			Worker = 0, // any worker thread, in parallel with other tasks
+			Serial = 1	// worker thread, one serial task at a time in the order they became ready (e.g. gpu uploads on a shared command pool)
+		};
+
+		CTaskGraph( CThreadPool *pThreadPool );
+		~CTaskGraph();
+
+		// Tasks can only be added while the graph isn't running. Dependencies must already be in the graph.
+		TaskId AddTask( std::function< void() > fnTask, const std::vector< TaskId > &vecDependencies = {}, ETaskLane eLane = ETaskLane::Worker );
+
+		// Submits every task without dependencies, the rest follow as their dependencies finish
+		void Run();
+
+		// Blocks until every task of the current run has finished
+		void Wait();
+
+		void RunAndWait()
+		{
+			Run();
+			Wait();
+		}
+
+		// Removes all tasks (waits for the current run first)
+		void Clear();
+
+		size_t GetTaskCount() { return m_vecTasks.size(); }
+
+	  private:
+		struct STask
+		{
+			std::function< void() > fnTask;
+			ETaskLane eLane = ETaskLane::Worker;
+			std::vector< TaskId > vecDependents;
+			uint32_t unDependencyCount = 0;
+			std::atomic< uint32_t > unPendingDependencies { 0 };
+		};
+
+		void Schedule( TaskId taskId );
+		void Execute( TaskId taskId );
+		void Finish();
+		void DrainSerialLane();
+
+		CThreadPool *m_pThreadPool = nullptr;
+		std::vector< std::unique_ptr< STask > > m_vecTasks;
+
+		size_t m_unRemainingTasks = 0; // guarded by m_doneMutex
+		std::mutex m_doneMutex;
+		std::condition_variable m_doneCondition;
+
+		std::mutex m_serialMutex;
+		std::deque< TaskId > m_serialQueue;
+		bool m_bSerialLaneRunning = false;
+	};
+
+} // namespace xrapp
@@ -0,0 +1,357 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+
+#include <tween.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace xrapp
+{
+	namespace
+	{
+		struct SEaseCoefficients
+		{
+			float a, b, c;
+		};
+
+		// a*t + b*t^2 + c*t^3, indexed by EEase
+		constexpr SEaseCoefficients k_easeCoefficients[] = {
+			{ 1.f, 0.f, 0.f },	// Linear
+			{ 0.f, 1.f, 0.f },	// InQuad
+			{ 2.f, -1.f, 0.f }, // OutQuad
+			{ 0.f, 3.f, -2.f }, // InOutQuad
+			{ 0.f, 0.f, 1.f },	// InCubic
+			{ 3.f, -3.f, 1.f }, // OutCubic
+		};
+	}
+
+	template < uint32_t N >
+	int64_t CTweenSystem::STrackPool< N >::Find( const STweenTarget &target ) const
+	{
+		auto it = std::find( vecTargets.begin(), vecTargets.end(), target );
+		return it == vecTargets.end() ? -1 : static_cast< int64_t >( it - vecTargets.begin() );
+	}
+
+	template < uint32_t N >
+	size_t CTweenSystem::STrackPool< N >::Add( const STweenTarget &target )
+	{
+		int64_t nExisting = Find( target );
+		if ( nExisting >= 0 )
+			return static_cast< size_t >( nExisting );
+
+		vecStart.push_back( 0.f );
+		vecInvDuration.push_back( 0.f );
+		vecEaseA.push_back( 1.f );
+		vecEaseB.push_back( 0.f );
+		vecEaseC.push_back( 0.f );
+		vecProgress.push_back( 0.f );
+		vecT.push_back( 0.f );
+
+		for ( uint32_t c = 0; c < N; c++ )
+		{
+			vecFrom[ c ].push_back( 0.f );
+			vecDelta[ c ].push_back( 0.f );
+			vecValue[ c ].push_back( 0.f );
+		}
+
+		vecTargets.push_back( target );
+		vecOnComplete.push_back( nullptr );
+
+		return vecTargets.size() - 1;
+	}
+
+	template < uint32_t N >
+	void CTweenSystem::STrackPool< N >::Remove( size_t unIndex )
+	{
+		auto SwapPop = [ unIndex ]( auto &vec )
+		{
+			vec[ unIndex ] = std::move( vec.back() );
+			vec.pop_back();
+		};
+
+		SwapPop( vecStart );
+		SwapPop( vecInvDuration );
+		SwapPop( vecEaseA );
+		SwapPop( vecEaseB );
+		SwapPop( vecEaseC );
+		SwapPop( vecProgress );
+		SwapPop( vecT );
+
+		for ( uint32_t c = 0; c < N; c++ )
+		{
+			SwapPop( vecFrom[ c ] );
+			SwapPop( vecDelta[ c ] );
+			SwapPop( vecValue[ c ] );
+		}
+
+		SwapPop( vecTargets );
+		SwapPop( vecOnComplete );
+	}
+
+	CTweenSystem::CTweenSystem( CMaterialStore *pMaterialStore )
+		: m_pMaterialStore( pMaterialStore )
+	{
+	}
+
+	template < uint32_t N >
+	size_t CTweenSystem::AddTrack( STrackPool< N > &pool, const STweenTarget &target, float fDurationSeconds, EEase ease, std::function< void() > fnOnComplete )
+	{
+		size_t i = pool.Add( target );
+
+		const SEaseCoefficients &coefficients = k_easeCoefficients[ static_cast< uint8_t >( ease ) ];
+
+		// Zero duration tracks start infinitely far in the past so they finish on the next update
+		pool.vecStart[ i ] = fDurationSeconds > 0.f ? std::numeric_limits< float >::infinity() : -std::numeric_limits< float >::infinity();
+		pool.vecInvDuration[ i ] = fDurationSeconds > 0.f ? 1.f / fDurationSeconds : 1.f;
+		pool.vecEaseA[ i ] = coefficients.a;
+		pool.vecEaseB[ i ] = coefficients.b;
+		pool.vecEaseC[ i ] = coefficients.c;
+		pool.vecProgress[ i ] = 0.f;
+		pool.vecT[ i ] = 0.f;
+		pool.vecOnComplete[ i ] = std::move( fnOnComplete );
+
+		return i;
+	}
+
+	void CTweenSystem::AddScalar( const STweenTarget &target, float fFrom, float fTo, float fDurationSeconds, EEase ease, std::function< void() > fnOnComplete )
+	{
+		size_t i = AddTrack( m_scalars, target, fDurationSeconds, ease, std::move( fnOnComplete ) );
+		m_scalars.vecFrom[ 0 ][ i ] = fFrom;
+		m_scalars.vecDelta[ 0 ][ i ] = fTo - fFrom;
+		m_scalars.vecValue[ 0 ][ i ] = fFrom;
+	}
+
+	CTweenSystem::STweenTarget CTweenSystem::GetMaterialTarget( uint32_t unMaterialId, const float &field ) const
+	{
+		assert( m_pMaterialStore );
+
+		const uint8_t *pBase = reinterpret_cast< const uint8_t * >( &m_pMaterialStore->Get( unMaterialId ) );
+		const uint8_t *pField = reinterpret_cast< const uint8_t * >( &field );
+		assert( pField >= pBase && pField + sizeof( float ) <= pBase + sizeof( SMaterialUBO ) );
+
+		return { nullptr, unMaterialId, static_cast< uint32_t >( pField - pBase ) };
+	}
+
+	void CTweenSystem::Animate( float &fValue, float fTo, float fDurationSeconds, EEase ease, std::function< void() > fnOnComplete )
+	{
+		AddScalar( { &fValue }, fValue, fTo, fDurationSeconds, ease, std::move( fnOnComplete ) );
+	}
+
+	void CTweenSystem::Animate( XrVector3f &vector, const XrVector3f &to, float fDurationSeconds, EEase ease, std::function< void() > fnOnComplete )
+	{
+		// Components finish on the same update, the last one carries the callback
+		AddScalar( { &vector.x }, vector.x, to.x, fDurationSeconds, ease, nullptr );
+		AddScalar( { &vector.y }, vector.y, to.y, fDurationSeconds, ease, nullptr );
+		AddScalar( { &vector.z }, vector.z, to.z, fDurationSeconds, ease, std::move( fnOnComplete ) );
+	}
+
+	void CTweenSystem::Animate( XrQuaternionf &quaternion, const XrQuaternionf &to, float fDurationSeconds, EEase ease, std::function< void() > fnOnComplete )
+	{
+		size_t i = AddTrack( m_quaternions, { &quaternion }, fDurationSeconds, ease, std::move( fnOnComplete ) );
+
+		// Take the short way around
+		const float fDot = quaternion.x * to.x + quaternion.y * to.y + quaternion.z * to.z + quaternion.w * to.w;
+		const float fSign = fDot < 0.f ? -1.f : 1.f;
+
+		const float from[ 4 ] = { quaternion.x, quaternion.y, quaternion.z, quaternion.w };
+		const float target[ 4 ] = { to.x * fSign, to.y * fSign, to.z * fSign, to.w * fSign };
+
+		for ( uint32_t c = 0; c < 4; c++ )
+		{
+			m_quaternions.vecFrom[ c ][ i ] = from[ c ];
+			m_quaternions.vecDelta[ c ][ i ] = target[ c ] - from[ c ];
+			m_quaternions.vecValue[ c ][ i ] = from[ c ];
+		}
+	}
+
+	void CTweenSystem::Animate( XrPosef &pose, const XrPosef &to, float fDurationSeconds, EEase ease, std::function< void() > fnOnComplete )
+	{
+		Animate( pose.position, to.position, fDurationSeconds, ease, nullptr );
+		Animate( pose.orientation, to.orientation, fDurationSeconds, ease, std::move( fnOnComplete ) );
+	}
+
+	void CTweenSystem::AnimateMaterial( uint32_t unMaterialId, const float &field, float fTo, float fDurationSeconds, EEase ease, std::function< void() > fnOnComplete )
+	{
+		AddScalar( GetMaterialTarget( unMaterialId, field ), field, fTo, fDurationSeconds, ease, std::move( fnOnComplete ) );
+	}
+
+	void CTweenSystem::Stop( const float &fValue )
+	{
+		int64_t nIndex = m_scalars.Find( { const_cast< float * >( &fValue ) } );
+		if ( nIndex >= 0 )
+			m_scalars.Remove( static_cast< size_t >( nIndex ) );
+	}
+
+	void CTweenSystem::Stop( const XrVector3f &vector )
+	{
+		Stop( vector.x );
+		Stop( vector.y );
+		Stop( vector.z );
+	}
+
+	void CTweenSystem::Stop( const XrQuaternionf &quaternion )
+	{
+		int64_t nIndex = m_quaternions.Find( { const_cast< XrQuaternionf * >( &quaternion ) } );
+		if ( nIndex >= 0 )
+			m_quaternions.Remove( static_cast< size_t >( nIndex ) );
+	}
+
+	void CTweenSystem::Stop( const XrPosef &pose )
+	{
+		Stop( pose.position );
+		Stop( pose.orientation );
+	}
+
+	void CTweenSystem::StopMaterial( uint32_t unMaterialId, const float &field )
+	{
+		int64_t nIndex = m_scalars.Find( GetMaterialTarget( unMaterialId, field ) );
+		if ( nIndex >= 0 )
+			m_scalars.Remove( static_cast< size_t >( nIndex ) );
+	}
+
+	bool CTweenSystem::BIsAnimating( const void *pTarget ) const
+	{
+		STweenTarget target { const_cast< void * >( pTarget ) };
+		return m_scalars.Find( target ) >= 0 || m_quaternions.Find( target ) >= 0;
+	}
+
+	template < uint32_t N >
+	void CTweenSystem::Evaluate( STrackPool< N > &pool, float fNow )
+	{
+		const size_t unCount = pool.Size();
+
+		float *pStart = pool.vecStart.data();
+		const float *pInvDuration = pool.vecInvDuration.data();
+		const float *pA = pool.vecEaseA.data();
+		const float *pB = pool.vecEaseB.data();
+		const float *pC = pool.vecEaseC.data();
+		float *pT = pool.vecT.data();
+		float *pProgress = pool.vecProgress.data();
+
+		// (1) Tracks added since the last update start now (pending ones start at +inf)
+		for ( size_t i = 0; i < unCount; i++ )
+			pStart[ i ] = std::min( pStart[ i ], fNow );
+
+		// (2) Linear progress
+		for ( size_t i = 0; i < unCount; i++ )
+		{
+			const float t = ( fNow - pStart[ i ] ) * pInvDuration[ i ];
+			pT[ i ] = t < 0.f ? 0.f : ( t > 1.f ? 1.f : t );
+		}
+
+		// (3) Eased progress. Kept as separate flat passes over few arrays so each one vectorizes.
+		for ( size_t i = 0; i < unCount; i++ )
+			pProgress[ i ] = pT[ i ] * ( pA[ i ] + pT[ i ] * ( pB[ i ] + pT[ i ] * pC[ i ] ) );
+
+		// (4) Values, one channel at a time
+		for ( uint32_t c = 0; c < N; c++ )
+		{
+			const float *pFrom = pool.vecFrom[ c ].data();
+			const float *pDelta = pool.vecDelta[ c ].data();
+			float *pValue = pool.vecValue[ c ].data();
+
+			for ( size_t i = 0; i < unCount; i++ )
+				pValue[ i ] = pFrom[ i ] + pDelta[ i ] * pProgress[ i ];
+		}
+	}
+
+	void CTweenSystem::Write()
+	{
+		// Scalars - memory or material store
+		for ( size_t i = 0; i < m_scalars.Size(); i++ )
+		{
+			const STweenTarget &target = m_scalars.vecTargets[ i ];
+			const float fValue = m_scalars.vecValue[ 0 ][ i ];
+
+			if ( target.pValue )
+			{
+				*static_cast< float * >( target.pValue ) = fValue;
+			}
+			else if ( m_pMaterialStore )
+			{
+				const uint8_t *pBase = reinterpret_cast< const uint8_t * >( &m_pMaterialStore->Get( target.unMaterialId ) );
+				m_pMaterialStore->Set( target.unMaterialId, *reinterpret_cast< const float * >( pBase + target.unMaterialOffset ), fValue );
+			}
+		}
+
+		// Quaternions - normalized lerp
+		for ( size_t i = 0; i < m_quaternions.Size(); i++ )
+		{
+			const float x = m_quaternions.vecValue[ 0 ][ i ];
+			const float y = m_quaternions.vecValue[ 1 ][ i ];
+			const float z = m_quaternions.vecValue[ 2 ][ i ];
+			const float w = m_quaternions.vecValue[ 3 ][ i ];
+
+			const float fLength = std::sqrt( x * x + y * y + z * z + w * w );
+			const float fInvLength = fLength > 0.f ? 1.f / fLength : 0.f;
+
+			*static_cast< XrQuaternionf * >( m_quaternions.vecTargets[ i ].pValue ) = { x * fInvLength, y * fInvLength, z * fInvLength, w * fInvLength };
+		}
+	}
+
+	void CTweenSystem::Retire()
+	{
+		auto RetirePool = [ this ]( auto &pool )
+		{
+			for ( size_t i = pool.Size(); i-- > 0; )
+			{
+				if ( pool.vecT[ i ] < 1.f )
+					continue;
+
+				if ( pool.vecOnComplete[ i ] )
+					m_vecCompleted.push_back( std::move( pool.vecOnComplete[ i ] ) );
+
+				pool.Remove( i );
+			}
+		};
+
+		RetirePool( m_scalars );
+		RetirePool( m_quaternions );
+	}
+
+	void CTweenSystem::Update( XrTime time )
+	{
+		if ( !m_timeBase )
+			m_timeBase = time;
+
+		// (1) Keep the clock within float precision, at ~17 minutes from the base float seconds are still sub millisecond
+		static constexpr XrTime k_rebaseAfter = 1024ll * 1000000000ll;
+		if ( time - m_timeBase > k_rebaseAfter )
+		{
+			const float fShift = static_cast< float >( static_cast< double >( time - m_timeBase ) * 1e-9 );
+			for ( float &fStart : m_scalars.vecStart )
+				fStart -= fShift;
+			for ( float &fStart : m_quaternions.vecStart )
+				fStart -= fShift;
+
+			m_timeBase = time;
+		}
+
+		// (2) Evaluate, write and retire all tracks
+		const float fNow = static_cast< float >( static_cast< double >( time - m_timeBase ) * 1e-9 );
+		Evaluate( m_scalars, fNow );
+		Evaluate( m_quaternions, fNow );
+
+		Write();
+		Retire();
+
+		// (3) Callbacks last, so they can start new tweens on the same targets
+		for ( auto &fnOnComplete : m_vecCompleted )
+			fnOnComplete();
+		m_vecCompleted.clear();
+	}
+
+} // namespace xrapp
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <openxr/openxr.h>
+
+#include <material_store.hpp>
+
+namespace xrapp
+{
+	// Easing curves, each one is a cubic in t (a*t + b*t^2 + c*t^3) so every track evaluates the same way regardless of curve
+	enum class EEase : uint8_t
+	{
+		Linear = 0,
+		InQuad = 1,
+		OutQuad = 2,
+		InOutQuad = 3,	// smoothstep
+		InCubic = 4,
+		OutCubic = 5
+	};
+
+	// Tweens floats, vectors, poses and material values towards a target over time.
+	// Tracks are kept in structure of arrays pools and evaluated in flat passes over all of them each Update, finished tracks are retired.
+	// Time comes from the frame's predicted display time (CFrameScheduler updates the app's tweens before simulate).
+	// Add and stop tweens from the input or simulate stages, the values are written during Update on the main thread.
+	class CTweenSystem
+	{
+	  public:
+		CTweenSystem( CMaterialStore *pMaterialStore = nullptr );
+
+		// Each Animate* starts from the target's current value, replacing any tween already running on the same target, and its clock starts at the next Update.
+		// Targets must outlive their tweens (or be stopped first). fnOnComplete runs during Update once the target value is final.
+		void Animate( float &fValue, float fTo, float fDurationSeconds, EEase ease = EEase::Linear, std::function< void() > fnOnComplete = nullptr );
+		void Animate( XrVector3f &vector, const XrVector3f &to, float fDurationSeconds, EEase ease = EEase::Linear, std::function< void() > fnOnComplete = nullptr );
+		void Animate( XrQuaternionf &quaternion, const XrQuaternionf &to, float fDurationSeconds, EEase ease = EEase::Linear, std::function< void() > fnOnComplete = nullptr );
+		void Animate( XrPosef &pose, const XrPosef &to, float fDurationSeconds, EEase ease = EEase::Linear, std::function< void() > fnOnComplete = nullptr );
+
+		// Material value through the material store, so only the changed field gets flushed. Field is from materialStore.Get( unMaterialId ).
+		void AnimateMaterial( uint32_t unMaterialId, const float &field, float fTo, float fDurationSeconds, EEase ease = EEase::Linear, std::function< void() > fnOnComplete = nullptr );
+
+		// Stops tweens on a target, leaving it at its current value
+		void Stop( const float &fValue );
+		void Stop( const XrVector3f &vector );
+		void Stop( const XrQuaternionf &quaternion );
+		void Stop( const XrPosef &pose );
+		void StopMaterial( uint32_t unMaterialId, const float &field );
+
+		// True if a tween is running on the target (or its first member, e.g. a vector's x)
+		bool BIsAnimating( const void *pTarget ) const;
+
+		// Evaluates all tracks at time (usually the predicted display time of the frame being simulated)
+		void Update( XrTime time );
+
+		uint32_t GetActiveCount() const { return static_cast< uint32_t >( m_scalars.Size() + m_quaternions.Size() ); }
+
+	  private:
+		// What a track writes to - a float/quaternion in memory or a material float through the store
+		struct STweenTarget
+		{
+			void *pValue = nullptr;
+			uint32_t unMaterialId = UINT32_MAX;
+			uint32_t unMaterialOffset = 0;
+
+			bool operator==( const STweenTarget & ) const = default;
+		};
+
+		template < uint32_t N >
+		struct STrackPool
+		{
+			std::vector< float > vecStart;			// seconds since m_timeBase, +inf until the first update after the track was added
+			std::vector< float > vecInvDuration;	// 1 / duration in seconds
+			std::vector< float > vecEaseA, vecEaseB, vecEaseC;
+			std::vector< float > vecProgress;		// eased progress from the last update, 1 once finished
+			std::vector< float > vecT;				// linear progress from the last update
+			std::vector< float > vecFrom[ N ], vecDelta[ N ], vecValue[ N ];
+			std::vector< STweenTarget > vecTargets;
+			std::vector< std::function< void() > > vecOnComplete;
+
+			size_t Size() const { return vecTargets.size(); }
+			int64_t Find( const STweenTarget &target ) const;
+			size_t Add( const STweenTarget &target );	// returns the slot, reusing the target's existing one
+			void Remove( size_t unIndex );				// swap with the last track
+		};
+
+		void AddScalar( const STweenTarget &target, float fFrom, float fTo, float fDurationSeconds, EEase ease, std::function< void() > fnOnComplete );
+		STweenTarget GetMaterialTarget( uint32_t unMaterialId, const float &field ) const;
+
+		template < uint32_t N >
+		size_t AddTrack( STrackPool< N > &pool, const STweenTarget &target, float fDurationSeconds, EEase ease, std::function< void() > fnOnComplete );
+
+		template < uint32_t N >
+		void Evaluate( STrackPool< N > &pool, float fNow );
+
+		void Write();
+		void Retire();
+
+		CMaterialStore *m_pMaterialStore = nullptr;
+
+		STrackPool< 1 > m_scalars;
+		STrackPool< 4 > m_quaternions;
+
+		std::vector< std::function< void() > > m_vecCompleted;
+
+		XrTime m_timeBase = 0;	// track start times are relative to this, moved forward now and then to keep float precision
+	};
+
+} // namespace xrapp
@@ -0,0 +1,171 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+
+#include <vismask_cache.hpp>
+#include <file_write.hpp>
+
+#include <fstream>
+
+namespace xrapp
+{
+	namespace
+	{
+		struct SVismaskCacheHeader
+		{
+			uint32_t unMagic = k_unVismaskCacheMagic;
+			uint32_t unVersion = k_unVismaskCacheVersion;
+			uint64_t runtimeVersion = 0;
+			uint64_t systemId = 0;
+			uint32_t unVendorId = 0;
+			uint32_t unViewConfigurationType = 0;
+			char runtimeName[ XR_MAX_RUNTIME_NAME_SIZE ] {};
+			char systemName[ XR_MAX_SYSTEM_NAME_SIZE ] {};
+			uint32_t unEyeCount = 0;
+			uint32_t unReserved = 0;
+		};
+
+		struct SVismaskCacheEye
+		{
+			uint32_t unVertexStride = 0;
+			uint32_t unIndexStride = 0;
+			uint64_t unVertexDataSize = 0;
+			uint64_t unIndexDataSize = 0;
+		};
+
+		// Upper bound on a single eye's data, anything larger is treated as corrupt
+		static constexpr uint64_t k_unMaxEyeDataSize = 16ull * 1024 * 1024;
+
+		SVismaskCacheHeader MakeHeader( const SVismaskCacheKey &key )
+		{
+			SVismaskCacheHeader header;
+			header.runtimeVersion = key.runtimeVersion;
+			header.systemId = key.systemId;
+			header.unVendorId = key.unVendorId;
+			header.unViewConfigurationType = static_cast< uint32_t >( key.viewConfigurationType );
+			std::strncpy( header.runtimeName, key.sRuntimeName.c_str(), XR_MAX_RUNTIME_NAME_SIZE - 1 );
+			std::strncpy( header.systemName, key.sSystemName.c_str(), XR_MAX_SYSTEM_NAME_SIZE - 1 );
+			return header;
+		}
+	}
+
+	bool GetVismaskCacheKey( XrInstance xrInstance, XrViewConfigurationType viewConfigurationType, SVismaskCacheKey &outKey )
+	{
+		XrInstanceProperties instanceProperties { XR_TYPE_INSTANCE_PROPERTIES };
+		if ( !XR_SUCCEEDED( xrGetInstanceProperties( xrInstance, &instanceProperties ) ) )
+			return false;
+
+		XrSystemGetInfo systemGetInfo { XR_TYPE_SYSTEM_GET_INFO };
+		systemGetInfo.formFactor = XR_FORM_FACTOR_HEAD_MOUNTED_DISPLAY;
+
+		XrSystemId systemId = XR_NULL_SYSTEM_ID;
+		if ( !XR_SUCCEEDED( xrGetSystem( xrInstance, &systemGetInfo, &systemId ) ) )
+			return false;
+
+		XrSystemProperties systemProperties { XR_TYPE_SYSTEM_PROPERTIES };
+		if ( !XR_SUCCEEDED( xrGetSystemProperties( xrInstance, systemId, &systemProperties ) ) )
+			return false;
+
+		outKey.sRuntimeName = instanceProperties.runtimeName;
+		outKey.runtimeVersion = instanceProperties.runtimeVersion;
+		outKey.sSystemName = systemProperties.systemName;
+		outKey.unVendorId = systemProperties.vendorId;
+		outKey.systemId = systemId;
+		outKey.viewConfigurationType = viewConfigurationType;
+
+		return true;
+	}
+
+	bool CVismaskCache::Load( const std::string &sFilename, const SVismaskCacheKey &key, std::string &sError )
+	{
+		m_vecEyes.clear();
+
+		std::ifstream file( sFilename, std::ios::binary );
+		if ( !file )
+		{
+			sError = "No vismask cache at: " + sFilename;
+			return false;
+		}
+
+		// (1) Header must match the current runtime and device exactly
+		SVismaskCacheHeader header;
+		SVismaskCacheHeader expected = MakeHeader( key );
+		if ( !file.read( reinterpret_cast< char * >( &header ), sizeof( header ) ) || header.unMagic != k_unVismaskCacheMagic || header.unVersion != k_unVismaskCacheVersion )
+		{
+			sError = "Vismask cache has an unsupported format or version.";
+			return false;
+		}
+
+		uint32_t unEyeCount = header.unEyeCount;
+		header.unEyeCount = expected.unEyeCount;
+		if ( std::memcmp( &header, &expected, sizeof( header ) ) != 0 )
+		{
+			sError = "Vismask cache was saved for a different runtime or device.";
+			return false;
+		}
+
+		// (2) Eye tables and data
+		std::vector< SEye > vecEyes( unEyeCount );
+		for ( auto &eye : vecEyes )
+		{
+			SVismaskCacheEye eyeHeader;
+			if ( !file.read( reinterpret_cast< char * >( &eyeHeader ), sizeof( eyeHeader ) ) ||
+				 eyeHeader.unVertexDataSize > k_unMaxEyeDataSize || eyeHeader.unIndexDataSize > k_unMaxEyeDataSize ||
+				 eyeHeader.unVertexStride == 0 || eyeHeader.unIndexStride == 0 ||
+				 eyeHeader.unVertexDataSize % eyeHeader.unVertexStride != 0 || eyeHeader.unIndexDataSize % eyeHeader.unIndexStride != 0 )
+			{
+				sError = "Vismask cache is corrupt.";
+				return false;
+			}
+
+			eye.unVertexStride = eyeHeader.unVertexStride;
+			eye.unIndexStride = eyeHeader.unIndexStride;
+			eye.vecVertexData.resize( eyeHeader.unVertexDataSize );
+			eye.vecIndexData.resize( eyeHeader.unIndexDataSize );
+
+			if ( !file.read( reinterpret_cast< char * >( eye.vecVertexData.data() ), static_cast< std::streamsize >( eye.vecVertexData.size() ) ) ||
+				 !file.read( reinterpret_cast< char * >( eye.vecIndexData.data() ), static_cast< std::streamsize >( eye.vecIndexData.size() ) ) )
+			{
+				sError = "Vismask cache is truncated.";
+				return false;
+			}
+		}
+
+		m_vecEyes = std::move( vecEyes );
+		return true;
+	}
+
+	bool CVismaskCache::Save( const std::string &sFilename, const SVismaskCacheKey &key, std::string &sError ) const
+	{
+		SVismaskCacheHeader header = MakeHeader( key );
+		header.unEyeCount = GetEyeCount();
+
+		return WriteFileAtomic(
+			sFilename,
+			[ & ]( std::ostream &out )
+			{
+				out.write( reinterpret_cast< const char * >( &header ), sizeof( header ) );
+
+				for ( auto &eye : m_vecEyes )
+				{
+					SVismaskCacheEye eyeHeader { eye.unVertexStride, eye.unIndexStride, eye.vecVertexData.size(), eye.vecIndexData.size() };
+					out.write( reinterpret_cast< const char * >( &eyeHeader ), sizeof( eyeHeader ) );
+					out.write( reinterpret_cast< const char * >( eye.vecVertexData.data() ), static_cast< std::streamsize >( eye.vecVertexData.size() ) );
+					out.write( reinterpret_cast< const char * >( eye.vecIndexData.data() ), static_cast< std::streamsize >( eye.vecIndexData.size() ) );
+				}
+
+				return static_cast< bool >( out );
+			},
+			sError );
+	}
+
+} // namespace xrapp
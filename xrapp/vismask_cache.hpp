@@ -0,0 +1,97 @@
+/*
+ * Copyright 2024,2025 Copyright Rune Berg
+ * https://github.com/1runeberg | http://runeberg.io | https://runeberg.social | https://www.youtube.com/@1RuneBerg
+ * Licensed under Apache 2.0: https://www.apache.org/licenses/LICENSE-2.0
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * This work is the next iteration of OpenXRProvider (v1, v2)
+ * OpenXRProvider (v1): Released 2021 -  https://github.com/1runeberg/OpenXRProvider
+ * OpenXRProvider (v2): Released 2022 - https://github.com/1runeberg/OpenXRProvider_v2/
+ * v1 & v2 licensed under MIT: https://opensource.org/license/mit
+*/
+
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <openxr/openxr.h>
+
+namespace xrapp
+{
+	// Vismask cache (.bin): the triangulated hidden area mesh of each eye, saved so startup doesn't wait on the runtime for them.
+	// Only valid for the runtime (name and version), device and view configuration it was saved from.
+	static constexpr const char *k_pccVismaskCacheFilename = "xrapp_vismask_%u.bin"; // view configuration type
+	static constexpr uint32_t k_unVismaskCacheMagic = 0x4D565258; // XRVM
+	static constexpr uint32_t k_unVismaskCacheVersion = 1;
+
+	struct SVismaskCacheKey
+	{
+		std::string sRuntimeName;
+		XrVersion runtimeVersion = 0;
+		std::string sSystemName;
+		uint32_t unVendorId = 0;
+		XrSystemId systemId = XR_NULL_SYSTEM_ID;
+		XrViewConfigurationType viewConfigurationType = XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO;
+
+		bool operator==( const SVismaskCacheKey &other ) const = default;
+	};
+
+	// Builds the key for the current runtime and head mounted system
+	bool GetVismaskCacheKey( XrInstance xrInstance, XrViewConfigurationType viewConfigurationType, SVismaskCacheKey &outKey );
+
+	class CVismaskCache
+	{
+	  public:
+		// Returns false if the file is missing, corrupt or was saved for another key
+		bool Load( const std::string &sFilename, const SVismaskCacheKey &key, std::string &sError );
+		bool Save( const std::string &sFilename, const SVismaskCacheKey &key, std::string &sError ) const;
+
+		// Copies an eye's mask out of the cache, false if it's missing or was saved with different vertex/index types
+		template < typename TVertex, typename TIndex >
+		bool GetEye( uint32_t unEye, std::vector< TVertex > &vecVertices, std::vector< TIndex > &vecIndices ) const
+		{
+			if ( unEye >= m_vecEyes.size() || m_vecEyes[ unEye ].unVertexStride != sizeof( TVertex ) || m_vecEyes[ unEye ].unIndexStride != sizeof( TIndex ) )
+				return false;
+
+			const SEye &eye = m_vecEyes[ unEye ];
+			vecVertices.resize( eye.vecVertexData.size() / sizeof( TVertex ) );
+			vecIndices.resize( eye.vecIndexData.size() / sizeof( TIndex ) );
+			std::memcpy( vecVertices.data(), eye.vecVertexData.data(), eye.vecVertexData.size() );
+			std::memcpy( vecIndices.data(), eye.vecIndexData.data(), eye.vecIndexData.size() );
+			return true;
+		}
+
+		template < typename TVertex, typename TIndex >
+		void SetEye( uint32_t unEye, const std::vector< TVertex > &vecVertices, const std::vector< TIndex > &vecIndices )
+		{
+			if ( unEye >= m_vecEyes.size() )
+				m_vecEyes.resize( unEye + 1 );
+
+			SEye &eye = m_vecEyes[ unEye ];
+			eye.unVertexStride = sizeof( TVertex );
+			eye.unIndexStride = sizeof( TIndex );
+			eye.vecVertexData.resize( vecVertices.size() * sizeof( TVertex ) );
+			eye.vecIndexData.resize( vecIndices.size() * sizeof( TIndex ) );
+			std::memcpy( eye.vecVertexData.data(), vecVertices.data(), eye.vecVertexData.size() );
+			std::memcpy( eye.vecIndexData.data(), vecIndices.data(), eye.vecIndexData.size() );
+		}
+
+		uint32_t GetEyeCount() const { return static_cast< uint32_t >( m_vecEyes.size() ); }
+
+	  private:
+		struct SEye
+		{
+			uint32_t unVertexStride = 0;
+			uint32_t unIndexStride = 0;
+			std::vector< uint8_t > vecVertexData;
+			std::vector< uint8_t > vecIndexData;
+		};
+
+		std::vector< SEye > m_vecEyes;
+	};
+
+} // namespace xrapp
@@ -11,11 +11,41 @@
 */
 
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <tuple>
+
 #include <xrapp.hpp>
+#include <mesh_bake.hpp>
+#include <profiler.hpp>
 #include <tinygltf/tiny_gltf.h>
 
 namespace xrapp
 {
+	// Async mesh load in flight - disk loads run on workers, the rest on the main thread in UpdateAsyncLoads
+	struct XrApp::SAsyncMeshLoad
+	{
+		std::vector< SAsyncMeshInfo > vecMeshes;
+		std::vector< size_t > vecModelIndices;	// per mesh, into vecModels
+		std::vector< bool > vecIsCacheHit;		// per mesh, reuses another mesh's model
+
+		std::vector< std::unique_ptr< tinygltf::Model > > vecModels;	// per unique file and scale
+		std::vector< std::future< void > > vecLoadFutures;				// per model
+		std::vector< size_t > vecModelUses;								// per model, released once no mesh needs it
+
+		std::unique_ptr< CGltf > pGltf;
+		size_t unNextMesh = 0;
+		size_t unInsertIndex = 0;
+
+		std::promise< void > promiseReady;
+		std::chrono::high_resolution_clock::time_point start;
+	};
+
 
 #ifdef XR_USE_PLATFORM_ANDROID
 
@@ -23,7 +53,7 @@ namespace xrapp
 	{
 		// Create thread pool
 		pThreadPool = std::make_unique< CThreadPool >( pAndroidApp->activity->vm ); // Will use optimal number of worker threads - starts with 1 and dynamically increases to max as needed
-		LogDebug( "XrApp::XrApp", "Created xrapp thread pool with: %zu worker threads, 1 main thread and 1 system thread.", CThreadPool::GetOptimalWorkerThreadCount() );
+		XRAPP_LOG_DEBUG( "XrApp::XrApp", "Created xrapp thread pool with: %zu worker threads, 1 main thread and 1 system thread.", CThreadPool::GetOptimalWorkerThreadCount() );
 
 		// Create an xr instance, we'll leave the optional log level parameter to verbose.
 		m_pXrInstance = std::make_unique< CInstance >( pAndroidApp, sAppName, unAppVersion, eMinLogLevel );
@@ -31,6 +61,11 @@ namespace xrapp
 		// Initialize android openxr loader
 		if ( !XR_UNQUALIFIED_SUCCESS( m_pXrInstance->InitAndroidLoader( pAndroidApp ) ) )
 			throw;
+
+		if ( pAndroidApp->activity->internalDataPath )
+			sCacheDirectory = std::string( pAndroidApp->activity->internalDataPath ) + "/";
+
+		RegisterDefaultEventHandlers();
 	}
 #else
 	XrApp::XrApp( int argc, char *argv[], const std::string &sAppName, const XrVersion32 unAppVersion, const ELogLevel eMinLogLevel )
@@ -40,10 +75,42 @@ namespace xrapp
 
 		// Create an xr instance, we'll leave the optional log level parameter to verbose.
 		m_pXrInstance = std::make_unique< CInstance >( sAppName, unAppVersion, eMinLogLevel );
+
+		// Input capture
+		for ( int i = 1; i + 1 < argc; i++ )
+		{
+			if ( std::strcmp( argv[ i ], "--record-input" ) == 0 )
+			{
+				if ( inputCapture.StartRecording( argv[ ++i ] ) )
+					XRAPP_LOG_INFO( m_pXrInstance->GetAppName(), "Recording input to: %s", argv[ i ] );
+				else
+					XRAPP_LOG_ERROR( m_pXrInstance->GetAppName(), "Unable to record input to: %s", argv[ i ] );
+			}
+			else if ( std::strcmp( argv[ i ], "--replay-input" ) == 0 )
+			{
+				if ( inputCapture.StartReplay( argv[ ++i ] ) )
+					XRAPP_LOG_INFO( m_pXrInstance->GetAppName(), "Replaying input from: %s", argv[ i ] );
+				else
+					XRAPP_LOG_ERROR( m_pXrInstance->GetAppName(), "Unable to replay input from: %s", argv[ i ] );
+			}
+		}
+
+		RegisterDefaultEventHandlers();
 	}
 #endif
 
-	XrApp::~XrApp() {}
+	XrApp::~XrApp() 
+	{
+		if ( m_futurePathCacheWarm.valid() )
+			m_futurePathCacheWarm.wait();
+
+		// Workers may still be loading meshes into async loads
+		for ( auto &pLoad : m_vecAsyncMeshLoads )
+		{
+			for ( auto &future : pLoad->vecLoadFutures )
+				future.wait();
+		}
+	}
 
 	XrResult XrApp::InitInstance( std::vector< const char * > &vecExtensions, std::vector< const char * > &vecApiLayers, const XrInstanceCreateFlags createFlags, const void *pNext )
 	{
@@ -54,6 +121,15 @@ namespace xrapp
 		// Initialize OpenXR instance
 		XR_RETURN_ON_ERROR( m_pXrInstance->Init( vecExtensions, vecApiLayers, createFlags, pNext ) );
 
+		// Intern the paths input setup and debug output use on a worker while the session is created
+		pPathCache = std::make_unique< CPathCache >( m_pXrInstance->GetXrInstance() );
+		m_futurePathCacheWarm = pThreadPool->SubmitTask(
+			[ pPathCache = pPathCache.get() ]()
+			{
+				XRAPP_PROFILE_ZONE( "WarmPathCache" );
+				pPathCache->Warm( CPathCache::GetCommonPaths() );
+			} );
+
 		return XR_SUCCESS;
 	}
 
@@ -97,8 +173,10 @@ namespace xrapp
 				float maxRate = *std::max_element( supportedRates.begin(), supportedRates.end() );
 				m_pDisplayRate->RequestRefreshRate( xrSession, maxRate );
 
-				LogInfo( m_pXrInstance->GetAppName(), "Requested refresh rate: %f", maxRate );
-				LogInfo( m_pXrInstance->GetAppName(), "Current refresh rate: %f", m_pDisplayRate->GetCurrentRefreshRate( xrSession ) );
+				XRAPP_LOG_INFO( m_pXrInstance->GetAppName(), "Requested refresh rate: %f", maxRate );
+
+				// Only runtime query for the rate, changes arrive as events
+				SetRefreshRate( m_pDisplayRate->GetCurrentRefreshRate( xrSession ) );
 			}
 		}
 		return XR_SUCCESS;
@@ -117,6 +195,8 @@ namespace xrapp
 
 		// Create render info
 		pRenderInfo = std::make_unique< CRenderInfo >( m_pXrSession.get() );
+		pRenderInfo->state.compositionLayerFlags = 0;
+		pRenderInfo->state.clearValues[ 0 ].color = { { 0.0f, 0.0f, 0.0f, 1.0f } };
 
 		// Create texture manager
 		pTextureManager = std::make_unique< CTextureManager >( m_pXrSession.get(), m_pRender->GetCommandPool() ); 
@@ -157,7 +237,13 @@ namespace xrapp
 		if ( !m_pPassthrough )
 			return XR_ERROR_FEATURE_UNSUPPORTED;
 
-		return m_pPassthrough->Init( m_pXrSession->GetXrSession(), m_pXrInstance.get(), pOtherInfo );
+		XR_RETURN_ON_ERROR( m_pPassthrough->Init( m_pXrSession->GetXrSession(), m_pXrInstance.get(), pOtherInfo ) );
+
+		// Geometry for mesh projection layers
+		if ( m_pTriangleMesh )
+			m_pPassthroughGeometry = std::make_unique< CPassthroughGeometry >( m_pXrInstance->GetXrInstance(), m_pXrSession->GetXrSession() );
+
+		return XR_SUCCESS;
 	}
 
 	XrResult XrApp::CreateMainRenderPass() 
@@ -209,27 +295,267 @@ namespace xrapp
 		if ( m_pVisMask == nullptr )
 			return;
 
-		// Retrieve left eye vismask and convert to a Plane2D
-		vecMasks.push_back( new CPlane2D( m_pXrSession.get(), pRenderInfo.get(), 0, 0 ) );
-		m_pVisMask->GetVisMaskShortIndices(
-			m_pXrSession->GetXrSession(),
-			*vecMasks.back()->GetVertices(),
-			*vecMasks.back()->GetIndices(),
-			XrViewConfigurationType::XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO,
-			k_Left,
-			XrVisibilityMaskTypeKHR::XR_VISIBILITY_MASK_TYPE_HIDDEN_TRIANGLE_MESH_KHR );
-		vecMasks.back()->InitBuffers();
-
-		// Retrieve right eye vismask and convert to a Plane2D
-		vecMasks.push_back( new CPlane2D( m_pXrSession.get(), pRenderInfo.get(), 0, 0 ) );
-		m_pVisMask->GetVisMaskShortIndices(
-			m_pXrSession->GetXrSession(),
-			*vecMasks.back()->GetVertices(),
-			*vecMasks.back()->GetIndices(),
-			XrViewConfigurationType::XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO,
-			k_Right,
-			XrVisibilityMaskTypeKHR::XR_VISIBILITY_MASK_TYPE_HIDDEN_TRIANGLE_MESH_KHR );
-		vecMasks.back()->InitBuffers();		
+		// (1) Load cached masks for this runtime and device, the runtime is only queried when they're missing.
+		//     If the runtime's masks change afterwards (e.g. ipd or fov), it sends a visibility mask changed event and ProcessEvents_Vismasks refreshes the cache.
+		std::string sError;
+		bool bCached = m_bVismaskCacheKeyValid = GetVismaskCacheKey( m_pXrInstance->GetXrInstance(), XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO, m_vismaskCacheKey );
+		if ( bCached && !m_vismaskCache.Load( GetVismaskCacheFilename(), m_vismaskCacheKey, sError ) )
+		{
+			XRAPP_LOG_DEBUG( m_pXrInstance->GetAppName(), "Vismasks will be retrieved from the runtime: %s", sError.c_str() );
+			bCached = false;
+		}
+
+		// (2) Create a Plane2D per eye from the cache or the runtime
+		bool bSaveCache = false;
+		m_vecVismaskBufferSizes.resize( 2 );
+		for ( auto eye : { k_Left, k_Right } )
+		{
+			const uint32_t unEye = static_cast< uint32_t >( eye );
+			vecMasks.push_back( new CPlane2D( m_pXrSession.get(), pRenderInfo.get(), 0, 0 ) );
+
+			if ( !bCached || !m_vismaskCache.GetEye( unEye, *vecMasks.back()->GetVertices(), *vecMasks.back()->GetIndices() ) )
+			{
+				m_pVisMask->GetVisMaskShortIndices(
+					m_pXrSession->GetXrSession(),
+					*vecMasks.back()->GetVertices(),
+					*vecMasks.back()->GetIndices(),
+					XrViewConfigurationType::XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO,
+					eye,
+					XrVisibilityMaskTypeKHR::XR_VISIBILITY_MASK_TYPE_HIDDEN_TRIANGLE_MESH_KHR );
+
+				m_vismaskCache.SetEye( unEye, *vecMasks.back()->GetVertices(), *vecMasks.back()->GetIndices() );
+				bSaveCache = true;
+			}
+
+			vecMasks.back()->InitBuffers();
+			m_vecVismaskBufferSizes[ unEye ] = { vecMasks.back()->GetVertices()->size(), vecMasks.back()->GetIndices()->size() };
+		}
+
+		if ( bSaveCache )
+			SaveVismaskCache();
+	}
+
+	bool XrApp::ApplyVismask( uint32_t unEye )
+	{
+		CPlane2D *pMask = vecMasks.at( unEye );
+		auto &vecVertices = *pMask->GetVertices();
+		auto &vecIndices = *pMask->GetIndices();
+
+		// Nothing was written (e.g. the event was for another view) or the runtime resent an unchanged mask (e.g. on recenter)
+		if ( m_vecVismaskIndices.empty() ||
+			 ( m_vecVismaskIndices == vecIndices && std::equal( m_vecVismaskVertices.begin(), m_vecVismaskVertices.end(), vecVertices.begin(), vecVertices.end(),
+				[]( const auto &a, const auto &b ) { return std::memcmp( &a, &b, sizeof( a ) ) == 0; } ) ) )
+			return false;
+
+		// Swap rather than copy, the previous mask's storage becomes the next query's scratch
+		std::swap( vecVertices, m_vecVismaskVertices );
+		std::swap( vecIndices, m_vecVismaskIndices );
+
+		SVismaskBufferSize &bufferSize = m_vecVismaskBufferSizes[ unEye ];
+		if ( vecVertices.size() <= bufferSize.unVertices && vecIndices.size() <= bufferSize.unIndices )
+		{
+			pMask->UpdateBuffers();
+		}
+		else
+		{
+			pMask->InitBuffers();
+			bufferSize = { vecVertices.size(), vecIndices.size() };
+		}
+
+		m_vismaskCache.SetEye( unEye, vecVertices, vecIndices );
+		return true;
+	}
+
+	std::string XrApp::GetVismaskCacheFilename()
+	{
+		char pszFilename[ 64 ];
+		std::snprintf( pszFilename, sizeof( pszFilename ), k_pccVismaskCacheFilename, static_cast< uint32_t >( m_vismaskCacheKey.viewConfigurationType ) );
+		return sCacheDirectory + pszFilename;
+	}
+
+	void XrApp::SaveVismaskCache()
+	{
+		if ( !m_bVismaskCacheKeyValid )
+			return;
+
+		std::string sError;
+		if ( !m_vismaskCache.Save( GetVismaskCacheFilename(), m_vismaskCacheKey, sError ) )
+			XRAPP_LOG_ERROR( m_pXrInstance->GetAppName(), "Unable to save vismask cache: %s", sError.c_str() );
+	}
+
+	void XrApp::RegisterDefaultEventHandlers()
+	{
+		RegisterEventHandler( XR_TYPE_EVENT_DATA_SESSION_STATE_CHANGED, [ this ]( XrEventDataBaseHeader &xrEvent ) { ProcessEvents_SessionState( xrEvent ); } );
+		RegisterEventHandler( XR_TYPE_EVENT_DATA_VISIBILITY_MASK_CHANGED_KHR, [ this ]( XrEventDataBaseHeader &xrEvent ) { ProcessEvents_Vismasks( xrEvent ); } );
+		RegisterEventHandler( XR_TYPE_EVENT_DATA_DISPLAY_REFRESH_RATE_CHANGED_FB, [ this ]( XrEventDataBaseHeader &xrEvent ) { ProcessEvents_DisplayRateChanged( xrEvent ); } );
+		RegisterEventHandler( XR_TYPE_EVENT_DATA_EVENTS_LOST, [ this ]( XrEventDataBaseHeader & ) { XRAPP_LOG_ERROR( m_pXrInstance->GetAppName(), "Runtime event queue overflowed, events were lost." ); } );
+	}
+
+	void XrApp::RegisterEventHandler( XrStructureType eventType, EventHandler fnHandler )
+	{
+		m_mapEventHandlers[ eventType ].push_back( std::move( fnHandler ) );
+	}
+
+	bool XrApp::PollXrEvents()
+	{
+		XRAPP_PROFILE_ZONE( "PollXrEvents" );
+
+		auto start = std::chrono::steady_clock::now();
+		m_eventStats = {};
+
+		bool bSucceeded = true;
+		while ( m_eventStats.unEventCount < unMaxEventsPerPoll )
+		{
+			// (1) Poll the next event - the header keeps its placeholder type if the queue is empty.
+			//     Lost events are real events (the runtime's queue overflowed) and go to their handlers like any other.
+			XrEventDataBaseHeader xrEventDataBaseheader { XR_TYPE_EVENT_DATA_BUFFER };
+			XrResult result = m_pXrSession->Poll( &xrEventDataBaseheader );
+
+			if ( !XR_SUCCEEDED( result ) )
+			{
+				bSucceeded = false;
+				break;
+			}
+
+			if ( result == XR_EVENT_UNAVAILABLE || xrEventDataBaseheader.type == XR_TYPE_EVENT_DATA_BUFFER )
+				break;
+
+			// (2) Handle it before polling the next one, session state is only current for the event just polled
+			m_eventStats.unEventCount++;
+			ProcessXrEvents( xrEventDataBaseheader );
+
+			if ( m_pXrSession->GetState() == XR_SESSION_STATE_EXITING )
+				break;
+		}
+
+		m_eventStats.dHandleMs = std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now() - start ).count();
+		return bSucceeded;
+	}
+
+	void XrApp::AdvanceFrameClock( XrTime displayTime, XrDuration displayPeriod )
+	{
+		// Replays step the clock by the recorded display times, so simulation and animations advance exactly as they did when recorded
+		SCapturedFrameClock capturedClock { displayTime, displayPeriod };
+		if ( inputCapture.Capture( ECaptureStream::FrameClock, &capturedClock, 1 ) )
+		{
+			displayTime = capturedClock.time;
+			displayPeriod = capturedClock.period;
+		}
+
+		// Without the refresh rate extension, the display period is the only source for the rate. Rounded to 0.1hz so jitter doesn't notify.
+		if ( !m_pDisplayRate && displayPeriod > 0 && displayPeriod != m_frameClock.period )
+			SetRefreshRate( std::round( 1e10f / static_cast< float >( displayPeriod ) ) * 0.1f );
+
+		m_frameClock.period = displayPeriod;
+
+		// Already at (or past) this frame
+		if ( displayTime <= m_frameClock.time )
+			return;
+
+		// First frame steps by one display period
+		const XrDuration delta = m_frameClock.time ? displayTime - m_frameClock.time : displayPeriod;
+		const float fDeltaSeconds = std::min( static_cast< float >( static_cast< double >( delta ) * 1e-9 ), fMaxFrameDelta );
+
+		m_frameClock.unFrameIndex++;
+		m_frameClock.time = displayTime;
+		m_frameClock.fDeltaSeconds = fDeltaSeconds;
+		m_frameClock.dSeconds += fDeltaSeconds;
+	}
+
+	void XrApp::ProcessXrEvents( XrEventDataBaseHeader &xrEventDataBaseheader )
+	{
+		auto it = m_mapEventHandlers.find( xrEventDataBaseheader.type );
+		if ( it == m_mapEventHandlers.end() )
+		{
+			m_eventStats.unUnhandledCount++;
+			return;
+		}
+
+		for ( auto &fnHandler : it->second )
+			fnHandler( xrEventDataBaseheader );
+	}
+
+	bool XrApp::StartRenderFrame()
+	{
+		// Apps overriding this set up pRenderInfo->state (e.g. for passthrough) then call it
+		if ( m_pXrSession->GetState() >= XR_SESSION_STATE_READY )
+		{
+			if ( !m_pRender->StartRenderFrame( pRenderInfo.get() ) )
+				return false;
+
+			if ( !bLateLatch )
+				LateLatch();
+
+			return true;
+		}
+
+		return false;
+	}
+
+	void XrApp::EndRenderFrame()
+	{
+		if ( bLateLatch )
+			LateLatch();
+
+		m_pRender->EndRenderFrame( mainRenderPass, pRenderInfo.get(), vecMasks );
+	}
+
+	void XrApp::AddLateLatchSpace( CRenderable *pRenderable, uint32_t unInstance, XrSpace space )
+	{
+		// Pose is written by the late latch from here on, the renderer shouldn't locate it again
+		pRenderable->instances[ unInstance ].space = XR_NULL_HANDLE;
+		m_vecLateLatchSpaces.push_back( { pRenderable, unInstance, space } );
+		m_vecLateLatchLocations.resize( m_vecLateLatchSpaces.size() );
+	}
+
+	void XrApp::AddLateLatch( std::function< void( XrTime ) > fnLateLatch )
+	{
+		m_vecLateLatches.push_back( std::move( fnLateLatch ) );
+	}
+
+	void XrApp::LateLatch()
+	{
+		if ( !pRenderInfo->state.frameState.shouldRender )
+			return;
+
+		XRAPP_PROFILE_ZONE( "LateLatch" );
+
+		XrTime predictedDisplayTime = pRenderInfo->state.frameState.predictedDisplayTime;
+		XrSpace appSpace = m_pXrSession->GetAppSpace();
+
+		// (1) Space bound instances - located by the runtime unless replaying, then recorded or replayed
+		const uint32_t unSpaceCount = static_cast< uint32_t >( m_vecLateLatchSpaces.size() );
+		if ( !inputCapture.BIsReplaying() || !inputCapture.Capture( ECaptureStream::SpacePoses, m_vecLateLatchLocations.data(), unSpaceCount ) )
+		{
+			for ( uint32_t i = 0; i < unSpaceCount; i++ )
+			{
+				XrSpaceLocation spaceLocation { XR_TYPE_SPACE_LOCATION };
+				if ( !XR_UNQUALIFIED_SUCCESS( xrLocateSpace( m_vecLateLatchSpaces[ i ].space, appSpace, predictedDisplayTime, &spaceLocation ) ) )
+					spaceLocation.locationFlags = 0;
+
+				m_vecLateLatchLocations[ i ] = { spaceLocation.locationFlags, spaceLocation.pose };
+			}
+
+			if ( inputCapture.BIsRecording() )
+				inputCapture.Capture( ECaptureStream::SpacePoses, m_vecLateLatchLocations.data(), unSpaceCount );
+		}
+
+		// Keep the last pose if tracking is lost
+		for ( uint32_t i = 0; i < unSpaceCount; i++ )
+		{
+			const SLateLatchSpace &latch = m_vecLateLatchSpaces[ i ];
+			const SCapturedSpaceLocation &location = m_vecLateLatchLocations[ i ];
+
+			if ( location.locationFlags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT )
+				latch.pRenderable->instances[ latch.unInstance ].pose.orientation = location.pose.orientation;
+
+			if ( location.locationFlags & XR_SPACE_LOCATION_POSITION_VALID_BIT )
+				latch.pRenderable->instances[ latch.unInstance ].pose.position = location.pose.position;
+		}
+
+		// (2) App latches
+		for ( auto &fnLateLatch : m_vecLateLatches )
+			fnLateLatch( predictedDisplayTime );
 	}
 
 	void XrApp::ProcessEvents_SessionState( XrEventDataBaseHeader &xrEventDataBaseheader ) 
@@ -243,7 +569,7 @@ namespace xrapp
 					return;
 
 				m_bInputActive = false;
-				LogInfo( m_pXrInstance->GetAppName(), "OpenXR session started." );
+				XRAPP_LOG_INFO( m_pXrInstance->GetAppName(), "OpenXR session started." );
 			}
 			else if ( m_pXrSession->GetState() == XR_SESSION_STATE_STOPPING )
 			{
@@ -252,12 +578,12 @@ namespace xrapp
 					return;
 
 				m_bInputActive = false;
-				LogInfo( m_pXrInstance->GetAppName(), "OpenXR session exiting." );
+				XRAPP_LOG_INFO( m_pXrInstance->GetAppName(), "OpenXR session exiting." );
 			}
 			else if ( m_pXrSession->GetState() == XR_SESSION_STATE_FOCUSED )
 			{
 				m_bInputActive = true;
-				LogInfo( m_pXrInstance->GetAppName(), "Input now active." );
+				XRAPP_LOG_INFO( m_pXrInstance->GetAppName(), "Input now active." );
 			}
 			else if ( m_pXrSession->GetState() < XR_SESSION_STATE_FOCUSED )
 			{
@@ -270,25 +596,27 @@ namespace xrapp
 	{ 
 		if ( xrEventDataBaseheader.type == XR_TYPE_EVENT_DATA_VISIBILITY_MASK_CHANGED_KHR && GetVisMask() && vecMasks.size() == 2 )
 		{
-			GetVisMask()->UpdateVisMaskShortIndices(
-				xrEventDataBaseheader,
-				GetSession()->GetXrSession(),
-				*vecMasks.at( 0 )->GetVertices(),
-				*vecMasks.at( 0 )->GetIndices(),
-				XrViewConfigurationType::XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO,
-				k_Left,
-				XrVisibilityMaskTypeKHR::XR_VISIBILITY_MASK_TYPE_HIDDEN_TRIANGLE_MESH_KHR );
-			vecMasks.at( 0 )->InitBuffers();
-
-			GetVisMask()->UpdateVisMaskShortIndices(
-				xrEventDataBaseheader,
-				GetSession()->GetXrSession(),
-				*vecMasks.at( 1 )->GetVertices(),
-				*vecMasks.at( 1 )->GetIndices(),
-				XrViewConfigurationType::XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO,
-				k_Right,
-				XrVisibilityMaskTypeKHR::XR_VISIBILITY_MASK_TYPE_HIDDEN_TRIANGLE_MESH_KHR );
-			vecMasks.at( 1 )->InitBuffers();
+			bool bChanged = false;
+			for ( auto eye : { k_Left, k_Right } )
+			{
+				// Update writes into the scratch vectors, which keep their capacity between events
+				m_vecVismaskVertices.clear();
+				m_vecVismaskIndices.clear();
+				GetVisMask()->UpdateVisMaskShortIndices(
+					xrEventDataBaseheader,
+					GetSession()->GetXrSession(),
+					m_vecVismaskVertices,
+					m_vecVismaskIndices,
+					XrViewConfigurationType::XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO,
+					eye,
+					XrVisibilityMaskTypeKHR::XR_VISIBILITY_MASK_TYPE_HIDDEN_TRIANGLE_MESH_KHR );
+
+				bChanged |= ApplyVismask( static_cast< uint32_t >( eye ) );
+			}
+
+			// Keep the cache current so the next launch starts with the latest masks
+			if ( bChanged )
+				SaveVismaskCache();
 
 			return true;
 		}
@@ -303,95 +631,115 @@ namespace xrapp
 
 		if ( xrEventDataBaseheader.type == XR_TYPE_EVENT_DATA_DISPLAY_REFRESH_RATE_CHANGED_FB )
 		{
-			LogInfo( m_pXrInstance->GetAppName(), "Refresh rate changed to: %f", m_pDisplayRate->GetCurrentRefreshRate( m_pXrSession->GetXrSession() ) );
+			// Event payloads aren't kept by the session poll, so query once per change
+			SetRefreshRate( m_pDisplayRate->GetCurrentRefreshRate( m_pXrSession->GetXrSession() ) );
 		}
+	}
+
+	void XrApp::AddRefreshRateCallback( RefreshRateCallback fnCallback )
+	{
+		m_vecRefreshRateCallbacks.push_back( std::move( fnCallback ) );
+	}
+
+	void XrApp::SetRefreshRate( float fRate )
+	{
+		if ( fRate <= 0.f || fRate == m_fRefreshRate )
+			return;
 
+		const float fFromRate = m_fRefreshRate;
+		m_fRefreshRate = fRate;
+
+		XRAPP_LOG_INFO( m_pXrInstance->GetAppName(), "Refresh rate changed to: %f", fRate );
+
+		for ( auto &fnCallback : m_vecRefreshRateCallbacks )
+			fnCallback( fFromRate, fRate );
 	}
 
 	void XrApp::ActionCallback_Debug( SAction *pAction, uint32_t unActionStateIndex ) 
 	{ 
-		if ( pAction->vecActionStates.empty() )
+		if constexpr ( XRAPP_MIN_LOG_LEVEL > XRAPP_LOG_LEVEL_DEBUG )
 		{
-			LogDebug( m_pXrInstance->GetAppName(), "Action %" PRIu64 " called succesfully. But action states were empty.", pAction->xrActionHandle );
+			// Debug logs are compiled out, skip the path lookup too
 			return;
 		}
-
-		std::string sSubpath;
-		if ( pAction->vecSubactionpaths.size() > unActionStateIndex )
-		{
-			uint32_t unCount = 0;
-			char sPath[ XR_MAX_PATH_LENGTH ];
-			XrResult xrResult = xrPathToString( m_pXrInstance->GetXrInstance(), pAction->vecSubactionpaths[ unActionStateIndex ], sizeof( sPath ), &unCount, sPath );
-			if ( XR_UNQUALIFIED_SUCCESS( xrResult ) )
-				sSubpath = sPath;
-		}
-			
-		switch ( pAction->xrActionType )
+		else
 		{
-			case XR_ACTION_TYPE_BOOLEAN_INPUT:
+			if ( pAction->vecActionStates.empty() )
 			{
-				XrActionStateBoolean &stateB = pAction->vecActionStates[ unActionStateIndex ].stateBoolean;
-				if ( stateB.isActive )
-				{
-					if ( stateB.changedSinceLastSync )
-						LogDebug( m_pXrInstance->GetAppName(), "Action %" PRIu64 " [%s] called succesfully. Current state is: %s", 
-							pAction->xrActionHandle, 
-							sSubpath.c_str(),
-							stateB.currentState ? "true" : "false" );
-				}
+				XRAPP_LOG_DEBUG( m_pXrInstance->GetAppName(), "Action %" PRIu64 " called succesfully. But action states were empty.", pAction->xrActionHandle );
 				return;
-				break;
 			}
 
-			case XR_ACTION_TYPE_FLOAT_INPUT:
+			// Interned, the runtime is only asked once per subaction path
+			const std::string &sSubpath = GetPathString( pAction->vecSubactionpaths.size() > unActionStateIndex ? pAction->vecSubactionpaths[ unActionStateIndex ] : XR_NULL_PATH );
+			
+			switch ( pAction->xrActionType )
 			{
-				XrActionStateFloat &stateF = pAction->vecActionStates[ unActionStateIndex ].stateFloat;
-				if ( stateF.isActive )
+				case XR_ACTION_TYPE_BOOLEAN_INPUT:
 				{
-					if ( stateF.changedSinceLastSync )
-						LogDebug( m_pXrInstance->GetAppName(), 
-							"Action %" PRIu64 " [%s] called succesfully. Current state is: %f", 
-							pAction->xrActionHandle, 
-							sSubpath.c_str(),
-							stateF.currentState );
+					XrActionStateBoolean &stateB = pAction->vecActionStates[ unActionStateIndex ].stateBoolean;
+					if ( stateB.isActive )
+					{
+						if ( stateB.changedSinceLastSync )
+							XRAPP_LOG_DEBUG( m_pXrInstance->GetAppName(), "Action %" PRIu64 " [%s] called succesfully. Current state is: %s", 
+								pAction->xrActionHandle, 
+								sSubpath.c_str(),
+								stateB.currentState ? "true" : "false" );
+					}
+					return;
+					break;
 				}
-				return;
-				break;
-			}
 
-			case XR_ACTION_TYPE_VECTOR2F_INPUT:
-			{
-				XrActionStateVector2f &stateV2 = pAction->vecActionStates[ unActionStateIndex ].stateVector2f;
-				if ( stateV2.isActive )
+				case XR_ACTION_TYPE_FLOAT_INPUT:
 				{
-					if ( stateV2.changedSinceLastSync )
-						LogDebug( m_pXrInstance->GetAppName(), "Action %" PRIu64 " [%s] called succesfully. Current state is: { %f, %f }", 
-							pAction->xrActionHandle, 
-							sSubpath.c_str(),
-							stateV2.currentState.x, 
-							stateV2.currentState.y );
+					XrActionStateFloat &stateF = pAction->vecActionStates[ unActionStateIndex ].stateFloat;
+					if ( stateF.isActive )
+					{
+						if ( stateF.changedSinceLastSync )
+							XRAPP_LOG_DEBUG( m_pXrInstance->GetAppName(), 
+								"Action %" PRIu64 " [%s] called succesfully. Current state is: %f", 
+								pAction->xrActionHandle, 
+								sSubpath.c_str(),
+								stateF.currentState );
+					}
+					return;
+					break;
 				}
-				return;
-				break;
-			}
 
-			case XR_ACTION_TYPE_POSE_INPUT:
-			{
-				XrActionStatePose &stateP = pAction->vecActionStates[ unActionStateIndex ].statePose;
-				if ( stateP.isActive )
-					LogDebug( m_pXrInstance->GetAppName(), "Pose Action %" PRIu64 " [%s] is active.", pAction->xrActionHandle, sSubpath.c_str() );
-				return;
-				break;
-			}
+				case XR_ACTION_TYPE_VECTOR2F_INPUT:
+				{
+					XrActionStateVector2f &stateV2 = pAction->vecActionStates[ unActionStateIndex ].stateVector2f;
+					if ( stateV2.isActive )
+					{
+						if ( stateV2.changedSinceLastSync )
+							XRAPP_LOG_DEBUG( m_pXrInstance->GetAppName(), "Action %" PRIu64 " [%s] called succesfully. Current state is: { %f, %f }", 
+								pAction->xrActionHandle, 
+								sSubpath.c_str(),
+								stateV2.currentState.x, 
+								stateV2.currentState.y );
+					}
+					return;
+					break;
+				}
 
-			case XR_ACTION_TYPE_VIBRATION_OUTPUT:
-				// This action type won't route to here - trigger with CInput::GenerateHaptic in you app code
-				return;
+				case XR_ACTION_TYPE_POSE_INPUT:
+				{
+					XrActionStatePose &stateP = pAction->vecActionStates[ unActionStateIndex ].statePose;
+					if ( stateP.isActive )
+						XRAPP_LOG_DEBUG( m_pXrInstance->GetAppName(), "Pose Action %" PRIu64 " [%s] is active.", pAction->xrActionHandle, sSubpath.c_str() );
+					return;
+					break;
+				}
 
-			case XR_ACTION_TYPE_MAX_ENUM:
-			default:
-				LogError( m_pXrInstance->GetAppName(), "Action %" PRIu64 " [%s] of unknown/unsupported type called.", pAction->xrActionHandle, sSubpath.c_str() );
-				break;
+				case XR_ACTION_TYPE_VIBRATION_OUTPUT:
+					// This action type won't route to here - request vibrations through the app's haptic scheduler (haptics)
+					return;
+
+				case XR_ACTION_TYPE_MAX_ENUM:
+				default:
+					XRAPP_LOG_ERROR( m_pXrInstance->GetAppName(), "Action %" PRIu64 " [%s] of unknown/unsupported type called.", pAction->xrActionHandle, sSubpath.c_str() );
+					break;
+			}
 		}
 
 	}
@@ -401,72 +749,312 @@ namespace xrapp
 		assert( pThreadPool && !meshes.empty() );
 
 		std::unique_ptr< CGltf > pGltf = std::make_unique< CGltf >( m_pXrSession.get() );
-		std::vector< std::future< void > > futures;
-		std::vector< std::unique_ptr< tinygltf::Model > > models;
+		std::vector< std::unique_ptr< tinygltf::Model > > vecModels;
 
-		futures.reserve( meshes.size() );
-		models.reserve( meshes.size() );
+		std::vector< const SMeshInfo * > vecMeshes;
+		for ( auto &mesh : meshes )
+			vecMeshes.push_back( &mesh );
+
+		// Load and parse meshes (use worker threads from thread pool manager).
+		// Each model is parsed as soon as its own load finishes and released right after,
+		// only the parse (which uploads to the gpu via the shared command pool) is serialized.
+		CTaskGraph graph( pThreadPool.get() );
+		AddMeshLoadTasks( graph, pGltf.get(), vecModels, vecMeshes );
 
-		// Load meshes from disk (use worker threads from thread pool manager)
 		auto start = std::chrono::high_resolution_clock::now();
-		LogInfo( m_pXrInstance->GetAppName(), "Parallel loading meshes started. Please wait..." );
+		XRAPP_LOG_INFO( m_pXrInstance->GetAppName(), "Parallel loading meshes started. Please wait..." );
 
-		for ( auto &mesh : meshes )
-		{
-			models.push_back( std::make_unique< tinygltf::Model > () );
-			tinygltf::Model *currentModel = models.back().get();
+		graph.RunAndWait();
 
-			auto future = pThreadPool->SubmitTask(
-				[ pGltf = pGltf.get(),
-				renderModel = mesh.pRenderModel,
-				model = currentModel,
-				filename = mesh.sFilename,
-				scale = mesh.scale ]()
-				{
-                    pGltf->LoadFromDisk( renderModel, model, filename, scale );
-				} );
+		auto end = std::chrono::high_resolution_clock::now();
+		std::chrono::duration< double > duration = end - start;
+		XRAPP_LOG_INFO( m_pXrInstance->GetAppName(), "All meshes loaded and parsed (%zu unique of %zu). Time elapsed: %.4f seconds", vecModels.size(), meshes.size(), duration.count() );
+	}
 
-			futures.push_back( std::move( future ) );
+	XrApp::SSharedMesh XrApp::AddSharedMesh( const std::string &sFilename, const XrVector3f &scale, uint32_t pipelineLayout, uint32_t pipeline )
+	{
+		auto key = std::make_tuple( sFilename, scale.x, scale.y, scale.z, pipelineLayout, pipeline );
+		auto it = m_mapSharedMeshes.find( key );
+		if ( it == m_mapSharedMeshes.end() )
+		{
+			CRenderModel *pRenderModel = new CRenderModel( m_pXrSession.get(), pRenderInfo.get(), pipelineLayout, pipeline );
+			m_mapSharedMeshes.emplace( std::move( key ), pRenderModel );
+			return { pRenderModel, 0, true };
 		}
 
-		// Synchronize mesh load before parsing model
-		for ( auto &future : futures )
+		CRenderModel *pRenderModel = it->second;
+		pRenderModel->AddInstance( 1, scale );
+		return { pRenderModel, static_cast< uint32_t >( pRenderModel->instances.size() - 1 ), false };
+	}
+
+	void XrApp::ParallelLoadAssets( const std::vector< SAssetInfo > assets )
+	{
+		assert( pThreadPool && !assets.empty() );
+
+		std::unique_ptr< CGltf > pGltf = std::make_unique< CGltf >( m_pXrSession.get() );
+		std::vector< std::unique_ptr< tinygltf::Model > > vecModels;
+
+		std::vector< const SMeshInfo * > vecMeshes;
+		for ( auto &asset : assets )
+			vecMeshes.push_back( &asset.mesh );
+
+		// (1) load -> parse per mesh
+		CTaskGraph graph( pThreadPool.get() );
+		std::vector< CTaskGraph::TaskId > vecParseTasks = AddMeshLoadTasks( graph, pGltf.get(), vecModels, vecMeshes );
+
+		// (2) parse -> material -> buffer init per asset, no waiting on the other assets
+		for ( size_t i = 0; i < assets.size(); i++ )
 		{
-			future.wait();
+			const SAssetInfo &asset = assets[ i ];
+			CTaskGraph::TaskId lastTask = vecParseTasks[ i ];
+
+			if ( asset.fnLoadMaterial )
+			{
+				// App callbacks usually record material ids, run them one at a time
+				lastTask = graph.AddTask( [ &asset ]() { asset.fnLoadMaterial( asset.mesh.pRenderModel ); }, { lastTask }, CTaskGraph::ETaskLane::Serial );
+			}
+			else if ( asset.bLoadMaterial )
+			{
+				lastTask = graph.AddTask(
+					[ &asset, pRenderInfo = pRenderInfo.get(), pTextureManager = pTextureManager.get() ]()
+					{
+						XRAPP_PROFILE_ZONE( "LoadMaterial" );
+						asset.mesh.pRenderModel->LoadMaterial( pRenderInfo, asset.descriptorLayout, asset.descriptorPool, pTextureManager );
+					},
+					{ lastTask } );
+			}
+
+			if ( asset.bInitBuffers )
+				graph.AddTask( [ &asset ]() { asset.mesh.pRenderModel->InitBuffers(); }, { lastTask }, CTaskGraph::ETaskLane::Serial );
 		}
 
+		auto start = std::chrono::high_resolution_clock::now();
+		XRAPP_LOG_INFO( m_pXrInstance->GetAppName(), "Parallel loading assets started. Please wait..." );
+
+		graph.RunAndWait();
+
 		auto end = std::chrono::high_resolution_clock::now();
 		std::chrono::duration< double > duration = end - start;
-		LogInfo( m_pXrInstance->GetAppName(), "All meshes loaded. Time elapsed: %.4f seconds", duration.count() );
+		XRAPP_LOG_INFO( m_pXrInstance->GetAppName(), "All assets loaded (%zu unique meshes of %zu). Time elapsed: %.4f seconds", vecModels.size(), assets.size(), duration.count() );
+	}
 
-		// Parse models 
-		start = std::chrono::high_resolution_clock::now();
-		LogInfo( m_pXrInstance->GetAppName(), "Parsing models. Please wait..." );
+	std::vector< CTaskGraph::TaskId > XrApp::AddMeshLoadTasks( 
+		CTaskGraph &graph, 
+		CGltf *pGltf, 
+		std::vector< std::unique_ptr< tinygltf::Model > > &vecModels, 
+		const std::vector< const SMeshInfo * > &vecMeshes )
+	{
+		assert( vecModels.empty() );
 
-		for ( size_t i = 0; i < meshes.size(); i++ )
+		// Mesh cache - requests for the same file and scale share one decoded model
+		std::map< std::tuple< std::string, float, float, float >, size_t > mapMeshCache;
+
+		std::vector< CTaskGraph::TaskId > vecLoadTasks;
+		std::vector< std::vector< CTaskGraph::TaskId > > vecModelParseTasks;
+		std::vector< CTaskGraph::TaskId > vecParseTasks;
+
+		for ( const SMeshInfo *pMesh : vecMeshes )
 		{
-			pGltf->ParseModel( meshes[ i ].pRenderModel, models[ i ].get(), m_pRender->GetCommandPool() );
+			auto cacheKey = std::make_tuple( pMesh->sFilename, pMesh->scale.x, pMesh->scale.y, pMesh->scale.z );
+			auto cachedMesh = mapMeshCache.find( cacheKey );
+			bool bCacheHit = cachedMesh != mapMeshCache.end();
+
+			size_t unModel = bCacheHit ? cachedMesh->second : vecModels.size();
+			if ( !bCacheHit )
+			{
+				mapMeshCache.emplace( std::move( cacheKey ), unModel );
+				vecModels.push_back( std::make_unique< tinygltf::Model >() );
+				vecModelParseTasks.emplace_back();
+
+				vecLoadTasks.push_back( graph.AddTask(
+					[ this, pGltf, pMesh, pModel = vecModels.back().get() ]()
+					{
+						XRAPP_PROFILE_ZONE( "LoadMesh" );
+
+						// Prefer a baked mesh (tools/meshbake) if one was shipped next to the source
+						if ( !LoadBakedMesh( pMesh->pRenderModel, pModel, pMesh->sFilename, pMesh->scale ) )
+							pGltf->LoadFromDisk( pMesh->pRenderModel, pModel, pMesh->sFilename, pMesh->scale );
+					} ) );
+			}
+
+			CTaskGraph::TaskId parseTask = graph.AddTask(
+				[ this, pGltf, pMesh, pModel = vecModels[ unModel ].get(), bCacheHit ]()
+				{
+					XRAPP_PROFILE_ZONE( "ParseModel" );
+
+					// Cache hits skipped the disk load, apply the model scale it would have
+					if ( bCacheHit )
+					{
+						for ( auto &instance : pMesh->pRenderModel->instances )
+							instance.scale = pMesh->scale;
+					}
+
+					pGltf->ParseModel( pMesh->pRenderModel, pModel, m_pRender->GetCommandPool() );
+				},
+				{ vecLoadTasks[ unModel ] },
+				CTaskGraph::ETaskLane::Serial );
+
+			vecModelParseTasks[ unModel ].push_back( parseTask );
+			vecParseTasks.push_back( parseTask );
 		}
 
-		end = std::chrono::high_resolution_clock::now();
-		duration = end - start;
-		LogInfo( m_pXrInstance->GetAppName(), "All models parsed. Time elapsed: %.4f seconds", duration.count() );
+		// Release each decoded model on a worker as soon as every mesh using it is parsed
+		for ( size_t i = 0; i < vecModelParseTasks.size(); i++ )
+			graph.AddTask( [ &vecModels, i ]() { vecModels[ i ].reset(); }, vecModelParseTasks[ i ] );
+
+		return vecParseTasks;
+	}
 
+	bool XrApp::LoadBakedMesh( CRenderModel *pRenderModel, tinygltf::Model *pModel, const std::string &sFilename, const XrVector3f &scale )
+	{
 		#ifdef XR_USE_PLATFORM_ANDROID
-		// For android, force garbage collection via thread pool as it takes quite a bit of time in this platform
-		std::vector< std::future< void > > cleanupFutures;
+			CMappedFile bakedFile( m_pXrInstance->GetAndroidApp()->activity->assetManager, sFilename + k_pccBakedMeshExtension );
+		#else
+			CMappedFile bakedFile( sFilename + k_pccBakedMeshExtension );
+		#endif
 
-		for ( auto &model : models )
+		if ( !bakedFile.BIsValid() )
+			return false;
+
+		std::string sError;
+		if ( !xrapp::LoadBakedMesh( pModel, bakedFile, sError ) )
 		{
-			auto cleanupFuture = pThreadPool->SubmitTask(
-				[ model = std::move( model ) ]() mutable
+			XRAPP_LOG_ERROR( m_pXrInstance->GetAppName(), "Unable to load baked mesh for %s, falling back to gltf: %s", sFilename.c_str(), sError.c_str() );
+			*pModel = tinygltf::Model();
+			return false;
+		}
+
+		// Same model scale LoadFromDisk applies
+		for ( auto &instance : pRenderModel->instances )
+			instance.scale = scale;
+
+		XRAPP_LOG_DEBUG( m_pXrInstance->GetAppName(), "Loaded baked mesh: %s%s", sFilename.c_str(), k_pccBakedMeshExtension );
+		return true;
+	}
+
+	std::shared_future< void > XrApp::LoadMeshesAsync( std::vector< SAsyncMeshInfo > meshes )
+	{
+		assert( pThreadPool && !meshes.empty() );
+
+		auto pLoad = std::make_shared< SAsyncMeshLoad >();
+		pLoad->vecMeshes = std::move( meshes );
+		pLoad->pGltf = std::make_unique< CGltf >( m_pXrSession.get() );
+		pLoad->unInsertIndex = pRenderInfo->vecRenderables.size();
+		pLoad->start = std::chrono::high_resolution_clock::now();
+
+		std::shared_future< void > futureReady = pLoad->promiseReady.get_future().share();
+
+		// Same mesh cache as ParallelLoadMeshes, one load per unique file and scale
+		std::map< std::tuple< std::string, float, float, float >, size_t > mapMeshCache;
+
+		for ( auto &asyncMesh : pLoad->vecMeshes )
+		{
+			const SMeshInfo &mesh = asyncMesh.mesh;
+			auto cacheKey = std::make_tuple( mesh.sFilename, mesh.scale.x, mesh.scale.y, mesh.scale.z );
+			auto cachedMesh = mapMeshCache.find( cacheKey );
+
+			if ( cachedMesh != mapMeshCache.end() )
+			{
+				pLoad->vecModelIndices.push_back( cachedMesh->second );
+				pLoad->vecIsCacheHit.push_back( true );
+				pLoad->vecModelUses[ cachedMesh->second ]++;
+				continue;
+			}
+
+			mapMeshCache.emplace( std::move( cacheKey ), pLoad->vecModels.size() );
+			pLoad->vecModelIndices.push_back( pLoad->vecModels.size() );
+			pLoad->vecIsCacheHit.push_back( false );
+			pLoad->vecModelUses.push_back( 1 );
+			pLoad->vecModels.push_back( std::make_unique< tinygltf::Model >() );
+
+			// The load outlives this call, it's waited on before the async load (or this app) is destroyed
+			auto future = pThreadPool->SubmitTask(
+				[ this,
+				pGltf = pLoad->pGltf.get(),
+				model = pLoad->vecModels.back().get(),
+				mesh ]()
 				{
-					// Explicitly reset the unique_ptr to release resources
-					model.reset();
+					XRAPP_PROFILE_ZONE( "LoadMesh" );
+
+					if ( !LoadBakedMesh( mesh.pRenderModel, model, mesh.sFilename, mesh.scale ) )
+						pGltf->LoadFromDisk( mesh.pRenderModel, model, mesh.sFilename, mesh.scale );
 				} );
-			cleanupFutures.push_back( std::move( cleanupFuture ) );
+
+			pLoad->vecLoadFutures.push_back( std::move( future ) );
+		}
+
+		XRAPP_LOG_INFO( m_pXrInstance->GetAppName(), "Async loading %zu meshes (%zu unique) started.", pLoad->vecMeshes.size(), pLoad->vecModels.size() );
+
+		m_vecAsyncMeshLoads.push_back( std::move( pLoad ) );
+		return futureReady;
+	}
+
+	void XrApp::UpdateAsyncLoads()
+	{
+		if ( m_vecAsyncMeshLoads.empty() )
+			return;
+
+		XRAPP_PROFILE_ZONE( "UpdateAsyncLoads" );
+		uint32_t unUploads = 0;
+
+		for ( auto it = m_vecAsyncMeshLoads.begin(); it != m_vecAsyncMeshLoads.end(); )
+		{
+			SAsyncMeshLoad &load = **it;
+
+			// Meshes join in request order so the draw (depth) order the app asked for is kept
+			while ( load.unNextMesh < load.vecMeshes.size() && unUploads < unAsyncUploadsPerFrame )
+			{
+				size_t unModel = load.vecModelIndices[ load.unNextMesh ];
+				if ( load.vecLoadFutures[ unModel ].wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready )
+					break;
+
+				SAsyncMeshInfo &asyncMesh = load.vecMeshes[ load.unNextMesh ];
+				CRenderModel *pRenderModel = asyncMesh.mesh.pRenderModel;
+
+				// Cache hits skipped the disk load, apply the model scale it would have
+				if ( load.vecIsCacheHit[ load.unNextMesh ] )
+				{
+					for ( auto &instance : pRenderModel->instances )
+						instance.scale = asyncMesh.mesh.scale;
+				}
+
+				load.pGltf->ParseModel( pRenderModel, load.vecModels[ unModel ].get(), m_pRender->GetCommandPool() );
+
+				// Release the decoded model on a worker as soon as the last mesh using it is parsed
+				if ( --load.vecModelUses[ unModel ] == 0 )
+				{
+					pThreadPool->SubmitTask(
+						[ model = std::move( load.vecModels[ unModel ] ) ]() mutable
+						{
+							model.reset();
+						} );
+				}
+
+				if ( asyncMesh.fnOnParsed )
+					asyncMesh.fnOnParsed( pRenderModel );
+
+				pRenderModel->InitBuffers();
+
+				auto &vecRenderables = pRenderInfo->vecRenderables;
+				size_t unIndex = std::min( load.unInsertIndex + load.unNextMesh, vecRenderables.size() );
+				vecRenderables.insert( vecRenderables.begin() + unIndex, dynamic_cast< CRenderable * >( pRenderModel ) );
+
+				load.unNextMesh++;
+				unUploads++;
+			}
+
+			if ( load.unNextMesh < load.vecMeshes.size() )
+			{
+				++it;
+				continue;
+			}
+
+			std::chrono::duration< double > duration = std::chrono::high_resolution_clock::now() - load.start;
+			XRAPP_LOG_INFO( m_pXrInstance->GetAppName(), "Async loaded %zu meshes. Time elapsed: %.4f seconds", load.vecMeshes.size(), duration.count() );
+
+			load.promiseReady.set_value();
+			it = m_vecAsyncMeshLoads.erase( it );
 		}
-		#endif
 	}
 
 	void XrApp::ParallelLoadMaterials( const std::vector< SLoadMaterialInfo > materialInfos )
@@ -477,13 +1065,15 @@ namespace xrapp
 		futures.reserve( materialInfos.size() );
 
 		auto start = std::chrono::high_resolution_clock::now();
-		LogInfo( m_pXrInstance->GetAppName(), "Parallel loading materials started. Please wait..." );
+		XRAPP_LOG_INFO( m_pXrInstance->GetAppName(), "Parallel loading materials started. Please wait..." );
 
 		for ( auto &materialInfo : materialInfos )
 		{
 			auto future = pThreadPool->SubmitTask(
 				[ &materialInfo, pRenderInfo = pRenderInfo.get(), pTextureManager = pTextureManager.get() ]()
 				{
+					XRAPP_PROFILE_ZONE( "LoadMaterial" );
+
 					if ( materialInfo.pRenderModel )
 						materialInfo.pRenderModel->LoadMaterial( pRenderInfo, materialInfo.descriptorLayout, materialInfo.descriptorPool, pTextureManager );
 				} );
@@ -495,7 +1085,7 @@ namespace xrapp
 
 		auto end = std::chrono::high_resolution_clock::now();
 		std::chrono::duration< double > duration = end - start;
-		LogInfo( m_pXrInstance->GetAppName(), "All materials loaded. Time elapsed: %.4f seconds", duration.count() );
+		XRAPP_LOG_INFO( m_pXrInstance->GetAppName(), "All materials loaded. Time elapsed: %.4f seconds", duration.count() );
 	}
 
 } // namespace xrapp
@@ -11,8 +11,17 @@
 */
 
 
+#pragma once
+
+#include <functional>
+#include <future>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
 
 #include <xrlib.hpp>
 #include <xrlib/ext/system_properties.hpp>			// Provides system property/hardware inspection capabilities
@@ -23,11 +32,27 @@
 #include <xrlib/ext/FB/display_refresh_rate.hpp>	// Handle display refresh rate, useful for consistent anims across devices
 
 // Helper classes
+#include <log.hpp>							 // Async logging, calls below XRAPP_MIN_LOG_LEVEL compile to nothing
 #include <xrlib/thread_pool.hpp>			 // Provides thread pool management. Will need to run on a system with MIN_THREAD_CAP threads
 #include <xrvk/render.hpp>					 // Built-in vulkan renderer. Ensure xrlib build includes xrvk when using this.
+#include <task_graph.hpp>					 // Dependency-aware tasks on top of the thread pool (asset loading, per frame work)
+#include <joint_buffer.hpp>					 // Structure of arrays joint storage with simd validate/transform kernels
+#include <vismask_cache.hpp>				 // On-disk cache of the runtime's hidden area meshes
+#include <material_store.hpp>				 // Dirty tracked material ubo updates, flushed once per frame
+#include <tween.hpp>						 // Tweens for floats, poses and material values driven by the predicted display time
+#include <path_cache.hpp>					 // Interned XrPath <-> string conversions
+#include <input_capture.hpp>				 // Input and frame timing record/replay for reproducible runs
+#include <action_dispatch.hpp>				 // Action sync with change-only callbacks from a flat function pointer table
+#include <haptics.hpp>						 // Vibration requests merged per device and applied at most once per frame
+#include <passthrough_geometry.hpp>			 // Passthrough geometry with shared shape meshes and change-only transform updates
 
 using namespace xrlib;
 
+namespace tinygltf
+{
+	class Model;
+}
+
 namespace xrapp
 {
 	class XrApp
@@ -41,6 +66,16 @@ namespace xrapp
 			XrVector3f scale = { 1.0f, 1.0f, 1.0f };
 		};
 
+		// A request's instance of a shared render model, see AddSharedMesh
+		struct SSharedMesh
+		{
+			CRenderModel *pRenderModel = nullptr;
+			uint32_t unInstance = 0;
+			bool bNew = false;	// this request created the model, it's the only one that loads it
+
+			auto &GetInstance() const { return pRenderModel->instances[ unInstance ]; }
+		};
+
 		struct SLoadMaterialInfo
 		{
 			CRenderModel *pRenderModel = nullptr;
@@ -48,6 +83,47 @@ namespace xrapp
 			uint32_t descriptorPool = 0;
 		};
 
+		struct SAssetInfo
+		{
+			SMeshInfo mesh;
+
+			// Material, loaded as soon as the mesh is parsed. fnLoadMaterial replaces the default LoadMaterial call and runs serially.
+			bool bLoadMaterial = false;
+			uint32_t descriptorLayout = 0;
+			uint32_t descriptorPool = 0;
+			std::function< void( CRenderModel * ) > fnLoadMaterial = nullptr;
+
+			bool bInitBuffers = true;
+		};
+
+		// Event handling for the last PollXrEvents call
+		struct SEventStats
+		{
+			uint32_t unEventCount = 0;		// events drained from the queue
+			uint32_t unUnhandledCount = 0;	// events with no registered handler
+			double dHandleMs = 0.0;			// polling and handlers
+		};
+
+		using EventHandler = std::function< void( XrEventDataBaseHeader & ) >;
+
+		// Frame timing from the runtime's predicted display times - the one clock for animations and input scaling
+		struct SFrameClock
+		{
+			uint64_t unFrameIndex = 0;	// frames the clock has advanced
+			XrTime time = 0;			// predicted display time of the frame being simulated
+			XrDuration period = 0;		// predicted display period
+			float fDeltaSeconds = 0.f;	// display time since the previous frame, at most fMaxFrameDelta
+			double dSeconds = 0.0;		// sum of deltas, doesn't jump after hitches or while the session is hidden
+		};
+
+		struct SAsyncMeshInfo
+		{
+			SMeshInfo mesh;
+
+			// Main thread, between frames - after the mesh is parsed and before its buffers are initialized (e.g. load materials here)
+			std::function< void( CRenderModel * ) > fnOnParsed = nullptr;
+		};
+
 		#ifdef XR_USE_PLATFORM_ANDROID
 
 			XrApp(
@@ -64,7 +140,7 @@ namespace xrapp
 				const ELogLevel eMinLogLevel );
 		#endif
 
-			~XrApp();
+			virtual ~XrApp();
 
 		XrResult InitInstance( 
 			std::vector< const char * > &vecExtensions, 
@@ -97,8 +173,34 @@ namespace xrapp
 		VkResult CreatePipeline_Primitives( const uint32_t layoutIndex, const uint32_t pipelineIndex, const std::string &sVertexShader, const std::string &sFragmentShader );
 		VkResult CreatePipeline( const uint32_t layoutIndex, const uint32_t pipelineIndex, std::vector< VkDescriptorSetLayout > &vecLayouts, SShaderSet *pShaderSet_WillBeDestroyed );
 
+		// Interned path conversions, the runtime is only asked on a miss. Common input paths are warmed on a worker by InitInstance.
+		XrPath GetPath( std::string_view sPath ) { return pPathCache ? pPathCache->GetPath( sPath ) : XR_NULL_PATH; }
+		const std::string &GetPathString( XrPath path ) { static const std::string sEmpty; return pPathCache ? pPathCache->GetString( path ) : sEmpty; }
+
 		void CreateVismasks();
 
+		// Drains all pending xr events, each one goes through ProcessXrEvents. Returns false if polling failed.
+		bool PollXrEvents();
+
+		// Handlers run in registration order for each event of their type. Session state, vismask and refresh rate handlers are registered by default.
+		void RegisterEventHandler( XrStructureType eventType, EventHandler fnHandler );
+		const SEventStats &GetEventStats() { return m_eventStats; }
+
+		// Cap on events handled per PollXrEvents call, the rest are picked up next frame
+		uint32_t unMaxEventsPerPoll = 64;
+
+		// Moves the frame clock to a frame's predicted display time, once per frame. CFrameScheduler does this right after the frame starts.
+		void AdvanceFrameClock( XrTime displayTime, XrDuration displayPeriod );
+		const SFrameClock &GetFrameClock() const { return m_frameClock; }
+
+		// Longest delta the frame clock reports, in seconds
+		float fMaxFrameDelta = 0.1f;
+
+		// Frame stages, driven by the demo loops or CFrameScheduler. Apps override these to customize a frame and call the XrApp version from the override, late latching runs there.
+		virtual void ProcessXrEvents( XrEventDataBaseHeader &xrEventDataBaseheader );
+		virtual bool StartRenderFrame();
+		virtual void EndRenderFrame();
+
 		void ProcessEvents_SessionState( XrEventDataBaseHeader &xrEventDataBaseheader );
 		bool ProcessEvents_Vismasks( XrEventDataBaseHeader &xrEventDataBaseheader );
 		void ProcessEvents_DisplayRateChanged( XrEventDataBaseHeader &xrEventDataBaseheader );
@@ -106,8 +208,39 @@ namespace xrapp
 		void ActionCallback_Debug( SAction *pAction, uint32_t unActionStateIndex );
 
 		void ParallelLoadMeshes( const std::vector< SMeshInfo > meshes );
+		bool LoadBakedMesh( CRenderModel *pRenderModel, tinygltf::Model *pModel, const std::string &sFilename, const XrVector3f &scale );
 		void ParallelLoadMaterials( const std::vector< SLoadMaterialInfo > materialInfos );
 
+		// One render model per unique file, scale, pipeline layout and pipeline for the lifetime of the app. Repeated requests get another
+		// instance of it, so duplicates share its vertex/index buffers and material. Only load (and add to render info) the request with bNew set,
+		// and add every instance before that load initializes the model's buffers.
+		SSharedMesh AddSharedMesh( const std::string &sFilename, const XrVector3f &scale, uint32_t pipelineLayout, uint32_t pipeline );
+
+		// Loads meshes, materials and buffers as one task graph, each asset goes load -> parse -> material -> buffers on its own
+		void ParallelLoadAssets( const std::vector< SAssetInfo > assets );
+
+		// Async scene loading - returns immediately, meshes load on worker threads and join vecRenderables
+		// (in request order, at the position they were requested at) once ready. The future is ready when all of them have joined.
+		std::shared_future< void > LoadMeshesAsync( std::vector< SAsyncMeshInfo > meshes );
+
+		// Gpu upload of async loaded meshes, must be called between frames while the render thread is idle (CFrameScheduler does this)
+		void UpdateAsyncLoads();
+		bool BIsLoadingAsync() { return !m_vecAsyncMeshLoads.empty(); }
+
+		// Meshes uploaded per UpdateAsyncLoads call, keeps the frames around a load responsive
+		uint32_t unAsyncUploadsPerFrame = 1;
+
+		// Late latching - on the render thread, just before EndRenderFrame records and submits a frame, registered poses are re-located
+		// at that frame's predicted display time and written to the instance data EndRenderFrame uploads. Register before the frame loop starts.
+		// When off, the same poses are located right after StartRenderFrame instead (useful for comparing latency).
+		bool bLateLatch = true;
+
+		// Instance follows the space (located against the app space), use in place of binding instances[ unInstance ].space
+		void AddLateLatchSpace( CRenderable *pRenderable, uint32_t unInstance, XrSpace space );
+
+		// Custom late latch (e.g. hand joints) called with the predicted display time - runs on the render thread, only touch render state here
+		void AddLateLatch( std::function< void( XrTime ) > fnLateLatch );
+
 		CInstance *GetInstance() { return m_pXrInstance.get(); }
 		CSession *GetSession() { return m_pXrSession.get(); }
 		CStereoRender *GetRender() { return m_pRender.get(); }
@@ -118,8 +251,17 @@ namespace xrapp
 		EXT::CHandTracking *GetHandTracking() { return m_pHandTracking.get(); }
 		FB::CPassthrough *GetPassthrough() { return m_pPassthrough.get(); }
 		FB::CTriangleMesh *GetTriangleMesh() { return m_pTriangleMesh.get(); }
+		CPassthroughGeometry *GetPassthroughGeometry() { return m_pPassthroughGeometry.get(); }
 		FB::CDisplayRefreshRate *GetDisplayRate() { return m_pDisplayRate.get(); }
 
+		// Current display refresh rate in hz, cached - no runtime call. Updated from refresh rate changed events,
+		// or from the predicted display period when the runtime doesn't support XR_FB_display_refresh_rate. 0 until known.
+		float GetRefreshRate() const { return m_fRefreshRate; }
+
+		// Called on the main thread with the previous and new rate whenever the refresh rate changes (e.g. to adjust animations or frame pacing)
+		using RefreshRateCallback = std::function< void( float fFromRate, float fToRate ) >;
+		void AddRefreshRateCallback( RefreshRateCallback fnCallback );
+
 		std::vector< CPlane2D * > vecMasks;
 
 		struct DefaultShaders
@@ -144,14 +286,93 @@ namespace xrapp
 
 		VkRenderPass mainRenderPass = VK_NULL_HANDLE;
 
+		// Where runtime/device specific caches (e.g. vismasks) are saved - app internal storage on android, working directory otherwise
+		std::string sCacheDirectory;
+
 		// Render helpers
 		std::unique_ptr< CRenderInfo > pRenderInfo = nullptr;
 		std::unique_ptr< CThreadPool > pThreadPool = nullptr;
 		std::unique_ptr< CTextureManager > pTextureManager = nullptr;
+		std::unique_ptr< CPathCache > pPathCache = nullptr;
+
+		// Materials with values that change at runtime, flushed by CFrameScheduler after publish
+		CMaterialStore materialStore;
+
+		// Running tweens, updated by CFrameScheduler at the simulation time right before the app's simulate
+		CTweenSystem tweens { &materialStore };
+
+		// Records or replays action states, late latched poses, frame timings and anything the app captures (e.g. hand joints).
+		// On desktop, started with --record-input <file> or --replay-input <file>.
+		CInputCapture inputCapture;
+
+		// Action sync and change-only callbacks, apps call actionDispatcher.Sync() from their input task in place of CInput::ProcessInput
+		CActionDispatcher actionDispatcher { &inputCapture };
+
+		// Vibration requests from the input task, submitted by CFrameScheduler right after it
+		CHapticScheduler haptics;
 
 	  protected:
 		bool m_bInputActive = false;
 
+		std::future< void > m_futurePathCacheWarm;
+
+		std::string GetVismaskCacheFilename();
+		void SaveVismaskCache();
+		CVismaskCache m_vismaskCache;
+		SVismaskCacheKey m_vismaskCacheKey;
+		bool m_bVismaskCacheKeyValid = false;
+
+		// Moves the mask in the scratch vectors to an eye if it differs from the current one. The eye's gpu buffers are
+		// updated in place while the new mask fits in them, and only reallocated when it grows.
+		bool ApplyVismask( uint32_t unEye );
+
+		struct SVismaskBufferSize
+		{
+			size_t unVertices = 0;
+			size_t unIndices = 0;
+		};
+
+		using VismaskVertices = std::remove_pointer_t< decltype( std::declval< CPlane2D & >().GetVertices() ) >;
+		using VismaskIndices = std::remove_pointer_t< decltype( std::declval< CPlane2D & >().GetIndices() ) >;
+		VismaskVertices m_vecVismaskVertices;	// scratch for runtime queries, keeps its capacity across events
+		VismaskIndices m_vecVismaskIndices;
+		std::vector< SVismaskBufferSize > m_vecVismaskBufferSizes;
+
+		void RegisterDefaultEventHandlers();
+		std::unordered_map< XrStructureType, std::vector< EventHandler > > m_mapEventHandlers;
+		SEventStats m_eventStats;
+
+		SFrameClock m_frameClock;
+
+		void SetRefreshRate( float fRate );
+		float m_fRefreshRate = 0.f;
+		std::vector< RefreshRateCallback > m_vecRefreshRateCallbacks;
+
+		// Adds a load -> parse chain per mesh to the graph (one load per unique file and scale), returns each mesh's parse task
+		std::vector< CTaskGraph::TaskId > AddMeshLoadTasks(
+			CTaskGraph &graph,
+			CGltf *pGltf,
+			std::vector< std::unique_ptr< tinygltf::Model > > &vecModels,
+			const std::vector< const SMeshInfo * > &vecMeshes );
+
+		struct SAsyncMeshLoad;
+		std::vector< std::shared_ptr< SAsyncMeshLoad > > m_vecAsyncMeshLoads;
+
+		// Shared render models by file, scale, pipeline layout and pipeline. Owned by render info like any other renderable.
+		std::map< std::tuple< std::string, float, float, float, uint32_t, uint32_t >, CRenderModel * > m_mapSharedMeshes;
+
+		struct SLateLatchSpace
+		{
+			CRenderable *pRenderable = nullptr;
+			uint32_t unInstance = 0;
+			XrSpace space = XR_NULL_HANDLE;
+		};
+
+		void LateLatch();
+		std::vector< SLateLatchSpace > m_vecLateLatchSpaces;
+		std::vector< SCapturedSpaceLocation > m_vecLateLatchLocations;	// per late latch space
+		std::vector< std::function< void( XrTime ) > > m_vecLateLatches;
+
 		std::unique_ptr< CInstance > m_pXrInstance = nullptr;
 		std::unique_ptr< CSession > m_pXrSession = nullptr;
 		std::unique_ptr< CStereoRender > m_pRender = nullptr;
@@ -162,6 +383,9 @@ namespace xrapp
 		std::unique_ptr< FB::CTriangleMesh > m_pTriangleMesh = nullptr;
 		std::unique_ptr< FB::CDisplayRefreshRate > m_pDisplayRate = nullptr;
 
+		// Destroyed before the passthrough layers its instances are on
+		std::unique_ptr< CPassthroughGeometry > m_pPassthroughGeometry = nullptr;
+
 	};
 
 } // namespace xrapp
\ No newline at end of file